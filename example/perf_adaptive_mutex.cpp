@@ -0,0 +1,61 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures the time per lock/unlock pair of boost::mutex and boost::adaptive_mutex for threads
+// contending on short critical sections.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/adaptive_mutex.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const int cycles = 100000;
+
+  boost::mutex mtx;
+  boost::adaptive_mutex amtx;
+  volatile unsigned counter = 0;
+
+  // A critical section of roughly a hundred nanoseconds.
+  template <class Mutex, Mutex& m>
+  void work()
+  {
+    for (int cycle = 0; cycle < cycles; ++cycle)
+    {
+      boost::lock_guard<Mutex> lk(m);
+      for (int i = 0; i < 20; ++i) counter = counter + 1;
+    }
+  }
+
+  template <class Mutex, Mutex& m>
+  void contend(int n, const char* name)
+  {
+    const clock::time_point t0 = clock::now();
+    boost::thread_group threads;
+    for (int t = 0; t < n; ++t)
+    {
+      threads.create_thread(work<Mutex, m>);
+    }
+    threads.join_all();
+    std::cout << name << ", " << n << " threads, time spent/cycle: "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(clock::now() - t0) / (cycles * n) << std::endl;
+  }
+}
+
+int main()
+{
+  for (int n = 1; n <= 16; n *= 2)
+  {
+    contend<boost::mutex, mtx>(n, "mutex");
+    contend<boost::adaptive_mutex, amtx>(n, "adaptive_mutex");
+  }
+  return 0;
+}
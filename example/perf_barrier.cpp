@@ -0,0 +1,58 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures the round-trip time of boost::barrier and boost::tree_barrier: the time for all the
+// threads to arrive at the barrier and to be released, for a growing number of threads.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const int rounds = 2000;
+
+  template <class Barrier>
+  void cycle(Barrier* b)
+  {
+    for (int i = 0; i < rounds; ++i)
+    {
+      b->wait();
+    }
+  }
+
+  template <class Barrier>
+  void round_trip(Barrier& b, unsigned int n, const char* name)
+  {
+    const clock::time_point t0 = clock::now();
+    boost::thread_group threads;
+    for (unsigned int t = 0; t < n; ++t)
+    {
+      threads.create_thread(boost::bind(cycle<Barrier>, &b));
+    }
+    threads.join_all();
+    std::cout << name << ", " << n << " threads, time spent/round: "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(clock::now() - t0) / rounds << std::endl;
+  }
+}
+
+int main()
+{
+  for (unsigned int n = 2; n <= 256; n *= 2)
+  {
+    boost::barrier b(n);
+    round_trip(b, n, "barrier");
+    boost::tree_barrier tb4(n, 4);
+    round_trip(tb4, n, "tree_barrier, fan-in 4");
+    boost::tree_barrier tb8(n, 8);
+    round_trip(tb8, n, "tree_barrier, fan-in 8");
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Initializes 256 independent once_flags from 8 to 64 threads, each thread visiting the flags in its
+// own order, as lazily initialized singletons hit at startup. Then measures call_once on the
+// initialized flags.
+//
+// The threads waiting for a flag block on the flag itself, so that the initializations of unrelated
+// flags neither contend nor wake each other.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/once.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/atomic.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const unsigned flags = 256;
+  const unsigned calls = 1000000;
+
+  boost::atomic<unsigned> initialized(0);
+
+  void initialize()
+  {
+    // some work
+    const clock::time_point end = clock::now() + boost::chrono::microseconds(20);
+    while (clock::now() < end)
+    {
+    }
+    ++initialized;
+  }
+
+  void startup(std::vector<boost::once_flag>* f, unsigned first)
+  {
+    for (unsigned i = 0; i < flags; ++i)
+    {
+      boost::call_once((*f)[(first + i * 7) % flags], &initialize);
+    }
+  }
+
+  void benchmark(unsigned threads)
+  {
+    std::vector<boost::once_flag> f(flags);
+    initialized = 0;
+    const clock::time_point t0 = clock::now();
+    boost::thread_group g;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+      g.create_thread(boost::bind(&startup, &f, t * (flags / threads)));
+    }
+    g.join_all();
+    const clock::duration start = clock::now() - t0;
+
+    const clock::time_point t1 = clock::now();
+    for (unsigned i = 0; i < calls; ++i)
+    {
+      boost::call_once(f[i % flags], &initialize);
+    }
+    const clock::duration initialized_calls = clock::now() - t1;
+
+    std::cout << threads << " threads"
+              << " startup: " << boost::chrono::duration_cast<boost::chrono::microseconds>(start)
+              << " initializations: " << initialized
+              << " call_once on an initialized flag: "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(initialized_calls).count() / double(calls)
+              << " ns" << std::endl;
+  }
+}
+
+int main()
+{
+  for (unsigned threads = 8; threads <= 64; threads *= 2)
+  {
+    benchmark(threads);
+  }
+  return 0;
+}
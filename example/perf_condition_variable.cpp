@@ -7,10 +7,9 @@
 // This performance test is based on the performance test provided by maxim.yegorushkin
 // at https://svn.boost.org/trac/boost/ticket/7422
 
-#define BOOST_THREAD_DONT_PROVIDE_INTERRUPTIONS
-
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread_only.hpp>
 #include <boost/chrono/stopwatches/simple_stopwatch.hpp>
 
 #include <condition_variable>
@@ -61,6 +60,8 @@ namespace
     typedef boost::condition_variable condition_variable;
     typedef boost::mutex mutex;
     typedef boost::mutex::scoped_lock scoped_lock;
+    // the waits of boost::thread are interruption points
+    typedef boost::thread thread;
   };
 
   struct StdTypes
@@ -68,6 +69,7 @@ namespace
     typedef std::condition_variable condition_variable;
     typedef std::mutex mutex;
     typedef std::unique_lock<std::mutex> scoped_lock;
+    typedef std::thread thread;
   };
 
   template <class Types>
@@ -145,7 +147,7 @@ namespace
 
     auto best_producer_time = std::numeric_limits<Stopwatch::rep>::max BOOST_PREVENT_MACRO_SUBSTITUTION ();
 
-    std::vector<std::thread> consumers
+    std::vector<typename Types::thread> consumers
     { consumer_count };
 
     // Run the benchmark 10 times and report the best time.
@@ -156,10 +158,10 @@ namespace
 
       // Start the consumers.
       for (unsigned i = 0; i < consumer_count; ++i)
-        consumers[i] = std::thread
+        consumers[i] = typename Types::thread
         { consumer_thread<S> , &shared_data };
       // Start the producer and wait till it finishes.
-      std::thread
+      typename Types::thread
       { producer_thread<S> , &shared_data }.join();
       // Wait till consumers finish.
       for (unsigned i = 0; i < consumer_count; ++i)
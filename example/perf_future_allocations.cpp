@@ -0,0 +1,120 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Counts the calls to the global operator new, and measures the time, per creation of the shared
+// state of a promise, a ready future, a deferred async and a continuation.
+//
+// The shared states and their shared_ptr control blocks are recycled through per-thread free lists,
+// so that in a steady state creating a future doesn't call operator new.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#include <boost/thread/future.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+  std::size_t news = 0;
+}
+
+void* operator new(std::size_t size)
+{
+  ++news;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+// out of line, so that the compiler doesn't pair the inlined free with the operator new calls
+BOOST_NOINLINE void operator delete(void* p) BOOST_NOEXCEPT
+{
+  std::free(p);
+}
+
+#if ! defined BOOST_NO_CXX14_SIZED_DEALLOCATION || __cpp_sized_deallocation
+BOOST_NOINLINE void operator delete(void* p, std::size_t) BOOST_NOEXCEPT
+{
+  std::free(p);
+}
+#endif
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const int iterations = 200000;
+
+  int next(boost::future<int> f)
+  {
+    return f.get() + 1;
+  }
+
+  template <class F>
+  void benchmark(const char* name, F f)
+  {
+    // warm up the free lists
+    for (int i = 0; i < 100; ++i) f(i);
+    const std::size_t news0 = news;
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < iterations; ++i) f(i);
+    const clock::duration d = clock::now() - t0;
+    std::cout << name << ": "
+              << double(news - news0) / iterations << " operator new, "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(d).count() / double(iterations)
+              << " ns" << std::endl;
+  }
+
+  void promise(int i)
+  {
+    boost::promise<int> p;
+    boost::future<int> f = p.get_future();
+    p.set_value(i);
+    f.get();
+  }
+
+  void ready(int i)
+  {
+    boost::make_ready_future(i).get();
+  }
+
+#if defined BOOST_THREAD_PROVIDES_VARIADIC_THREAD
+  int one()
+  {
+    return 1;
+  }
+
+  void deferred(int)
+  {
+    boost::future<int> f = boost::async(boost::launch::deferred, &one);
+    f.get();
+  }
+#endif
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+  void then(int i)
+  {
+    boost::make_ready_future(i).then(boost::launch::sync, &next).get();
+  }
+#endif
+}
+
+int main()
+{
+  benchmark("promise", &promise);
+  benchmark("make_ready_future", &ready);
+#if defined BOOST_THREAD_PROVIDES_VARIADIC_THREAD
+  benchmark("async deferred", &deferred);
+#endif
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+  benchmark("make_ready_future().then()", &then);
+#endif
+  return 0;
+}
@@ -0,0 +1,78 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures checking and consuming futures that are already ready, as in pipelines chaining mostly
+// ready futures, and the cost of making a promise ready when nobody waits for it.
+//
+// The ready state of a future is an atomic word, so that is_ready(), wait() and get() on a ready
+// future don't lock the mutex of the shared state, and set_value() only notifies registered waiters.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/csbl/vector.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const int iterations = 1000000;
+
+  void report(const char* name, clock::duration d)
+  {
+    std::cout << name << ": "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(d).count() / double(iterations)
+              << " ns" << std::endl;
+  }
+}
+
+int main()
+{
+  volatile int sink = 0;
+  {
+    boost::shared_future<int> f = boost::make_ready_future(1).share();
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+      sink = sink + f.is_ready();
+    }
+    report("is_ready on a ready future", clock::now() - t0);
+  }
+  {
+    boost::shared_future<int> f = boost::make_ready_future(1).share();
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+      f.wait();
+      sink = sink + f.get();
+    }
+    report("wait and get on a ready shared_future", clock::now() - t0);
+  }
+  {
+    boost::csbl::vector<boost::future<int> > v;
+    v.reserve(iterations);
+    for (int i = 0; i < iterations; ++i)
+    {
+      v.push_back(boost::make_ready_future(i));
+    }
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+      sink = sink + v[i].get();
+    }
+    report("get on a ready future", clock::now() - t0);
+  }
+  {
+    boost::csbl::vector<boost::promise<int> > v(iterations);
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+      v[i].set_value(i);
+    }
+    report("set_value without waiters", clock::now() - t0);
+  }
+  return 0;
+}
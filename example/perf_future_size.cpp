@@ -0,0 +1,77 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Reports the size of the future shared states, and measures creating a promise and making it ready,
+// without waiters and with a thread blocked on its future.
+//
+// The condition variable, the wait_for_any waiters, the wait callback, the additional continuations
+// and the executor of a shared state are kept in a side block allocated on first use, so that the
+// common state fits in two cache lines and only blocked or shared futures pay for the rest.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const int iterations = 200000;
+  const int blocked_iterations = 2000;
+
+  template <class S>
+  void size(const char* name)
+  {
+    std::cout << "sizeof(" << name << "): " << sizeof(S) << " bytes, "
+              << (sizeof(S) + BOOST_THREAD_CACHE_LINE_SIZE - 1) / BOOST_THREAD_CACHE_LINE_SIZE << " cache lines" << std::endl;
+  }
+
+  void report(const char* name, clock::duration d, int n)
+  {
+    std::cout << name << ": "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(d).count() / double(n)
+              << " ns" << std::endl;
+  }
+
+  void get(boost::future<int>* f)
+  {
+    f->get();
+  }
+}
+
+int main()
+{
+  size<boost::detail::shared_state_base>("shared_state_base");
+  size<boost::detail::shared_state<void> >("shared_state<void>");
+  size<boost::detail::shared_state<int> >("shared_state<int>");
+  size<boost::detail::shared_state<int&> >("shared_state<int&>");
+  {
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+      boost::promise<int> p;
+      boost::future<int> f = p.get_future();
+      p.set_value(i);
+      f.get();
+    }
+    report("promise without waiters", clock::now() - t0, iterations);
+  }
+  {
+    const clock::time_point t0 = clock::now();
+    for (int i = 0; i < blocked_iterations; ++i)
+    {
+      boost::promise<int> p;
+      boost::future<int> f = p.get_future();
+      boost::thread t(get, &f);
+      boost::this_thread::yield();
+      p.set_value(i);
+      t.join();
+    }
+    report("promise with a blocked thread", clock::now() - t0, blocked_iterations);
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures the this_thread operations that look up the data of the current thread, from a thread
+// created by Boost.Thread and from the main thread, which isn't.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/thread.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  const unsigned calls = 10000000;
+
+  template <class F>
+  void measure(const char* what, F f)
+  {
+    const clock::time_point t0 = clock::now();
+    for (unsigned i = 0; i < calls; ++i)
+    {
+      f();
+    }
+    const clock::duration elapsed = clock::now() - t0;
+    std::cout << "  " << what << ": "
+              << boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed).count() / double(calls)
+              << " ns" << std::endl;
+  }
+
+  void interruption_point()
+  {
+    boost::this_thread::interruption_point();
+  }
+
+  // keeps the results alive
+  volatile bool requested = false;
+  boost::thread::id id;
+
+  void interruption_requested()
+  {
+    requested = boost::this_thread::interruption_requested();
+  }
+
+  void get_id()
+  {
+    id = boost::this_thread::get_id();
+  }
+
+  void benchmark()
+  {
+    measure("interruption_point()", &interruption_point);
+    measure("interruption_requested()", &interruption_requested);
+    measure("get_id()", &get_id);
+  }
+}
+
+int main()
+{
+  std::cout << "boost::thread" << std::endl;
+  boost::thread t(&benchmark);
+  t.join();
+  std::cout << "main thread" << std::endl;
+  benchmark();
+  return 0;
+}
@@ -12,23 +12,50 @@
 
 #include <iostream>
 #include <boost/thread/lock_types.hpp>
-#include <boost/thread/thread_only.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/chrono/chrono_io.hpp>
 
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/distributed_shared_mutex.hpp>
 
 using namespace boost;
 
 shared_mutex mtx;
+distributed_shared_mutex dmtx;
 const int cycles = 10000;
 
-void shared()
+template <class Mutex, Mutex& m>
+void shared_on()
 {
   int cycle(0);
   while (++cycle < cycles)
   {
-    shared_lock<shared_mutex> lock(mtx);
+    shared_lock<Mutex> lock(m);
+  }
+}
+
+void shared()
+{
+  shared_on<shared_mutex, mtx>();
+}
+
+// Only readers: the time per lock_shared/unlock_shared pair shows how the readers scale.
+template <class Mutex, Mutex& m>
+void readers(int n, const char* name)
+{
+  boost::chrono::high_resolution_clock::duration best_time(std::numeric_limits<boost::chrono::high_resolution_clock::duration::rep>::max BOOST_PREVENT_MACRO_SUBSTITUTION ());
+  for (int i = 10; i>0; --i) {
+    boost::chrono::high_resolution_clock::time_point s1 = boost::chrono::high_resolution_clock::now();
+    thread_group threads;
+    for (int t = 0; t < n; ++t)
+    {
+      threads.create_thread(shared_on<Mutex, m>);
+    }
+    threads.join_all();
+    boost::chrono::high_resolution_clock::time_point f1 = boost::chrono::high_resolution_clock::now();
+    best_time = std::min BOOST_PREVENT_MACRO_SUBSTITUTION (best_time, f1 - s1);
   }
+  std::cout << name << ", " << n << " readers, time spent/cycle:" << best_time/cycles/n << std::endl;
 }
 
 void unique()
@@ -67,6 +94,12 @@ int main()
   std::cout << "Best Time spent:" << best_time << std::endl;
   std::cout << "Time spent/cycle:" << best_time/cycles/3 << std::endl;
 
+  for (int n = 1; n <= 64; n *= 2)
+  {
+    readers<shared_mutex, mtx>(n, "shared_mutex");
+    readers<distributed_shared_mutex, dmtx>(n, "distributed_shared_mutex");
+  }
+
   return 1;
 }
 
@@ -0,0 +1,133 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Counts the context switches per push on a sync_queue with N idle consumers.
+//
+// The "notify_all" queue reproduces the previous behavior of sync_queue, which woke every
+// waiting consumer on each push. sync_queue now wakes a single consumer, and only when one
+// is waiting.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/concurrent_queues/sync_queue.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/thread/detail/thread_group.hpp>
+#include <boost/atomic.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+#include <deque>
+
+#if defined BOOST_THREAD_PLATFORM_PTHREAD
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+  long context_switches()
+  {
+#if defined BOOST_THREAD_PLATFORM_PTHREAD
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+#else
+    return 0;
+#endif
+  }
+
+  // sync_queue as it was before waiting consumers were tracked
+  class notify_all_queue
+  {
+    boost::mutex mtx_;
+    boost::condition_variable cond_;
+    std::deque<int> data_;
+    bool closed_;
+  public:
+    notify_all_queue() : closed_(false) {}
+
+    void push(int x)
+    {
+      boost::unique_lock<boost::mutex> lk(mtx_);
+      data_.push_back(x);
+      cond_.notify_all();
+    }
+    boost::queue_op_status wait_pull(int& x)
+    {
+      boost::unique_lock<boost::mutex> lk(mtx_);
+      while (data_.empty() && ! closed_) cond_.wait(lk);
+      if (data_.empty()) return boost::queue_op_status::closed;
+      x = data_.front();
+      data_.pop_front();
+      return boost::queue_op_status::success;
+    }
+    void close()
+    {
+      boost::unique_lock<boost::mutex> lk(mtx_);
+      closed_ = true;
+      cond_.notify_all();
+    }
+  };
+
+  template <class Queue>
+  struct consumer
+  {
+    Queue* q_;
+    boost::atomic<int>* consumed_;
+    consumer(Queue* q, boost::atomic<int>* consumed) : q_(q), consumed_(consumed) {}
+    void operator()()
+    {
+      int x = 0;
+      while (q_->wait_pull(x) == boost::queue_op_status::success)
+      {
+        ++*consumed_;
+      }
+    }
+  };
+
+  template <class Queue>
+  void benchmark(const char* name, unsigned consumers, int pushes)
+  {
+    Queue q;
+    boost::atomic<int> consumed(0);
+    boost::thread_group threads;
+    for (unsigned i = 0; i < consumers; ++i)
+      threads.create_thread(consumer<Queue>(&q, &consumed));
+    // let all the consumers block on the queue
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+
+    long cs0 = context_switches();
+    boost::chrono::steady_clock::time_point t0 = boost::chrono::steady_clock::now();
+    for (int i = 0; i < pushes; ++i)
+    {
+      q.push(i);
+      // submit one work at a time, as a thread pool with idle workers would see it
+      while (consumed.load() != i + 1)
+        boost::this_thread::yield();
+    }
+    boost::chrono::steady_clock::duration elapsed = boost::chrono::steady_clock::now() - t0;
+    long cs1 = context_switches();
+
+    q.close();
+    threads.join_all();
+
+    std::cout << name << " consumers: " << consumers
+              << " context switches/push: " << double(cs1 - cs0) / pushes
+              << " time/push: " << boost::chrono::duration_cast<boost::chrono::nanoseconds>(elapsed) / pushes
+              << std::endl;
+  }
+}
+
+int main()
+{
+  const int pushes = 10000;
+  for (unsigned consumers = 1; consumers <= 16; consumers *= 2)
+  {
+    benchmark<notify_all_queue>("notify_all          ", consumers, pushes);
+    benchmark<boost::sync_queue<int> >("sync_queue (targeted)", consumers, pushes);
+  }
+  return 0;
+}
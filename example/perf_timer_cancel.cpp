@@ -0,0 +1,112 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Pushes 1M timers on a timed queue, cancels 99% of them and drains the queue once they are due.
+//
+// The "flag" runs reproduce how a timer had to be cancelled before submit_at/submit_after returned a
+// timer_handle: the work checks a shared flag when it runs, so the cancelled work stays in the queue
+// with everything it captured until it is due. The "handle" runs cancel through the timer_handle,
+// which destroys the work at once.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/concurrent_queues/sync_timed_queue.hpp>
+#include <boost/thread/concurrent_queues/sync_timing_wheel_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  long alive_timers = 0;
+  const std::size_t state_size = 128;
+
+  // a timer callback capturing some state
+  struct timer_work
+  {
+    boost::shared_ptr<bool> cancelled;
+    std::vector<char> state;
+
+    timer_work() : state(state_size) { ++alive_timers; }
+    timer_work(timer_work const& x) : cancelled(x.cancelled), state(x.state) { ++alive_timers; }
+    timer_work& operator=(timer_work const& x)
+    {
+      cancelled = x.cancelled;
+      state = x.state;
+      return *this;
+    }
+    ~timer_work() { --alive_timers; }
+
+    bool operator()() const
+    {
+      return ! (cancelled && *cancelled);
+    }
+  };
+
+  typedef boost::chrono::steady_clock clock;
+
+  template <class Queue>
+  void benchmark(const char* name, bool use_handles, int timers)
+  {
+    Queue q;
+    const clock::time_point t0 = clock::now();
+    const clock::time_point due = t0 + boost::chrono::milliseconds(500);
+
+    std::vector<boost::timer_handle> handles;
+    std::vector<boost::shared_ptr<bool> > flags;
+    handles.reserve(timers);
+    if (! use_handles) flags.reserve(timers);
+    for (int i = 0; i < timers; ++i)
+    {
+      timer_work w;
+      if (! use_handles)
+      {
+        w.cancelled = boost::make_shared<bool>(false);
+        flags.push_back(w.cancelled);
+      }
+      handles.push_back(q.push(w, due + boost::chrono::nanoseconds(i)));
+    }
+    for (int i = 0; i < timers; ++i)
+    {
+      if (i % 100 == 0) continue;
+      if (use_handles) handles[i].cancel();
+      else *flags[i] = true;
+    }
+    const clock::duration push_cancel = clock::now() - t0;
+    const long pending = alive_timers;
+
+    boost::this_thread::sleep_until(due + boost::chrono::milliseconds(10));
+    const clock::time_point t1 = clock::now();
+    int run = 0;
+    timer_work w;
+    while (q.try_pull(w) == boost::queue_op_status::success)
+    {
+      if (w()) ++run;
+    }
+    const clock::duration drain = clock::now() - t1;
+
+    std::cout << name
+              << " push+cancel: " << boost::chrono::duration_cast<boost::chrono::milliseconds>(push_cancel)
+              << " drain: " << boost::chrono::duration_cast<boost::chrono::milliseconds>(drain)
+              << " callbacks kept after cancel: " << pending
+              << " (" << pending * (sizeof(timer_work) + state_size) / 1024 << " KiB)"
+              << " run: " << run
+              << std::endl;
+  }
+}
+
+int main()
+{
+  const int timers = 1000000;
+  benchmark<boost::sync_timed_queue<timer_work> >("sync_timed_queue flag         ", false, timers);
+  benchmark<boost::sync_timed_queue<timer_work> >("sync_timed_queue handle       ", true, timers);
+  benchmark<boost::concurrent::sync_timing_wheel_queue<timer_work> >("sync_timing_wheel_queue flag  ", false, timers);
+  benchmark<boost::concurrent::sync_timing_wheel_queue<timer_work> >("sync_timing_wheel_queue handle", true, timers);
+  return 0;
+}
@@ -0,0 +1,95 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Waits with when_all/when_any for 10k promises set by a few producer threads and measures the time
+// to create the aggregate future and the time until the consumer waiting for it is woken.
+//
+// The future returned by when_all/when_any is made ready by the producer setting the last/first
+// promise, so that no thread is parked per call waiting for the inputs.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/chrono/chrono_io.hpp>
+
+#include <iostream>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+namespace
+{
+  typedef boost::chrono::steady_clock clock;
+  typedef boost::csbl::vector<boost::future<int> > futures;
+  const std::size_t fan_out = 10000;
+  const int producers = 4;
+  const int rounds = 20;
+
+  void produce(boost::csbl::vector<boost::promise<int> >& p, std::size_t first)
+  {
+    for (std::size_t i = first; i < p.size(); i += producers)
+    {
+      p[i].set_value(int(i));
+    }
+  }
+
+  template <class When>
+  void benchmark(const char* name, When when)
+  {
+    clock::duration create(0);
+    clock::duration wake(0);
+    for (int r = 0; r < rounds; ++r)
+    {
+      boost::csbl::vector<boost::promise<int> > p(fan_out);
+      futures v;
+      v.reserve(fan_out);
+      for (std::size_t i = 0; i < fan_out; ++i)
+      {
+        v.push_back(p[i].get_future());
+      }
+      const clock::time_point t0 = clock::now();
+      boost::future<futures> all = when(v);
+      create += clock::now() - t0;
+
+      boost::thread_group g;
+      const clock::time_point t1 = clock::now();
+      for (int t = 0; t < producers; ++t)
+      {
+        g.create_thread(boost::bind(&produce, boost::ref(p), std::size_t(t)));
+      }
+      all.wait();
+      wake += clock::now() - t1;
+      g.join_all();
+    }
+    std::cout << name
+              << " create: " << boost::chrono::duration_cast<boost::chrono::microseconds>(create / rounds)
+              << " produce+wake: " << boost::chrono::duration_cast<boost::chrono::microseconds>(wake / rounds)
+              << std::endl;
+  }
+
+  boost::future<futures> all(futures& v)
+  {
+    return boost::when_all(v.begin(), v.end());
+  }
+
+  boost::future<futures> any(futures& v)
+  {
+    return boost::when_any(v.begin(), v.end());
+  }
+}
+#endif
+
+int main()
+{
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+  benchmark("when_all", &all);
+  benchmark("when_any", &any);
+#endif
+  return 0;
+}
@@ -0,0 +1,311 @@
+#ifndef BOOST_THREAD_ADAPTIVE_MUTEX_HPP
+#define BOOST_THREAD_ADAPTIVE_MUTEX_HPP
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/lockable_traits.hpp>
+#include <boost/atomic.hpp>
+#if defined BOOST_THREAD_USES_FUTEX
+#include <boost/thread/pthread/futex.hpp>
+#include <boost/thread/detail/platform_time.hpp>
+#include <errno.h>
+#else
+#include <boost/thread/mutex.hpp>
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#endif
+
+#include <algorithm>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+// The maximum number of times a thread retries to take an adaptive_mutex before parking.
+#ifndef BOOST_THREAD_ADAPTIVE_MUTEX_MAX_SPINS
+#define BOOST_THREAD_ADAPTIVE_MUTEX_MAX_SPINS 100
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace detail
+  {
+    // Tells the processor the calling thread is busy waiting.
+    inline void cpu_relax() BOOST_NOEXCEPT
+    {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+      _mm_pause();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+      __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || (defined(__arm__) && defined(__ARM_ARCH) && __ARM_ARCH >= 7))
+      __asm__ __volatile__("yield" ::: "memory");
+#else
+      atomic_signal_fence(memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * Retries to take a lock for a bounded number of times, pausing twice as long after each failure.
+     *
+     * The bound is twice the average number of retries the recent successful spins needed, so the
+     * threads spin long enough for the critical sections the lock usually protects and give up early
+     * on a lock held for long. A failed spin shrinks the average.
+     */
+    class adaptive_spinner
+    {
+      BOOST_STATIC_CONSTANT(int, max_spins = BOOST_THREAD_ADAPTIVE_MUTEX_MAX_SPINS);
+      BOOST_STATIC_CONSTANT(int, min_spins = 8);
+      BOOST_STATIC_CONSTANT(int, max_pauses = 16);
+
+      // Protected by nothing, an approximate value is good enough.
+      atomic<int> average_;
+
+    public:
+      adaptive_spinner() BOOST_NOEXCEPT : average_(min_spins) {}
+
+      /**
+       * Effects: Calls lockable.try_lock() until it succeeds, at most the current bound times.
+       *
+       * Returns: Whether the lock has been taken.
+       */
+      template <class Lockable>
+      bool spin(Lockable& lockable)
+      {
+        int const average = average_.load(memory_order_relaxed);
+        int const limit = (std::min)(int(max_spins), 2 * average + min_spins);
+        int pauses = 1;
+        for (int n = 0; n < limit; ++n)
+        {
+          for (int i = 0; i < pauses; ++i) cpu_relax();
+          if (pauses < max_pauses) pauses *= 2;
+          if (lockable.try_lock())
+          {
+            average_.store(average + (n - average) / 8, memory_order_relaxed);
+            return true;
+          }
+        }
+        average_.store(average - average / 8, memory_order_relaxed);
+        return false;
+      }
+    };
+  }
+
+#if defined BOOST_THREAD_USES_FUTEX
+
+  /**
+   * A mutex for short critical sections: a thread that can't take it spins a little, in the hope the
+   * owner releases it soon, before parking on a futex word.
+   *
+   * The word is 0 when unlocked, 1 when locked and 2 when locked and a thread may be parked on it, so
+   * that taking and releasing the mutex without contention are a single atomic operation.
+   */
+  class adaptive_mutex
+  {
+  protected:
+    detail::futex_word state_;
+    detail::adaptive_spinner spinner_;
+
+    // Marks the mutex as having waiters and waits for it, until it is taken or timeout, if any, is
+    // reached.
+    bool park(detail::internal_platform_timepoint const* timeout)
+    {
+      while (state_.exchange(2, memory_order_acquire) != 0)
+      {
+        int const res = timeout ? detail::futex::wait_until(state_, 2, timeout->getTs()) : detail::futex::wait(state_, 2);
+        if (res == ETIMEDOUT)
+        {
+          return state_.exchange(2, memory_order_acquire) == 0;
+        }
+      }
+      return true;
+    }
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(adaptive_mutex)
+
+    adaptive_mutex() BOOST_NOEXCEPT :
+      state_(0)
+    {
+    }
+
+    bool try_lock()
+    {
+      unsigned expected = 0;
+      return state_.load(memory_order_relaxed) == 0 &&
+          state_.compare_exchange_strong(expected, 1, memory_order_acquire, memory_order_relaxed);
+    }
+
+    void lock()
+    {
+      if (try_lock() || spinner_.spin(*this)) return;
+      park(0);
+    }
+
+    void unlock()
+    {
+      if (state_.exchange(0, memory_order_release) == 2)
+      {
+        detail::futex::wake_one(state_);
+      }
+    }
+  };
+
+  /**
+   * An adaptive_mutex meeting the TimedLockable requirements.
+   */
+  class timed_adaptive_mutex : public adaptive_mutex
+  {
+  public:
+    BOOST_THREAD_NO_COPYABLE(timed_adaptive_mutex)
+
+    timed_adaptive_mutex() BOOST_NOEXCEPT
+    {
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      if (try_lock() || spinner_.spin(*this)) return true;
+      typedef typename common_type<Duration, typename Clock::duration>::type common_duration;
+      common_duration d(abs_time - Clock::now());
+      d = (std::min)(d, common_duration(chrono::milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS)));
+      for (;;)
+      {
+        const detail::internal_platform_timepoint t(detail::internal_chrono_clock::now() + d);
+        if (park(&t)) return true;
+        d = abs_time - Clock::now();
+        if ( d <= common_duration::zero() ) return false; // timeout occurred
+        d = (std::min)(d, common_duration(chrono::milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS)));
+      }
+    }
+#endif
+  };
+
+#else
+
+  /**
+   * A mutex for short critical sections: a thread that can't take it spins a little, in the hope the
+   * owner releases it soon, before blocking on the underlying mutex.
+   */
+  class adaptive_mutex
+  {
+    mutex mtx_;
+    detail::adaptive_spinner spinner_;
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(adaptive_mutex)
+
+    adaptive_mutex()
+    {
+    }
+
+    bool try_lock()
+    {
+      return mtx_.try_lock();
+    }
+
+    void lock()
+    {
+      if (mtx_.try_lock() || spinner_.spin(mtx_)) return;
+      mtx_.lock();
+    }
+
+    void unlock()
+    {
+      mtx_.unlock();
+    }
+  };
+
+  /**
+   * An adaptive_mutex meeting the TimedLockable requirements.
+   */
+  class timed_adaptive_mutex
+  {
+    timed_mutex mtx_;
+    detail::adaptive_spinner spinner_;
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(timed_adaptive_mutex)
+
+    timed_adaptive_mutex()
+    {
+    }
+
+    bool try_lock()
+    {
+      return mtx_.try_lock();
+    }
+
+    void lock()
+    {
+      if (mtx_.try_lock() || spinner_.spin(mtx_)) return;
+      mtx_.lock();
+    }
+
+    void unlock()
+    {
+      mtx_.unlock();
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      if (mtx_.try_lock() || spinner_.spin(mtx_)) return true;
+      return mtx_.try_lock_until(abs_time);
+    }
+#endif
+  };
+
+#endif
+
+#ifdef BOOST_THREAD_NO_AUTO_DETECT_MUTEX_TYPES
+  namespace sync
+  {
+    template<>
+    struct is_basic_lockable<adaptive_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+    template<>
+    struct is_lockable<adaptive_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+    template<>
+    struct is_basic_lockable<timed_adaptive_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+    template<>
+    struct is_lockable<timed_adaptive_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+  }
+#endif
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -16,6 +16,11 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/lock_types.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/thread/detail/counter.hpp>
+#include <boost/thread/detail/thread_index.hpp>
+#include <boost/atomic.hpp>
+#include <boost/scoped_array.hpp>
+#include <algorithm>
 #include <string>
 #include <stdexcept>
 #include <boost/thread/detail/nullary_function.hpp>
@@ -120,6 +125,11 @@ namespace boost
   //BOOST_THREAD_DCL_MOVABLE(thread_detail::void_functor_barrier_reseter)
   //BOOST_THREAD_DCL_MOVABLE(thread_detail::void_fct_ptr_barrier_reseter)
 
+  /**
+   * Arriving at the barrier is a single atomic decrement of the count. The last thread to arrive calls
+   * the completion function, resets the count and advances the generation the other threads wait on,
+   * waking them all at once.
+   */
   class barrier
   {
     static inline unsigned int check_counter(unsigned int count)
@@ -136,7 +146,7 @@ namespace boost
     BOOST_THREAD_NO_COPYABLE( barrier)
 
     explicit barrier(unsigned int count) :
-      m_count(check_counter(count)), m_generation(0), fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count)))
+      m_count(check_counter(count)), fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count)))
     {
     }
 
@@ -149,7 +159,6 @@ namespace boost
         >::type=0
     )
     : m_count(check_counter(count)),
-      m_generation(0),
       fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::void_functor_barrier_reseter(count,
         boost::move(funct)))
     )
@@ -164,7 +173,6 @@ namespace boost
         >::type=0
     )
     : m_count(check_counter(count)),
-      m_generation(0),
       fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::void_functor_barrier_reseter(count,
         funct))
     )
@@ -180,7 +188,6 @@ namespace boost
         >::type=0
     )
     : m_count(check_counter(count)),
-      m_generation(0),
       fct_(boost::move(funct))
     {
     }
@@ -193,13 +200,12 @@ namespace boost
         >::type=0
     )
     : m_count(check_counter(count)),
-      m_generation(0),
       fct_(funct)
     {
     }
 
     barrier(unsigned int count, void(*funct)()) :
-      m_count(check_counter(count)), m_generation(0),
+      m_count(check_counter(count)),
       fct_(funct
           ? BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(BOOST_THREAD_MAKE_RV_REF(thread_detail::void_fct_ptr_barrier_reseter(count, funct))))
           : BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count))))
@@ -207,7 +213,7 @@ namespace boost
     {
     }
     barrier(unsigned int count, unsigned int(*funct)()) :
-      m_count(check_counter(count)), m_generation(0),
+      m_count(check_counter(count)),
       fct_(funct
           ? BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(funct))
           : BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count))))
@@ -217,21 +223,19 @@ namespace boost
 
     bool wait()
     {
-      boost::unique_lock < boost::mutex > lock(m_mutex);
-      unsigned int gen = m_generation;
+      unsigned int const gen = m_generation.load();
 
-      if (--m_count == 0)
+      if (m_count.fetch_sub(1) == 1)
       {
-        m_generation++;
-        m_count = static_cast<unsigned int>(fct_());
-        BOOST_ASSERT(m_count != 0);
-        lock.unlock();
-        m_cond.notify_all();
+        unsigned int const count = static_cast<unsigned int>(fct_());
+        BOOST_ASSERT(count != 0);
+        // the threads of the next cycle arrive only once the generation has been advanced
+        m_count.store(count);
+        m_generation.advance();
         return true;
       }
 
-      while (gen == m_generation)
-        m_cond.wait(lock);
+      m_generation.wait(gen);
       return false;
     }
 
@@ -241,10 +245,238 @@ namespace boost
     }
 
   private:
-    mutex m_mutex;
-    condition_variable m_cond;
+    boost::atomic<unsigned int> m_count;
+    detail::generation m_generation;
+    thread_detail::size_completion_function fct_;
+  };
+
+  /**
+   * A barrier for many threads: the threads arrive at the leaves of a combining tree, each node
+   * counting the arrivals of at most fan_in threads or child nodes on its own cache line. The last
+   * thread to arrive at a node goes on to its parent, and the thread completing the root calls the
+   * completion function, resets the tree and releases all the threads at once.
+   *
+   * A thread arrives at the leaf of its thread index divided by fan_in, so that threads started one
+   * after the other, and often running on neighbouring CPUs, share a leaf. When that leaf is full in
+   * the current cycle it arrives at the next leaf with room.
+   */
+  class tree_barrier
+  {
+    static inline unsigned int check_counter(unsigned int count)
+    {
+      if (count == 0) boost::throw_exception(
+          thread_exception(system::errc::invalid_argument, "tree_barrier constructor: count cannot be zero."));
+      return count;
+    }
+    static inline unsigned int check_fan_in(unsigned int fan_in)
+    {
+      if (fan_in < 2) boost::throw_exception(
+          thread_exception(system::errc::invalid_argument, "tree_barrier constructor: fan_in must be at least 2."));
+      return fan_in;
+    }
+    struct dummy
+    {
+    };
+
+    struct node
+    {
+      boost::atomic<unsigned int> arrived;
+      unsigned int capacity;
+      unsigned int parent;
+      char pad_[BOOST_THREAD_CACHE_LINE_SIZE - sizeof(boost::atomic<unsigned int>) - 2 * sizeof(unsigned int)];
+
+      node() : arrived(0), capacity(0), parent(0) {}
+    };
+
+  public:
+    BOOST_STATIC_CONSTANT(unsigned int, default_fan_in = 4);
+
+    BOOST_THREAD_NO_COPYABLE( tree_barrier)
+
+    explicit tree_barrier(unsigned int count, unsigned int fan_in = default_fan_in) :
+      m_fan_in(check_fan_in(fan_in)), fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count)))
+    {
+      build(check_counter(count));
+    }
+
+    template <typename F>
+    tree_barrier(
+        unsigned int count,
+        unsigned int fan_in,
+        BOOST_THREAD_RV_REF(F) funct,
+        typename enable_if<
+        typename is_void<typename result_of<F()>::type>::type, dummy*
+        >::type=0
+    )
+    : m_fan_in(check_fan_in(fan_in)),
+      fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::void_functor_barrier_reseter(count,
+        boost::move(funct)))
+    )
+    {
+      build(check_counter(count));
+    }
+    template <typename F>
+    tree_barrier(
+        unsigned int count,
+        unsigned int fan_in,
+        F &funct,
+        typename enable_if<
+        typename is_void<typename result_of<F()>::type>::type, dummy*
+        >::type=0
+    )
+    : m_fan_in(check_fan_in(fan_in)),
+      fct_(BOOST_THREAD_MAKE_RV_REF(thread_detail::void_functor_barrier_reseter(count,
+        funct))
+    )
+    {
+      build(check_counter(count));
+    }
+
+    template <typename F>
+    tree_barrier(
+        unsigned int count,
+        unsigned int fan_in,
+        BOOST_THREAD_RV_REF(F) funct,
+        typename enable_if<
+        typename is_same<typename result_of<F()>::type, unsigned int>::type, dummy*
+        >::type=0
+    )
+    : m_fan_in(check_fan_in(fan_in)),
+      fct_(boost::move(funct))
+    {
+      build(check_counter(count));
+    }
+    template <typename F>
+    tree_barrier(
+        unsigned int count,
+        unsigned int fan_in,
+        F& funct,
+        typename enable_if<
+        typename is_same<typename result_of<F()>::type, unsigned int>::type, dummy*
+        >::type=0
+    )
+    : m_fan_in(check_fan_in(fan_in)),
+      fct_(funct)
+    {
+      build(check_counter(count));
+    }
+
+    tree_barrier(unsigned int count, unsigned int fan_in, void(*funct)()) :
+      m_fan_in(check_fan_in(fan_in)),
+      fct_(funct
+          ? BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(BOOST_THREAD_MAKE_RV_REF(thread_detail::void_fct_ptr_barrier_reseter(count, funct))))
+          : BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count))))
+      )
+    {
+      build(check_counter(count));
+    }
+    tree_barrier(unsigned int count, unsigned int fan_in, unsigned int(*funct)()) :
+      m_fan_in(check_fan_in(fan_in)),
+      fct_(funct
+          ? BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(funct))
+          : BOOST_THREAD_MAKE_RV_REF(thread_detail::size_completion_function(BOOST_THREAD_MAKE_RV_REF(thread_detail::default_barrier_reseter(count))))
+      )
+    {
+      build(check_counter(count));
+    }
+
+    bool wait()
+    {
+      unsigned int const gen = m_generation.load();
+
+      if (arrive())
+      {
+        unsigned int const count = static_cast<unsigned int>(fct_());
+        BOOST_ASSERT(count != 0);
+        // all the threads of this cycle have arrived, none of them uses the nodes until released
+        if (count != m_count)
+        {
+          build(count);
+        }
+        else
+        {
+          for (unsigned int i = 0; i < m_size; ++i)
+          {
+            m_nodes[i].arrived.store(0, memory_order_relaxed);
+          }
+        }
+        m_generation.advance();
+        return true;
+      }
+
+      m_generation.wait(gen);
+      return false;
+    }
+
+    void count_down_and_wait()
+    {
+      wait();
+    }
+
+  private:
+    // Lays out the nodes level by level, from the leaves to the root.
+    void build(unsigned int count)
+    {
+      unsigned int size = 0;
+      for (unsigned int n = count; ; n = (n + m_fan_in - 1) / m_fan_in)
+      {
+        unsigned int const level = (n + m_fan_in - 1) / m_fan_in;
+        size += level;
+        if (level == 1) break;
+      }
+      m_nodes.reset(new node[size]);
+      m_size = size;
+      m_count = count;
+      m_leaves = (count + m_fan_in - 1) / m_fan_in;
+
+      unsigned int first = 0;
+      for (unsigned int n = count; ; n = (n + m_fan_in - 1) / m_fan_in)
+      {
+        unsigned int const level = (n + m_fan_in - 1) / m_fan_in;
+        for (unsigned int i = 0; i < level; ++i)
+        {
+          node& nd = m_nodes[first + i];
+          nd.capacity = (std::min)(m_fan_in, n - i * m_fan_in);
+          nd.parent = first + level + i / m_fan_in;
+        }
+        first += level;
+        if (level == 1) break;
+      }
+    }
+
+    // Returns true if the calling thread is the last to arrive at the root.
+    bool arrive()
+    {
+      unsigned int i = (thread_detail::thread_index() / m_fan_in) % m_leaves;
+      for (;;)
+      {
+        node& leaf = m_nodes[i];
+        if (leaf.arrived.load(memory_order_relaxed) < leaf.capacity)
+        {
+          unsigned int const arrived = leaf.arrived.fetch_add(1, memory_order_acq_rel);
+          if (arrived < leaf.capacity)
+          {
+            if (arrived + 1 < leaf.capacity) return false;
+            break;
+          }
+        }
+        i = (i + 1 == m_leaves) ? 0 : i + 1;
+      }
+      // the last thread to arrive at a node arrives at its parent
+      for (unsigned int const root = m_size - 1; i != root; )
+      {
+        i = m_nodes[i].parent;
+        if (m_nodes[i].arrived.fetch_add(1, memory_order_acq_rel) + 1 < m_nodes[i].capacity) return false;
+      }
+      return true;
+    }
+
+    unsigned int const m_fan_in;
     unsigned int m_count;
-    unsigned int m_generation;
+    unsigned int m_leaves;
+    unsigned int m_size;
+    boost::scoped_array<node> m_nodes;
+    detail::generation m_generation;
     thread_detail::size_completion_function fct_;
   };
 
@@ -51,9 +51,9 @@ namespace boost
       around_wait(completion_latch &that, boost::unique_lock<boost::mutex> &lk)
       : that_(that), lk_(lk)
       {
-        that_.leavers_.cond_.wait(lk, detail::counter_is_zero(that_.leavers_));
+        that_.leavers_.wait(lk, detail::counter_is_zero(that_.leavers_));
         that_.waiters_.inc_and_notify_all();
-        that_.leavers_.cond_.wait(lk, detail::counter_is_not_zero(that_.leavers_));
+        that_.leavers_.wait(lk, detail::counter_is_not_zero(that_.leavers_));
       }
       ~around_wait()
       {
@@ -66,10 +66,10 @@ namespace boost
       BOOST_ASSERT(count_ > 0);
       if (--count_ == 0)
       {
-        waiters_.cond_.wait(lk, detail::counter_is_not_zero(waiters_));
+        waiters_.wait(lk, detail::counter_is_not_zero(waiters_));
         leavers_.assign_and_notify_all(waiters_);
-        count_.cond_.notify_all();
-        waiters_.cond_.wait(lk, detail::counter_is_zero(waiters_));
+        count_.notify_all();
+        waiters_.wait(lk, detail::counter_is_zero(waiters_));
         leavers_.assign_and_notify_all(0);
         lk.unlock();
         funct_();
@@ -111,7 +111,7 @@ namespace boost
     {
       boost::unique_lock<boost::mutex> lk(mutex_);
       around_wait aw(*this, lk);
-      count_.cond_.wait(lk, detail::counter_is_zero(count_));
+      count_.wait(lk, detail::counter_is_zero(count_));
     }
 
     /// @return true if the internal counter is already 0, false otherwise
@@ -129,7 +129,7 @@ namespace boost
     {
       boost::unique_lock<boost::mutex> lk(mutex_);
       around_wait aw(*this, lk);
-      return count_.cond_.wait_for(lk, rel_time, detail::counter_is_zero(count_))
+      return count_.wait_for(lk, rel_time, detail::counter_is_zero(count_))
               ? cv_status::no_timeout
               : cv_status::timeout;
     }
@@ -141,7 +141,7 @@ namespace boost
     {
       boost::unique_lock<boost::mutex> lk(mutex_);
       around_wait aw(*this, lk);
-      return count_.cond_.wait_until(lk, abs_time, detail::counter_is_zero(count_))
+      return count_.wait_until(lk, abs_time, detail::counter_is_zero(count_))
           ? cv_status::no_timeout
           : cv_status::timeout;
     }
@@ -169,7 +169,7 @@ namespace boost
         return;
       }
       around_wait aw(*this, lk);
-      count_.cond_.wait(lk, detail::counter_is_zero(count_));
+      count_.wait(lk, detail::counter_is_zero(count_));
     }
     void sync()
     {
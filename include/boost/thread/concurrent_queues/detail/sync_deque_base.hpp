@@ -15,6 +15,7 @@
 
 #include <boost/thread/detail/config.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/thread/cv_status.hpp>
 #include <boost/thread/detail/move.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/concurrent_queues/queue_op_status.hpp>
@@ -61,11 +62,19 @@ namespace detail
       return boost::move(data_);
     }
 
+    // Releases the storage not used by the queued elements, e.g. once the queue becomes idle.
+    inline void shrink_to_fit() {
+      lock_guard<mutex> lk(mtx_);
+      data_.shrink_to_fit();
+    }
+
   protected:
     mutable mutex mtx_;
     condition_variable cond_;
     underlying_queue_type data_;
     bool closed_;
+    /// number of consumers blocked on cond_
+    size_type waiting_empty_;
 
     inline bool empty(unique_lock<mutex>& ) const BOOST_NOEXCEPT
     {
@@ -94,18 +103,39 @@ namespace detail
 
     inline void notify_elem_added(unique_lock<mutex>& )
     {
-      cond_.notify_all();
+      if (waiting_empty_ > 0) cond_.notify_one();
     }
     inline void notify_elem_added(lock_guard<mutex>& )
     {
-      cond_.notify_all();
+      if (waiting_empty_ > 0) cond_.notify_one();
+    }
+    /**
+     * Notifies the addition of a batch of n elements with a single notification.
+     */
+    inline void notify_elems_added(unique_lock<mutex>& , size_type n)
+    {
+      if (n == 0 || waiting_empty_ == 0) return;
+      if (n == 1) cond_.notify_one();
+      else cond_.notify_all();
+    }
+    /**
+     * Hands over the notification a consumer may have consumed without pulling an element
+     * (e.g. because it has been interrupted or it is still waiting for the element to be ready).
+     */
+    inline void notify_not_empty_if_needed(unique_lock<mutex>& )
+    {
+      if (! data_.empty() && waiting_empty_ > 0) cond_.notify_one();
     }
 
+    inline void wait_elem(unique_lock<mutex>& lk);
+    template <class WClock, class Duration>
+    cv_status wait_elem_until(unique_lock<mutex>& lk, chrono::time_point<WClock,Duration> const&tp);
+
   };
 
   template <class ValueType, class Queue>
   sync_deque_base<ValueType, Queue>::sync_deque_base() :
-    data_(), closed_(false)
+    data_(), closed_(false), waiting_empty_(0)
   {
     BOOST_ASSERT(data_.empty());
   }
@@ -184,10 +214,50 @@ namespace detail
     return ! data_.empty() || closed_;
   }
 
+  template <class ValueType, class Queue>
+  void sync_deque_base<ValueType, Queue>::wait_elem(unique_lock<mutex>& lk)
+  {
+    ++waiting_empty_;
+    try
+    {
+      cond_.wait(lk);
+    }
+    catch (...)
+    {
+      --waiting_empty_;
+      notify_not_empty_if_needed(lk);
+      throw;
+    }
+    --waiting_empty_;
+  }
+
+  template <class ValueType, class Queue>
+  template <class WClock, class Duration>
+  cv_status sync_deque_base<ValueType, Queue>::wait_elem_until(unique_lock<mutex>& lk, chrono::time_point<WClock,Duration> const&tp)
+  {
+    cv_status st = cv_status::no_timeout;
+    ++waiting_empty_;
+    try
+    {
+      st = cond_.wait_until(lk, tp);
+    }
+    catch (...)
+    {
+      --waiting_empty_;
+      notify_not_empty_if_needed(lk);
+      throw;
+    }
+    --waiting_empty_;
+    return st;
+  }
+
   template <class ValueType, class Queue>
   bool sync_deque_base<ValueType, Queue>::wait_until_not_empty_or_closed(unique_lock<mutex>& lk)
   {
-    cond_.wait(lk, boost::bind(&sync_deque_base<ValueType, Queue>::not_empty_or_closed, boost::ref(*this), boost::ref(lk)));
+    while (! not_empty_or_closed(lk))
+    {
+      wait_elem(lk);
+    }
     if (! empty(lk)) return false; // success
     return true; // closed
   }
@@ -196,8 +266,14 @@ namespace detail
   template <class WClock, class Duration>
   queue_op_status sync_deque_base<ValueType, Queue>::wait_until_not_empty_or_closed_until(unique_lock<mutex>& lk, chrono::time_point<WClock,Duration> const&tp)
   {
-    if (! cond_.wait_until(lk, tp, boost::bind(&sync_deque_base<ValueType, Queue>::not_empty_or_closed, boost::ref(*this), boost::ref(lk))))
-      return queue_op_status::timeout;
+    while (! not_empty_or_closed(lk))
+    {
+      if (wait_elem_until(lk, tp) == cv_status::timeout)
+      {
+        if (! not_empty_or_closed(lk)) return queue_op_status::timeout;
+        break;
+      }
+    }
     if (! empty(lk)) return queue_op_status::success;
     return queue_op_status::closed;
   }
@@ -0,0 +1,155 @@
+#ifndef BOOST_THREAD_CONCURRENT_QUEUES_DETAIL_TIMER_NODE_POOL_HPP
+#define BOOST_THREAD_CONCURRENT_QUEUES_DETAIL_TIMER_NODE_POOL_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/csbl/vector.hpp>
+#include <boost/thread/detail/move.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <cstddef>
+#include <new>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace concurrent
+{
+namespace detail
+{
+
+  /**
+   * Entry of a timed queue, holding an element that can be cancelled through a timer_handle.
+   *
+   * The queues needing more data per entry define their nodes the same way, adding their members.
+   */
+  template <class T>
+  struct timer_node
+  {
+    typedef T value_type;
+
+    timer_node* next;
+    // incremented each time the node is released, so that the stale handles are ignored
+    std::size_t generation;
+    // where the node is stored, timer_node_pool::free_slot when the node is not used
+    unsigned slot;
+    typename aligned_storage<sizeof(T), alignment_of<T>::value>::type storage;
+
+    T& value() BOOST_NOEXCEPT
+    { return *static_cast<T*>(static_cast<void*>(&storage)); }
+  };
+
+  /**
+   * Allocates the timer nodes by chunks and recycles them, so that the nodes stay valid (and the stale
+   * handles can be checked) until the pool is destroyed.
+   */
+  template <class Node>
+  class timer_node_pool
+  {
+  public:
+    typedef Node node;
+    typedef typename Node::value_type value_type;
+    static const unsigned free_slot = ~0u;
+
+  private:
+    static const std::size_t chunk_size = 256;
+    csbl::vector<node*> chunks_;
+    node* free_;
+
+    BOOST_THREAD_NO_COPYABLE(timer_node_pool)
+
+  public:
+    timer_node_pool() BOOST_NOEXCEPT
+      : free_(0)
+    {}
+
+    ~timer_node_pool()
+    {
+      for (std::size_t c = 0; c < chunks_.size(); ++c)
+      {
+        node* chunk = chunks_[c];
+        for (std::size_t i = 0; i < chunk_size; ++i)
+        {
+          if (chunk[i].slot != free_slot) chunk[i].value().~value_type();
+        }
+        delete[] chunk;
+      }
+    }
+
+    /**
+     * \b Returns: a node holding a copy of elem, not free.
+     */
+    template <class U>
+    node* create(BOOST_THREAD_FWD_REF(U) elem)
+    {
+      node* n = allocate();
+      ::new (static_cast<void*>(&n->storage)) value_type(boost::forward<U>(elem));
+      free_ = n->next;
+      n->slot = 0;
+      return n;
+    }
+
+    /**
+     * Destroys the element of the node and recycles it.
+     */
+    void destroy(node* n) BOOST_NOEXCEPT
+    {
+      n->value().~value_type();
+      ++n->generation;
+      n->slot = free_slot;
+      n->next = free_;
+      free_ = n;
+    }
+
+    static bool alive(node* n, std::size_t generation) BOOST_NOEXCEPT
+    {
+      return n->slot != free_slot && n->generation == generation;
+    }
+
+  private:
+    // the first free node, allocating a chunk if needed
+    node* allocate()
+    {
+      if (free_ == 0)
+      {
+        node* chunk = new node[chunk_size];
+        try
+        {
+          chunks_.push_back(chunk);
+        }
+        catch (...)
+        {
+          delete[] chunk;
+          throw;
+        }
+        for (std::size_t i = chunk_size; i > 0; --i)
+        {
+          chunk[i - 1].generation = 0;
+          chunk[i - 1].slot = free_slot;
+          chunk[i - 1].next = free_;
+          free_ = &chunk[i - 1];
+        }
+      }
+      return free_;
+    }
+  };
+
+} // detail
+} // concurrent
+} // boost
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
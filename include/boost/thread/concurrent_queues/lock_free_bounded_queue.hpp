@@ -0,0 +1,532 @@
+#ifndef BOOST_THREAD_CONCURRENT_QUEUES_LOCK_FREE_BOUNDED_QUEUE_HPP
+#define BOOST_THREAD_CONCURRENT_QUEUES_LOCK_FREE_BOUNDED_QUEUE_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/concurrent_queues/queue_op_status.hpp>
+#include <boost/atomic.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace concurrent
+{
+  /**
+   * A bounded multi-producer/multi-consumer queue where the producers and the consumers
+   * synchronize through a sequence number stored in each slot of a ring buffer.
+   *
+   * Pushing and pulling never take a lock. The mutex and the condition variables are only
+   * used by wait_push/wait_pull (and push/pull) when the queue is full or empty, and the
+   * notifications are only done when there is a thread waiting.
+   *
+   * The sequence number of a slot is 2 * pos when it is free for the push at position pos, and
+   * 2 * pos + 1 once the element is there, so that a full slot and a free one never have the same
+   * sequence number, even when the queue holds a single element.
+   *
+   * ValueType must be DefaultConstructible and its move assignment must not throw. The pushed
+   * element is copied before the slot is claimed, so a throwing copy leaves the queue unchanged.
+   * A push that started before close() may still succeed after it.
+   */
+  template <typename ValueType>
+  class lock_free_bounded_queue
+  {
+  public:
+    typedef ValueType value_type;
+    typedef std::size_t size_type;
+    typedef queue_op_status op_status;
+
+    // Constructors/Assignment/Destructors
+    BOOST_THREAD_NO_COPYABLE(lock_free_bounded_queue)
+    explicit lock_free_bounded_queue(size_type max_elems);
+    ~lock_free_bounded_queue();
+
+    // Observers
+    inline bool empty() const;
+    inline bool full() const;
+    inline size_type capacity() const;
+    inline size_type size() const;
+    inline bool closed() const;
+
+    // Modifiers
+    inline void close();
+
+    inline void push(const value_type& x);
+    inline queue_op_status try_push(const value_type& x);
+    inline queue_op_status nonblocking_push(const value_type& x);
+    inline queue_op_status wait_push(const value_type& x);
+    inline void push(BOOST_THREAD_RV_REF(value_type) x);
+    inline queue_op_status try_push(BOOST_THREAD_RV_REF(value_type) x);
+    inline queue_op_status nonblocking_push(BOOST_THREAD_RV_REF(value_type) x);
+    inline queue_op_status wait_push(BOOST_THREAD_RV_REF(value_type) x);
+
+    // Observers/Modifiers
+    inline void pull(value_type&);
+    // enable_if is_nothrow_copy_movable<value_type>
+    inline value_type pull();
+
+    inline queue_op_status try_pull(value_type&);
+    inline queue_op_status nonblocking_pull(value_type&);
+    inline queue_op_status wait_pull(ValueType& elem);
+
+  private:
+    struct cell
+    {
+      atomic<size_type> sequence;
+      value_type data;
+    };
+
+    cell* buffer_;
+    size_type capacity_;
+    char pad0_[BOOST_THREAD_CACHE_LINE_SIZE];
+    atomic<size_type> enqueue_pos_;
+    char pad1_[BOOST_THREAD_CACHE_LINE_SIZE];
+    atomic<size_type> dequeue_pos_;
+    char pad2_[BOOST_THREAD_CACHE_LINE_SIZE];
+    atomic<bool> closed_;
+    atomic<size_type> waiting_full_;
+    atomic<size_type> waiting_empty_;
+    mutable mutex mtx_;
+    condition_variable not_empty_;
+    condition_variable not_full_;
+
+    /**
+     * Effects: claims the slot for the next push.
+     * Returns: the claimed slot, or 0 if the queue is full or, when \c once is true, if another
+     * producer claimed the slot first. \c st is set accordingly.
+     */
+    inline cell* claim_push_slot(size_type& pos, queue_op_status& st, bool once);
+    inline cell* claim_pull_slot(size_type& pos, queue_op_status& st, bool once);
+
+    inline void commit_push(cell* c, size_type pos)
+    {
+      c->sequence.store(2 * pos + 1, memory_order_release);
+      notify_not_empty_if_needed();
+    }
+    inline void commit_pull(cell* c, size_type pos)
+    {
+      c->sequence.store(2 * (pos + capacity_), memory_order_release);
+      notify_not_full_if_needed();
+    }
+
+    inline bool empty_slot_at_front() const
+    {
+      size_type pos = dequeue_pos_.load(memory_order_relaxed);
+      return buffer_[pos % capacity_].sequence.load(memory_order_acquire) != 2 * pos + 1;
+    }
+    inline bool full_slot_at_back() const
+    {
+      size_type pos = enqueue_pos_.load(memory_order_relaxed);
+      return buffer_[pos % capacity_].sequence.load(memory_order_acquire) != 2 * pos;
+    }
+
+    inline void notify_not_empty_if_needed()
+    {
+      atomic_thread_fence(memory_order_seq_cst);
+      if (waiting_empty_.load(memory_order_relaxed) > 0)
+      {
+        lock_guard<mutex> lk(mtx_);
+        not_empty_.notify_one();
+      }
+    }
+    inline void notify_not_full_if_needed()
+    {
+      atomic_thread_fence(memory_order_seq_cst);
+      if (waiting_full_.load(memory_order_relaxed) > 0)
+      {
+        lock_guard<mutex> lk(mtx_);
+        not_full_.notify_one();
+      }
+    }
+
+    inline void wait_until_not_empty_or_closed();
+    inline void wait_until_not_full_or_closed();
+
+    inline queue_op_status wait_push_slot(cell*& c, size_type& pos);
+  };
+
+  template <typename ValueType>
+  lock_free_bounded_queue<ValueType>::lock_free_bounded_queue(size_type max_elems) :
+    buffer_(new cell[max_elems]), capacity_(max_elems), enqueue_pos_(0), dequeue_pos_(0),
+    closed_(false), waiting_full_(0), waiting_empty_(0)
+  {
+    BOOST_ASSERT_MSG(max_elems >= 1, "number of elements must be >= 1");
+    for (size_type i = 0; i < capacity_; ++i)
+    {
+      buffer_[i].sequence.store(2 * i, memory_order_relaxed);
+    }
+  }
+
+  template <typename ValueType>
+  lock_free_bounded_queue<ValueType>::~lock_free_bounded_queue()
+  {
+    delete[] buffer_;
+  }
+
+  template <typename ValueType>
+  void lock_free_bounded_queue<ValueType>::close()
+  {
+    {
+      lock_guard<mutex> lk(mtx_);
+      closed_.store(true);
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  template <typename ValueType>
+  bool lock_free_bounded_queue<ValueType>::closed() const
+  {
+    return closed_.load();
+  }
+
+  template <typename ValueType>
+  typename lock_free_bounded_queue<ValueType>::size_type lock_free_bounded_queue<ValueType>::size() const
+  {
+    size_type out = dequeue_pos_.load();
+    size_type in = enqueue_pos_.load();
+    if (in <= out) return 0;
+    return in - out > capacity_ ? capacity_ : in - out;
+  }
+
+  template <typename ValueType>
+  bool lock_free_bounded_queue<ValueType>::empty() const
+  {
+    return size() == 0;
+  }
+
+  template <typename ValueType>
+  bool lock_free_bounded_queue<ValueType>::full() const
+  {
+    return size() == capacity_;
+  }
+
+  template <typename ValueType>
+  typename lock_free_bounded_queue<ValueType>::size_type lock_free_bounded_queue<ValueType>::capacity() const
+  {
+    return capacity_;
+  }
+
+  template <typename ValueType>
+  typename lock_free_bounded_queue<ValueType>::cell*
+  lock_free_bounded_queue<ValueType>::claim_push_slot(size_type& pos, queue_op_status& st, bool once)
+  {
+    pos = enqueue_pos_.load(memory_order_relaxed);
+    for (;;)
+    {
+      cell* c = &buffer_[pos % capacity_];
+      size_type seq = c->sequence.load(memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - 2 * pos);
+      if (diff == 0)
+      {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+        {
+          st = queue_op_status::success;
+          return c;
+        }
+      }
+      else if (diff < 0)
+      {
+        st = queue_op_status::full;
+        return 0;
+      }
+      else
+      {
+        pos = enqueue_pos_.load(memory_order_relaxed);
+      }
+      if (once)
+      {
+        st = queue_op_status::busy;
+        return 0;
+      }
+    }
+  }
+
+  template <typename ValueType>
+  typename lock_free_bounded_queue<ValueType>::cell*
+  lock_free_bounded_queue<ValueType>::claim_pull_slot(size_type& pos, queue_op_status& st, bool once)
+  {
+    pos = dequeue_pos_.load(memory_order_relaxed);
+    for (;;)
+    {
+      cell* c = &buffer_[pos % capacity_];
+      size_type seq = c->sequence.load(memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (2 * pos + 1));
+      if (diff == 0)
+      {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+        {
+          st = queue_op_status::success;
+          return c;
+        }
+      }
+      else if (diff < 0)
+      {
+        // the slots pushed before the queue was closed must still be pulled
+        if (closed_.load(memory_order_acquire) && empty_slot_at_front())
+          st = queue_op_status::closed;
+        else
+          st = queue_op_status::empty;
+        return 0;
+      }
+      else
+      {
+        pos = dequeue_pos_.load(memory_order_relaxed);
+      }
+      if (once)
+      {
+        st = queue_op_status::busy;
+        return 0;
+      }
+    }
+  }
+
+  template <typename ValueType>
+  void lock_free_bounded_queue<ValueType>::wait_until_not_empty_or_closed()
+  {
+    unique_lock<mutex> lk(mtx_);
+    ++waiting_empty_;
+    atomic_thread_fence(memory_order_seq_cst);
+    try
+    {
+      while (empty_slot_at_front() && ! closed_.load())
+      {
+        not_empty_.wait(lk);
+      }
+    }
+    catch (...)
+    {
+      --waiting_empty_;
+      throw;
+    }
+    --waiting_empty_;
+  }
+
+  template <typename ValueType>
+  void lock_free_bounded_queue<ValueType>::wait_until_not_full_or_closed()
+  {
+    unique_lock<mutex> lk(mtx_);
+    ++waiting_full_;
+    atomic_thread_fence(memory_order_seq_cst);
+    try
+    {
+      while (full_slot_at_back() && ! closed_.load())
+      {
+        not_full_.wait(lk);
+      }
+    }
+    catch (...)
+    {
+      --waiting_full_;
+      throw;
+    }
+    --waiting_full_;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::try_pull(ValueType& elem)
+  {
+    size_type pos;
+    queue_op_status st;
+    cell* c = claim_pull_slot(pos, st, false);
+    if (c == 0) return st;
+    elem = boost::move(c->data);
+    commit_pull(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::nonblocking_pull(ValueType& elem)
+  {
+    size_type pos;
+    queue_op_status st;
+    cell* c = claim_pull_slot(pos, st, true);
+    if (c == 0) return st;
+    elem = boost::move(c->data);
+    commit_pull(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::wait_pull(ValueType& elem)
+  {
+    for (;;)
+    {
+      queue_op_status st = try_pull(elem);
+      if (st != queue_op_status::empty) return st;
+      wait_until_not_empty_or_closed();
+    }
+  }
+
+  template <typename ValueType>
+  void lock_free_bounded_queue<ValueType>::pull(ValueType& elem)
+  {
+    if (wait_pull(elem) == queue_op_status::closed)
+    {
+      BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+    }
+  }
+
+  // enable if ValueType is nothrow movable
+  template <typename ValueType>
+  ValueType lock_free_bounded_queue<ValueType>::pull()
+  {
+    value_type elem;
+    pull(elem);
+    return boost::move(elem);
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::wait_push_slot(cell*& c, size_type& pos)
+  {
+    for (;;)
+    {
+      if (closed_.load(memory_order_acquire)) return queue_op_status::closed;
+      queue_op_status st;
+      c = claim_push_slot(pos, st, false);
+      if (c != 0) return queue_op_status::success;
+      wait_until_not_full_or_closed();
+    }
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::try_push(const ValueType& elem)
+  {
+    if (closed_.load(memory_order_acquire)) return queue_op_status::closed;
+    // a claimed slot must be committed, so the copy that can throw is done before
+    value_type copy(elem);
+    size_type pos;
+    queue_op_status st;
+    cell* c = claim_push_slot(pos, st, false);
+    if (c == 0) return st;
+    c->data = boost::move(copy);
+    commit_push(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::nonblocking_push(const ValueType& elem)
+  {
+    if (closed_.load(memory_order_acquire)) return queue_op_status::closed;
+    // a claimed slot must be committed, so the copy that can throw is done before
+    value_type copy(elem);
+    size_type pos;
+    queue_op_status st;
+    cell* c = claim_push_slot(pos, st, true);
+    if (c == 0) return st;
+    c->data = boost::move(copy);
+    commit_push(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::wait_push(const ValueType& elem)
+  {
+    value_type copy(elem);
+    size_type pos;
+    cell* c;
+    queue_op_status st = wait_push_slot(c, pos);
+    if (st != queue_op_status::success) return st;
+    c->data = boost::move(copy);
+    commit_push(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  void lock_free_bounded_queue<ValueType>::push(const ValueType& elem)
+  {
+    if (wait_push(elem) == queue_op_status::closed)
+    {
+      BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+    }
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::try_push(BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    if (closed_.load(memory_order_acquire)) return queue_op_status::closed;
+    size_type pos;
+    queue_op_status st;
+    cell* c = claim_push_slot(pos, st, false);
+    if (c == 0) return st;
+    c->data = boost::move(elem);
+    commit_push(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::nonblocking_push(BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    if (closed_.load(memory_order_acquire)) return queue_op_status::closed;
+    size_type pos;
+    queue_op_status st;
+    cell* c = claim_push_slot(pos, st, true);
+    if (c == 0) return st;
+    c->data = boost::move(elem);
+    commit_push(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  queue_op_status lock_free_bounded_queue<ValueType>::wait_push(BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    size_type pos;
+    cell* c;
+    queue_op_status st = wait_push_slot(c, pos);
+    if (st != queue_op_status::success) return st;
+    c->data = boost::move(elem);
+    commit_push(c, pos);
+    return queue_op_status::success;
+  }
+
+  template <typename ValueType>
+  void lock_free_bounded_queue<ValueType>::push(BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    if (wait_push(boost::move(elem)) == queue_op_status::closed)
+    {
+      BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+    }
+  }
+
+  template <typename ValueType>
+  lock_free_bounded_queue<ValueType>& operator<<(lock_free_bounded_queue<ValueType>& sbq, BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    sbq.push(boost::move(elem));
+    return sbq;
+  }
+
+  template <typename ValueType>
+  lock_free_bounded_queue<ValueType>& operator<<(lock_free_bounded_queue<ValueType>& sbq, ValueType const&elem)
+  {
+    sbq.push(elem);
+    return sbq;
+  }
+
+  template <typename ValueType>
+  lock_free_bounded_queue<ValueType>& operator>>(lock_free_bounded_queue<ValueType>& sbq, ValueType &elem)
+  {
+    sbq.pull(elem);
+    return sbq;
+  }
+}
+using concurrent::lock_free_bounded_queue;
+
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
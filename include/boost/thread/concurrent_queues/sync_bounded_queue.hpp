@@ -87,6 +87,18 @@ namespace concurrent
 
     inline queue_op_status wait_pull_front(ValueType& elem);
 
+    // Batch Modifiers
+    template <typename InputIterator>
+    inline void push_back_range(InputIterator first, InputIterator last);
+    template <typename InputIterator>
+    inline void push_back_n(InputIterator first, size_type n);
+
+    // Batch Observers/Modifiers
+    template <typename OutputIterator>
+    inline size_type pull_front_up_to(size_type n, OutputIterator out);
+    template <typename OutputIterator>
+    inline size_type wait_pull_front_some(size_type n, OutputIterator out);
+
   private:
     mutable mutex mtx_;
     condition_variable not_empty_;
@@ -172,6 +184,36 @@ namespace concurrent
       }
     }
 
+    /**
+     * Notifies the n elements added (removed) with a single notification.
+     */
+    inline void notify_not_empty_if_needed(unique_lock<mutex>& lk, size_type n)
+    {
+      if (n == 1)
+      {
+        notify_not_empty_if_needed(lk);
+      }
+      else if (n > 1 && waiting_empty_ > 0)
+      {
+        waiting_empty_ = 0;
+        lk.unlock();
+        not_empty_.notify_all();
+      }
+    }
+    inline void notify_not_full_if_needed(unique_lock<mutex>& lk, size_type n)
+    {
+      if (n == 1)
+      {
+        notify_not_full_if_needed(lk);
+      }
+      else if (n > 1 && waiting_full_ > 0)
+      {
+        waiting_full_ = 0;
+        lk.unlock();
+        not_full_.notify_all();
+      }
+    }
+
 #ifndef BOOST_THREAD_QUEUE_DEPRECATE_OLD
     inline void pull(value_type& elem, unique_lock<mutex>& lk)
     {
@@ -208,6 +250,28 @@ namespace concurrent
       return boost::move(elem);
     }
 
+    template <typename OutputIterator>
+    inline size_type pull_front_up_to(size_type n, OutputIterator& out, unique_lock<mutex>& lk)
+    {
+      size_type pulled = 0;
+      try
+      {
+        for (; pulled < n && out_ != in_; ++pulled)
+        {
+          *out = boost::move(data_[out_]);
+          ++out;
+          out_ = inc(out_);
+        }
+      }
+      catch (...)
+      {
+        notify_not_full_if_needed(lk, pulled);
+        throw;
+      }
+      notify_not_full_if_needed(lk, pulled);
+      return pulled;
+    }
+
     inline void set_in(size_type in, unique_lock<mutex>& lk)
     {
       in_ = in;
@@ -697,6 +761,91 @@ namespace concurrent
       push_at(boost::move(elem), wait_until_not_full(lk), lk);
   }
 
+  template <typename ValueType>
+  template <typename InputIterator>
+  void sync_bounded_queue<ValueType>::push_back_range(InputIterator first, InputIterator last)
+  {
+    unique_lock<mutex> lk(mtx_);
+    while (first != last)
+    {
+      // the lock has been released by the notification of the previous chunk
+      if (! lk.owns_lock()) lk.lock();
+      size_type in_p_1 = wait_until_not_full(lk);
+      size_type pushed = 0;
+      try
+      {
+        do
+        {
+          data_[in_] = *first;
+          in_ = in_p_1;
+          ++pushed;
+          ++first;
+          in_p_1 = inc(in_);
+        } while (first != last && in_p_1 != out_);
+      }
+      catch (...)
+      {
+        notify_not_empty_if_needed(lk, pushed);
+        throw;
+      }
+      notify_not_empty_if_needed(lk, pushed);
+    }
+  }
+
+  template <typename ValueType>
+  template <typename InputIterator>
+  void sync_bounded_queue<ValueType>::push_back_n(InputIterator first, size_type n)
+  {
+    unique_lock<mutex> lk(mtx_);
+    while (n > 0)
+    {
+      // the lock has been released by the notification of the previous chunk
+      if (! lk.owns_lock()) lk.lock();
+      size_type in_p_1 = wait_until_not_full(lk);
+      size_type pushed = 0;
+      try
+      {
+        do
+        {
+          data_[in_] = *first;
+          in_ = in_p_1;
+          ++pushed;
+          --n;
+          ++first;
+          in_p_1 = inc(in_);
+        } while (n > 0 && in_p_1 != out_);
+      }
+      catch (...)
+      {
+        notify_not_empty_if_needed(lk, pushed);
+        throw;
+      }
+      notify_not_empty_if_needed(lk, pushed);
+    }
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_bounded_queue<ValueType>::size_type
+  sync_bounded_queue<ValueType>::pull_front_up_to(size_type n, OutputIterator out)
+  {
+    unique_lock<mutex> lk(mtx_);
+    return pull_front_up_to(n, out, lk);
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_bounded_queue<ValueType>::size_type
+  sync_bounded_queue<ValueType>::wait_pull_front_some(size_type n, OutputIterator out)
+  {
+    BOOST_ASSERT(n > 0);
+    unique_lock<mutex> lk(mtx_);
+    bool is_closed = false;
+    wait_until_not_empty(lk, is_closed);
+    if (is_closed) return 0;
+    return pull_front_up_to(n, out, lk);
+  }
+
   template <typename ValueType>
   sync_bounded_queue<ValueType>& operator<<(sync_bounded_queue<ValueType>& sbq, BOOST_THREAD_RV_REF(ValueType) elem)
   {
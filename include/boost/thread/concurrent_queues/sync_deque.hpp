@@ -68,6 +68,18 @@ namespace concurrent
     inline queue_op_status nonblocking_pull_front(value_type&);
     inline queue_op_status wait_pull_front(ValueType& elem);
 
+    // Batch Modifiers
+    template <class InputIterator>
+    inline void push_back_range(InputIterator first, InputIterator last);
+    template <class InputIterator>
+    inline void push_back_n(InputIterator first, size_type n);
+
+    // Batch Observers/Modifiers
+    template <class OutputIterator>
+    inline size_type pull_front_up_to(size_type n, OutputIterator out);
+    template <class OutputIterator>
+    inline size_type wait_pull_front_some(size_type n, OutputIterator out);
+
   private:
 
     inline queue_op_status try_pull_front(value_type& x, unique_lock<mutex>& lk);
@@ -89,6 +101,19 @@ namespace concurrent
       return boost::move(e);
     }
 
+    template <class OutputIterator>
+    inline size_type pull_front_up_to(size_type n, OutputIterator& out, unique_lock<mutex>& )
+    {
+      size_type pulled = 0;
+      for (; pulled < n && ! super::data_.empty(); ++pulled)
+      {
+        *out = boost::move(super::data_.front());
+        ++out;
+        super::data_.pop_front();
+      }
+      return pulled;
+    }
+
     inline void push_back(const value_type& elem, unique_lock<mutex>& lk)
     {
       super::data_.push_back(elem);
@@ -294,6 +319,71 @@ namespace concurrent
       push_back(boost::move(elem), lk);
   }
 
+  template <class ValueType, class Container>
+  template <class InputIterator>
+  void sync_deque<ValueType, Container>::push_back_range(InputIterator first, InputIterator last)
+  {
+      unique_lock<mutex> lk(super::mtx_);
+      super::throw_if_closed(lk);
+      size_type pushed = 0;
+      try
+      {
+        for (; first != last; ++first, ++pushed)
+        {
+          super::data_.push_back(*first);
+        }
+      }
+      catch (...)
+      {
+        super::notify_elems_added(lk, pushed);
+        throw;
+      }
+      super::notify_elems_added(lk, pushed);
+  }
+
+  template <class ValueType, class Container>
+  template <class InputIterator>
+  void sync_deque<ValueType, Container>::push_back_n(InputIterator first, size_type n)
+  {
+      unique_lock<mutex> lk(super::mtx_);
+      super::throw_if_closed(lk);
+      size_type pushed = 0;
+      try
+      {
+        for (; pushed < n; ++first, ++pushed)
+        {
+          super::data_.push_back(*first);
+        }
+      }
+      catch (...)
+      {
+        super::notify_elems_added(lk, pushed);
+        throw;
+      }
+      super::notify_elems_added(lk, pushed);
+  }
+
+  template <class ValueType, class Container>
+  template <class OutputIterator>
+  typename sync_deque<ValueType, Container>::size_type
+  sync_deque<ValueType, Container>::pull_front_up_to(size_type n, OutputIterator out)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    return pull_front_up_to(n, out, lk);
+  }
+
+  template <class ValueType, class Container>
+  template <class OutputIterator>
+  typename sync_deque<ValueType, Container>::size_type
+  sync_deque<ValueType, Container>::wait_pull_front_some(size_type n, OutputIterator out)
+  {
+    BOOST_ASSERT(n > 0);
+    unique_lock<mutex> lk(super::mtx_);
+    const bool has_been_closed = super::wait_until_not_empty_or_closed(lk);
+    if (has_been_closed) return 0;
+    return pull_front_up_to(n, out, lk);
+  }
+
   template <class ValueType, class Container>
   sync_deque<ValueType, Container>& operator<<(sync_deque<ValueType, Container>& sbq, BOOST_THREAD_RV_REF(ValueType) elem)
   {
@@ -139,6 +139,16 @@ namespace concurrent
     queue_op_status wait_pull(ValueType& elem);
     queue_op_status nonblocking_pull(ValueType&);
 
+    template <class InputIterator>
+    void push_range(InputIterator first, InputIterator last);
+    template <class InputIterator>
+    void push_n(InputIterator first, size_type n);
+
+    template <class OutputIterator>
+    size_type pull_up_to(size_type n, OutputIterator out);
+    template <class OutputIterator>
+    size_type wait_pull_some(size_type n, OutputIterator out);
+
   private:
     void push(unique_lock<mutex>&, const ValueType& elem);
     void push(lock_guard<mutex>&, const ValueType& elem);
@@ -161,6 +171,9 @@ namespace concurrent
 
     queue_op_status nonblocking_pull(unique_lock<mutex>& lk, ValueType&);
 
+    template <class OutputIterator>
+    size_type pull_up_to(unique_lock<mutex>& lk, size_type n, OutputIterator& out);
+
     sync_priority_queue(const sync_priority_queue&);
     sync_priority_queue& operator= (const sync_priority_queue&);
     sync_priority_queue(BOOST_THREAD_RV_REF(sync_priority_queue));
@@ -358,6 +371,86 @@ namespace concurrent
   }
 
 
+  //////////////////////
+  template <class T, class Container,class Cmp>
+  template <class InputIterator>
+  void sync_priority_queue<T,Container,Cmp>::push_range(InputIterator first, InputIterator last)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    super::throw_if_closed(lk);
+    size_type pushed = 0;
+    try
+    {
+      for (; first != last; ++first, ++pushed)
+      {
+        super::data_.push(*first);
+      }
+    }
+    catch (...)
+    {
+      super::notify_elems_added(lk, pushed);
+      throw;
+    }
+    super::notify_elems_added(lk, pushed);
+  }
+
+  template <class T, class Container,class Cmp>
+  template <class InputIterator>
+  void sync_priority_queue<T,Container,Cmp>::push_n(InputIterator first, size_type n)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    super::throw_if_closed(lk);
+    size_type pushed = 0;
+    try
+    {
+      for (; pushed < n; ++first, ++pushed)
+      {
+        super::data_.push(*first);
+      }
+    }
+    catch (...)
+    {
+      super::notify_elems_added(lk, pushed);
+      throw;
+    }
+    super::notify_elems_added(lk, pushed);
+  }
+
+  //////////////////////
+  template <class T, class Container,class Cmp>
+  template <class OutputIterator>
+  typename sync_priority_queue<T,Container,Cmp>::size_type
+  sync_priority_queue<T,Container,Cmp>::pull_up_to(unique_lock<mutex>&, size_type n, OutputIterator& out)
+  {
+    size_type pulled = 0;
+    for (; pulled < n && ! super::data_.empty(); ++pulled)
+    {
+      *out = super::data_.pull();
+      ++out;
+    }
+    return pulled;
+  }
+
+  template <class T, class Container,class Cmp>
+  template <class OutputIterator>
+  typename sync_priority_queue<T,Container,Cmp>::size_type
+  sync_priority_queue<T,Container,Cmp>::pull_up_to(size_type n, OutputIterator out)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    return pull_up_to(lk, n, out);
+  }
+
+  template <class T, class Container,class Cmp>
+  template <class OutputIterator>
+  typename sync_priority_queue<T,Container,Cmp>::size_type
+  sync_priority_queue<T,Container,Cmp>::wait_pull_some(size_type n, OutputIterator out)
+  {
+    BOOST_ASSERT(n > 0);
+    unique_lock<mutex> lk(super::mtx_);
+    const bool has_been_closed = super::wait_until_not_empty_or_closed(lk);
+    if (has_been_closed) return 0;
+    return pull_up_to(lk, n, out);
+  }
 
 } //end concurrent namespace
 
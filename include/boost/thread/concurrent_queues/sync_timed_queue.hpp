@@ -11,12 +11,18 @@
 #include <boost/thread/detail/config.hpp>
 
 #include <boost/thread/concurrent_queues/sync_priority_queue.hpp>
+#include <boost/thread/concurrent_queues/detail/sync_queue_base.hpp>
+#include <boost/thread/concurrent_queues/detail/timer_node_pool.hpp>
+#include <boost/thread/concurrent_queues/timer_handle.hpp>
+#include <boost/thread/csbl/vector.hpp>
 #include <boost/chrono/duration.hpp>
 #include <boost/chrono/time_point.hpp>
 #include <boost/chrono/system_clocks.hpp>
 #include <boost/chrono/chrono_io.hpp>
+#include <boost/type_traits/is_nothrow_move_constructible.hpp>
 
-#include <algorithm> // std::min
+#include <algorithm> // std::min, std::push_heap, std::pop_heap, std::make_heap, std::remove_if
+#include <cstddef>
 
 #include <boost/config/abi_prefix.hpp>
 
@@ -48,7 +54,9 @@ namespace detail
       return *this;
     }
 
-    scheduled_type(BOOST_THREAD_RV_REF(scheduled_type) other) : data(boost::move(other.data)), time(other.time) {}
+    // noexcept when T is, so that the underlying vector moves the elements instead of copying them
+    scheduled_type(BOOST_THREAD_RV_REF(scheduled_type) other) BOOST_NOEXCEPT_IF(is_nothrow_move_constructible<T>::value)
+      : data(boost::move(other.data)), time(other.time) {}
     scheduled_type& operator=(BOOST_THREAD_RV_REF(scheduled_type) other) {
       data = boost::move(other.data);
       time = other.time;
@@ -61,6 +69,154 @@ namespace detail
     }
   }; //end struct
 
+  /**
+   * Heap of the time points of the elements, the elements themselves being stored in recycled nodes so
+   * that cancelling an element destroys it at once.
+   *
+   * The entry of a cancelled element stays in the heap until it reaches the top, or until the
+   * cancelled entries are half of the heap, which removes them all.
+   */
+  template <class T, class TimePoint>
+  class timer_heap
+  {
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef timer_node<T> node;
+
+  private:
+    struct entry
+    {
+      TimePoint time;
+      node* n;
+      std::size_t generation;
+
+      entry(TimePoint const& tp, node* pn) : time(tp), n(pn), generation(pn->generation) {}
+
+      bool operator <(const entry & other) const
+      {
+        return this->time > other.time;
+      }
+      bool cancelled() const
+      {
+        return ! timer_node_pool<node>::alive(n, generation);
+      }
+    };
+    struct is_cancelled
+    {
+      bool operator()(entry const& e) const { return e.cancelled(); }
+    };
+
+    // below this number the cancelled entries are only removed when they reach the top
+    static const size_type min_compaction = 64;
+
+    timer_node_pool<node> pool_;
+    csbl::vector<entry> heap_;
+    size_type cancelled_;
+
+    BOOST_THREAD_NO_COPYABLE(timer_heap)
+
+  public:
+    timer_heap() : cancelled_(0) {}
+
+    bool empty() const BOOST_NOEXCEPT
+    { return heap_.size() == cancelled_; }
+
+    size_type size() const BOOST_NOEXCEPT
+    { return heap_.size() - cancelled_; }
+
+    template <class U>
+    node* insert(BOOST_THREAD_FWD_REF(U) elem, TimePoint const& tp)
+    {
+      node* n = pool_.create(boost::forward<U>(elem));
+      try
+      {
+        heap_.push_back(entry(tp, n));
+      }
+      catch (...)
+      {
+        pool_.destroy(n);
+        throw;
+      }
+      std::push_heap(heap_.begin(), heap_.end());
+      return n;
+    }
+
+    /**
+     * \b Requires: ! empty()
+     */
+    TimePoint const& top_time()
+    {
+      drop_cancelled_top();
+      return heap_.front().time;
+    }
+
+    /**
+     * \b Requires: ! empty()
+     */
+    void pull(T& elem)
+    {
+      node* n = pop();
+      elem = boost::move(n->value());
+      pool_.destroy(n);
+    }
+
+    /**
+     * \b Requires: ! empty()
+     */
+    T pull()
+    {
+      node* n = pop();
+      T elem(boost::move(n->value()));
+      pool_.destroy(n);
+      return boost::move(elem);
+    }
+
+    /**
+     * Destroys the element of the node if the node has not been released since it had the given generation.
+     */
+    bool cancel(node* n, std::size_t generation)
+    {
+      if (! timer_node_pool<node>::alive(n, generation)) return false;
+      pool_.destroy(n);
+      ++cancelled_;
+      if (cancelled_ > min_compaction && cancelled_ >= heap_.size() / 2) compact();
+      return true;
+    }
+
+  private:
+    void drop_cancelled_top()
+    {
+      while (heap_.front().cancelled())
+      {
+        std::pop_heap(heap_.begin(), heap_.end());
+        heap_.pop_back();
+        --cancelled_;
+      }
+    }
+
+    node* pop()
+    {
+      drop_cancelled_top();
+      node* n = heap_.front().n;
+      std::pop_heap(heap_.begin(), heap_.end());
+      heap_.pop_back();
+      return n;
+    }
+
+    void compact()
+    {
+      heap_.erase(std::remove_if(heap_.begin(), heap_.end(), is_cancelled()), heap_.end());
+      std::make_heap(heap_.begin(), heap_.end());
+      cancelled_ = 0;
+      if (heap_.capacity() > 4 * heap_.size())
+      {
+        // gives back the storage of the cancelled entries
+        csbl::vector<entry>(heap_).swap(heap_);
+      }
+    }
+  };
+
   template <class Duration>
   chrono::time_point<chrono::steady_clock,Duration>
   limit_timepoint(chrono::time_point<chrono::steady_clock,Duration> const& tp)
@@ -102,12 +258,18 @@ namespace detail
 
 } //end detail namespace
 
+  /**
+   * Queue of elements ready to be pulled once their time point has been reached.
+   *
+   * Pushing an element is logarithmic. The returned timer_handle cancels it in constant time.
+   */
   template <class T, class Clock = chrono::steady_clock, class TimePoint=typename Clock::time_point>
   class sync_timed_queue
-    : private sync_priority_queue<detail::scheduled_type<T, Clock, TimePoint> >
+    : private concurrent::detail::sync_queue_base<T, concurrent::detail::timer_heap<T, TimePoint> >
   {
-    typedef detail::scheduled_type<T, Clock, TimePoint> stype;
-    typedef sync_priority_queue<stype> super;
+    typedef concurrent::detail::timer_heap<T, TimePoint> heap_type;
+    typedef concurrent::detail::sync_queue_base<T, heap_type> super;
+    typedef typename heap_type::node node;
   public:
     typedef T value_type;
     typedef Clock clock;
@@ -118,7 +280,13 @@ namespace detail
     typedef typename super::op_status op_status;
 
     sync_timed_queue() : super() {};
-    ~sync_timed_queue() {}
+    ~sync_timed_queue()
+    {
+      if (! super::closed())
+      {
+        super::close();
+      }
+    }
 
     using super::size;
     using super::empty;
@@ -139,14 +307,14 @@ namespace detail
     queue_op_status nonblocking_pull(T& elem);
 
     template <class Duration>
-    void push(const T& elem, chrono::time_point<clock,Duration> const& tp);
+    timer_handle push(const T& elem, chrono::time_point<clock,Duration> const& tp);
     template <class Rep, class Period>
-    void push(const T& elem, chrono::duration<Rep,Period> const& dura);
+    timer_handle push(const T& elem, chrono::duration<Rep,Period> const& dura);
 
     template <class Duration>
-    void push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp);
+    timer_handle push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp);
     template <class Rep, class Period>
-    void push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura);
+    timer_handle push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura);
 
     template <class Duration>
     queue_op_status try_push(const T& elem, chrono::time_point<clock,Duration> const& tp);
@@ -159,14 +327,19 @@ namespace detail
     queue_op_status try_push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura);
 
   private:
-    inline bool not_empty_and_time_reached(unique_lock<mutex>& lk) const;
-    inline bool not_empty_and_time_reached(lock_guard<mutex>& lk) const;
+    inline bool not_empty_and_time_reached(unique_lock<mutex>& lk);
+    inline bool not_empty_and_time_reached(lock_guard<mutex>& lk);
 
     bool wait_to_pull(unique_lock<mutex>&);
     queue_op_status wait_to_pull_until(unique_lock<mutex>&, TimePoint const& tp);
     template <class Rep, class Period>
     queue_op_status wait_to_pull_for(unique_lock<mutex>& lk, chrono::duration<Rep,Period> const& dura);
 
+    template <class U>
+    timer_handle push(lock_guard<mutex>& lk, BOOST_THREAD_FWD_REF(U) elem, TimePoint const& tp);
+
+    static bool cancel(void* queue, void* entry, std::size_t generation);
+
     T pull(unique_lock<mutex>&);
     T pull(lock_guard<mutex>&);
 
@@ -178,6 +351,8 @@ namespace detail
 
     queue_op_status wait_pull(unique_lock<mutex>& lk, T& elem);
 
+    inline queue_op_status timeout_or_not_ready(unique_lock<mutex>& lk);
+
     sync_timed_queue(const sync_timed_queue&);
     sync_timed_queue& operator=(const sync_timed_queue&);
     sync_timed_queue(BOOST_THREAD_RV_REF(sync_timed_queue));
@@ -185,32 +360,52 @@ namespace detail
   }; //end class
 
 
+  template <class T, class Clock, class TimePoint>
+  template <class U>
+  timer_handle sync_timed_queue<T, Clock, TimePoint>::push(lock_guard<mutex>& lk, BOOST_THREAD_FWD_REF(U) elem, TimePoint const& tp)
+  {
+    super::throw_if_closed(lk);
+    node* n = super::data_.insert(boost::forward<U>(elem), tp);
+    super::notify_elem_added(lk);
+    return timer_handle(&sync_timed_queue::cancel, this, n, n->generation);
+  }
+
+  template <class T, class Clock, class TimePoint>
+  bool sync_timed_queue<T, Clock, TimePoint>::cancel(void* queue, void* entry, std::size_t generation)
+  {
+    sync_timed_queue* self = static_cast<sync_timed_queue*>(queue);
+    lock_guard<mutex> lk(self->mtx_);
+    return self->data_.cancel(static_cast<node*>(entry), generation);
+  }
+
   template <class T, class Clock, class TimePoint>
   template <class Duration>
-  void sync_timed_queue<T, Clock, TimePoint>::push(const T& elem, chrono::time_point<clock,Duration> const& tp)
+  timer_handle sync_timed_queue<T, Clock, TimePoint>::push(const T& elem, chrono::time_point<clock,Duration> const& tp)
   {
-    super::push(stype(elem,tp));
+    lock_guard<mutex> lk(super::mtx_);
+    return push(lk, elem, tp);
   }
 
   template <class T, class Clock, class TimePoint>
   template <class Rep, class Period>
-  void sync_timed_queue<T, Clock, TimePoint>::push(const T& elem, chrono::duration<Rep,Period> const& dura)
+  timer_handle sync_timed_queue<T, Clock, TimePoint>::push(const T& elem, chrono::duration<Rep,Period> const& dura)
   {
-    push(elem, clock::now() + dura);
+    return push(elem, clock::now() + dura);
   }
 
   template <class T, class Clock, class TimePoint>
   template <class Duration>
-  void sync_timed_queue<T, Clock, TimePoint>::push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp)
+  timer_handle sync_timed_queue<T, Clock, TimePoint>::push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp)
   {
-    super::push(stype(boost::move(elem),tp));
+    lock_guard<mutex> lk(super::mtx_);
+    return push(lk, boost::move(elem), tp);
   }
 
   template <class T, class Clock, class TimePoint>
   template <class Rep, class Period>
-  void sync_timed_queue<T, Clock, TimePoint>::push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura)
+  timer_handle sync_timed_queue<T, Clock, TimePoint>::push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura)
   {
-    push(boost::move(elem), clock::now() + dura);
+    return push(boost::move(elem), clock::now() + dura);
   }
 
 
@@ -219,7 +414,10 @@ namespace detail
   template <class Duration>
   queue_op_status sync_timed_queue<T, Clock, TimePoint>::try_push(const T& elem, chrono::time_point<clock,Duration> const& tp)
   {
-    return super::try_push(stype(elem,tp));
+    lock_guard<mutex> lk(super::mtx_);
+    if (super::closed(lk)) return queue_op_status::closed;
+    push(lk, elem, tp);
+    return queue_op_status::success;
   }
 
   template <class T, class Clock, class TimePoint>
@@ -233,7 +431,10 @@ namespace detail
   template <class Duration>
   queue_op_status sync_timed_queue<T, Clock, TimePoint>::try_push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp)
   {
-    return super::try_push(stype(boost::move(elem), tp));
+    lock_guard<mutex> lk(super::mtx_);
+    if (super::closed(lk)) return queue_op_status::closed;
+    push(lk, boost::move(elem), tp);
+    return queue_op_status::success;
   }
 
   template <class T, class Clock, class TimePoint>
@@ -245,15 +446,25 @@ namespace detail
 
   ///////////////////////////
   template <class T, class Clock, class TimePoint>
-  bool sync_timed_queue<T, Clock, TimePoint>::not_empty_and_time_reached(unique_lock<mutex>& lk) const
+  bool sync_timed_queue<T, Clock, TimePoint>::not_empty_and_time_reached(unique_lock<mutex>& lk)
   {
-    return ! super::empty(lk) && clock::now() >= super::data_.top().time;
+    return ! super::empty(lk) && clock::now() >= super::data_.top_time();
   }
 
   template <class T, class Clock, class TimePoint>
-  bool sync_timed_queue<T, Clock, TimePoint>::not_empty_and_time_reached(lock_guard<mutex>& lk) const
+  bool sync_timed_queue<T, Clock, TimePoint>::not_empty_and_time_reached(lock_guard<mutex>& lk)
   {
-    return ! super::empty(lk) && clock::now() >= super::data_.top().time;
+    return ! super::empty(lk) && clock::now() >= super::data_.top_time();
+  }
+
+  ///////////////////////////
+  template <class T, class Clock, class TimePoint>
+  queue_op_status sync_timed_queue<T, Clock, TimePoint>::timeout_or_not_ready(unique_lock<mutex>& lk)
+  {
+    if (super::empty(lk)) return queue_op_status::timeout;
+    // this consumer could have consumed the notification of an element another consumer is waiting for
+    super::notify_not_empty_if_needed(lk);
+    return queue_op_status::not_ready;
   }
 
   ///////////////////////////
@@ -270,8 +481,8 @@ namespace detail
       if (not_empty_and_time_reached(lk)) return false; // success
       if (super::closed(lk)) return true; // closed
 
-      const time_point tpmin(detail::limit_timepoint(super::data_.top().time));
-      super::cond_.wait_until(lk, tpmin);
+      const time_point tpmin(detail::limit_timepoint(super::data_.top_time()));
+      super::wait_elem_until(lk, tpmin);
     }
   }
 
@@ -282,16 +493,16 @@ namespace detail
     {
       if (not_empty_and_time_reached(lk)) return queue_op_status::success;
       if (super::closed(lk)) return queue_op_status::closed;
-      if (clock::now() >= tp) return super::empty(lk) ? queue_op_status::timeout : queue_op_status::not_ready;
+      if (clock::now() >= tp) return timeout_or_not_ready(lk);
 
       super::wait_until_not_empty_or_closed_until(lk, tp);
 
       if (not_empty_and_time_reached(lk)) return queue_op_status::success;
       if (super::closed(lk)) return queue_op_status::closed;
-      if (clock::now() >= tp) return super::empty(lk) ? queue_op_status::timeout : queue_op_status::not_ready;
+      if (clock::now() >= tp) return timeout_or_not_ready(lk);
 
-      const time_point tpmin((std::min)(tp, detail::limit_timepoint(super::data_.top().time)));
-      super::cond_.wait_until(lk, tpmin);
+      const time_point tpmin((std::min)(tp, detail::limit_timepoint(super::data_.top_time())));
+      super::wait_elem_until(lk, tpmin);
     }
   }
 
@@ -304,16 +515,16 @@ namespace detail
     {
       if (not_empty_and_time_reached(lk)) return queue_op_status::success;
       if (super::closed(lk)) return queue_op_status::closed;
-      if (chrono::steady_clock::now() >= tp) return super::empty(lk) ? queue_op_status::timeout : queue_op_status::not_ready;
+      if (chrono::steady_clock::now() >= tp) return timeout_or_not_ready(lk);
 
       super::wait_until_not_empty_or_closed_until(lk, tp);
 
       if (not_empty_and_time_reached(lk)) return queue_op_status::success;
       if (super::closed(lk)) return queue_op_status::closed;
-      if (chrono::steady_clock::now() >= tp) return super::empty(lk) ? queue_op_status::timeout : queue_op_status::not_ready;
+      if (chrono::steady_clock::now() >= tp) return timeout_or_not_ready(lk);
 
-      const chrono::steady_clock::time_point tpmin((std::min)(tp, detail::convert_to_steady_clock_timepoint(super::data_.top().time)));
-      super::cond_.wait_until(lk, tpmin);
+      const chrono::steady_clock::time_point tpmin((std::min)(tp, detail::convert_to_steady_clock_timepoint(super::data_.top_time())));
+      super::wait_elem_until(lk, tpmin);
     }
   }
 
@@ -321,21 +532,13 @@ namespace detail
   template <class T, class Clock, class TimePoint>
   T sync_timed_queue<T, Clock, TimePoint>::pull(unique_lock<mutex>&)
   {
-#if ! defined  BOOST_NO_CXX11_RVALUE_REFERENCES
-    return boost::move(super::data_.pull().data);
-#else
-    return super::data_.pull().data;
-#endif
+    return super::data_.pull();
   }
 
   template <class T, class Clock, class TimePoint>
   T sync_timed_queue<T, Clock, TimePoint>::pull(lock_guard<mutex>&)
   {
-#if ! defined  BOOST_NO_CXX11_RVALUE_REFERENCES
-    return boost::move(super::data_.pull().data);
-#else
-    return super::data_.pull().data;
-#endif
+    return super::data_.pull();
   }
   template <class T, class Clock, class TimePoint>
   T sync_timed_queue<T, Clock, TimePoint>::pull()
@@ -350,21 +553,13 @@ namespace detail
   template <class T, class Clock, class TimePoint>
   void sync_timed_queue<T, Clock, TimePoint>::pull(unique_lock<mutex>&, T& elem)
   {
-#if ! defined  BOOST_NO_CXX11_RVALUE_REFERENCES
-    elem = boost::move(super::data_.pull().data);
-#else
-    elem = super::data_.pull().data;
-#endif
+    super::data_.pull(elem);
   }
 
   template <class T, class Clock, class TimePoint>
   void sync_timed_queue<T, Clock, TimePoint>::pull(lock_guard<mutex>&, T& elem)
   {
-#if ! defined  BOOST_NO_CXX11_RVALUE_REFERENCES
-    elem = boost::move(super::data_.pull().data);
-#else
-    elem = super::data_.pull().data;
-#endif
+    super::data_.pull(elem);
   }
 
   template <class T, class Clock, class TimePoint>
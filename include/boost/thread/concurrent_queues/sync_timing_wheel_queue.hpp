@@ -0,0 +1,784 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_THREAD_SYNC_TIMING_WHEEL_QUEUE_HPP
+#define BOOST_THREAD_SYNC_TIMING_WHEEL_QUEUE_HPP
+
+#include <boost/thread/detail/config.hpp>
+
+#include <boost/thread/concurrent_queues/detail/sync_queue_base.hpp>
+#include <boost/thread/concurrent_queues/detail/timer_node_pool.hpp>
+#include <boost/thread/concurrent_queues/queue_op_status.hpp>
+#include <boost/thread/concurrent_queues/sync_timed_queue.hpp>
+#include <boost/thread/concurrent_queues/timer_handle.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/chrono/duration.hpp>
+#include <boost/chrono/time_point.hpp>
+#include <boost/chrono/system_clocks.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <algorithm> // std::min, std::max
+#include <cstddef>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace concurrent
+{
+namespace detail
+{
+
+  /**
+   * Hierarchical timing wheel.
+   *
+   * The time is divided in ticks of a fixed resolution. The wheel has 4 levels of 256 slots; a slot of
+   * the first level holds the elements expiring at a given tick and a slot of the level n the elements
+   * expiring in a range of 256^n ticks, which are cascaded to the lower levels when the wheel reaches
+   * the range. Insertion and removal are constant time, an element being cascaded at most 3 times.
+   *
+   * The elements are never reported before their time point, but can be up to a tick late. The order of
+   * the elements expiring at the same tick is unspecified.
+   */
+  template <class T, class Clock>
+  class timing_wheel
+  {
+  public:
+    typedef T value_type;
+    typedef Clock clock;
+    typedef typename clock::duration duration;
+    typedef typename clock::time_point time_point;
+    typedef std::size_t size_type;
+
+    struct node
+    {
+      typedef T value_type;
+
+      node* next;
+      std::size_t generation;
+      unsigned slot;
+      typename aligned_storage<sizeof(T), alignment_of<T>::value>::type storage;
+      node* prev;
+      boost::uint64_t tick;
+
+      T& value() BOOST_NOEXCEPT
+      { return *static_cast<T*>(static_cast<void*>(&storage)); }
+    };
+
+  private:
+    static const unsigned slot_bits = 8;
+    static const unsigned slots = 1u << slot_bits;
+    static const unsigned levels = 4;
+    static const unsigned ready_slot = levels * slots;
+
+    timer_node_pool<node> pool_;
+    node* slots_[levels * slots];
+    boost::uint64_t occupied_[levels][slots / 64];
+    // expired elements, in expiration order
+    node* ready_head_;
+    node* ready_tail_;
+    size_type size_;
+    // number of elements not expired yet
+    size_type wheel_size_;
+    time_point start_;
+    duration resolution_;
+    // first tick not processed yet
+    boost::uint64_t next_tick_;
+
+    BOOST_THREAD_NO_COPYABLE(timing_wheel)
+
+  public:
+    timing_wheel()
+      : ready_head_(0), ready_tail_(0), size_(0), wheel_size_(0),
+        start_(clock::now()), resolution_(chrono::duration_cast<duration>(chrono::milliseconds(1))),
+        next_tick_(0)
+    {
+      std::fill(slots_, slots_ + levels * slots, static_cast<node*>(0));
+      for (unsigned level = 0; level < levels; ++level)
+      {
+        std::fill(occupied_[level], occupied_[level] + slots / 64, boost::uint64_t(0));
+      }
+    }
+
+    bool empty() const BOOST_NOEXCEPT
+    { return size_ == 0; }
+
+    size_type size() const BOOST_NOEXCEPT
+    { return size_; }
+
+    /**
+     * Sets the duration of a tick.
+     *
+     * \b Requires: the wheel is empty.
+     */
+    void resolution(duration const& res)
+    {
+      BOOST_ASSERT(empty());
+      BOOST_ASSERT(res > duration::zero());
+      resolution_ = res;
+    }
+
+    duration resolution() const
+    { return resolution_; }
+
+    template <class U>
+    node* insert(BOOST_THREAD_FWD_REF(U) elem, time_point const& tp)
+    {
+      node* n = pool_.create(boost::forward<U>(elem));
+      n->tick = tick_of(tp);
+      ++size_;
+      if (n->tick < next_tick_)
+      {
+        // the time point has already been reached
+        link_ready(n);
+      }
+      else
+      {
+        ++wheel_size_;
+        add(n);
+      }
+      return n;
+    }
+
+    /**
+     * Moves the elements whose time point has been reached to the ready list.
+     */
+    void advance(time_point const& now)
+    {
+      const boost::uint64_t now_tick = floor_tick_of(now);
+      while (next_tick_ <= now_tick)
+      {
+        if (wheel_size_ == 0)
+        {
+          next_tick_ = now_tick + 1;
+          return;
+        }
+        // skip the ticks having nothing to cascade nor to expire
+        next_tick_ = (std::min)(next_event(), now_tick + 1);
+        if (next_tick_ > now_tick) return;
+
+        const unsigned index = static_cast<unsigned>(next_tick_ & (slots - 1));
+        if (index == 0)
+        {
+          // cascade the next level, and the following ones as long as they wrap around too
+          for (unsigned level = 1; level < levels; ++level)
+          {
+            if (cascade(level, static_cast<unsigned>((next_tick_ >> (slot_bits * level)) & (slots - 1))) != 0) break;
+          }
+        }
+        expire(index);
+        ++next_tick_;
+      }
+    }
+
+    bool has_ready() const BOOST_NOEXCEPT
+    { return ready_head_ != 0; }
+
+    /**
+     * \b Requires: ! empty() && ! has_ready()
+     *
+     * \b Returns: a time point not after the next one at which advance() can make an element ready.
+     */
+    time_point next_expiry() const
+    {
+      BOOST_ASSERT(wheel_size_ > 0);
+      return start_ + duration(resolution_.count() * static_cast<typename duration::rep>(next_event()));
+    }
+
+    /**
+     * \b Requires: has_ready()
+     */
+    void pull(T& elem)
+    {
+      node* n = ready_head_;
+      elem = boost::move(n->value());
+      unlink(n);
+      --size_;
+      pool_.destroy(n);
+    }
+
+    /**
+     * \b Requires: has_ready()
+     */
+    T pull()
+    {
+      node* n = ready_head_;
+      T elem(boost::move(n->value()));
+      unlink(n);
+      --size_;
+      pool_.destroy(n);
+      return boost::move(elem);
+    }
+
+    /**
+     * Removes the element of the node if the node has not been released since it had the given generation.
+     */
+    bool cancel(node* n, std::size_t generation)
+    {
+      if (! timer_node_pool<node>::alive(n, generation)) return false;
+      if (n->slot != ready_slot) --wheel_size_;
+      unlink(n);
+      --size_;
+      pool_.destroy(n);
+      return true;
+    }
+
+  private:
+    boost::uint64_t floor_tick_of(time_point const& tp) const
+    {
+      if (tp <= start_) return 0;
+      return static_cast<boost::uint64_t>((tp - start_).count()) / static_cast<boost::uint64_t>(resolution_.count());
+    }
+
+    // rounded up, so that an element is never reported before its time point
+    boost::uint64_t tick_of(time_point const& tp) const
+    {
+      if (tp <= start_) return 0;
+      const boost::uint64_t res = static_cast<boost::uint64_t>(resolution_.count());
+      return (static_cast<boost::uint64_t>((tp - start_).count()) + res - 1) / res;
+    }
+
+    void link(node* n, unsigned slot) BOOST_NOEXCEPT
+    {
+      n->slot = slot;
+      n->prev = 0;
+      n->next = slots_[slot];
+      if (n->next) n->next->prev = n;
+      slots_[slot] = n;
+      occupied_[slot / slots][(slot % slots) / 64] |= boost::uint64_t(1) << (slot % 64);
+    }
+
+    void link_ready(node* n) BOOST_NOEXCEPT
+    {
+      n->slot = ready_slot;
+      n->next = 0;
+      n->prev = ready_tail_;
+      if (ready_tail_) ready_tail_->next = n;
+      else ready_head_ = n;
+      ready_tail_ = n;
+    }
+
+    void unlink(node* n) BOOST_NOEXCEPT
+    {
+      if (n->next) n->next->prev = n->prev;
+      if (n->slot == ready_slot)
+      {
+        if (n->prev) n->prev->next = n->next;
+        else ready_head_ = n->next;
+        if (ready_tail_ == n) ready_tail_ = n->prev;
+        return;
+      }
+      if (n->prev)
+      {
+        n->prev->next = n->next;
+      }
+      else
+      {
+        slots_[n->slot] = n->next;
+        if (n->next == 0)
+        {
+          occupied_[n->slot / slots][(n->slot % slots) / 64] &= ~(boost::uint64_t(1) << (n->slot % 64));
+        }
+      }
+    }
+
+    // takes the list of a slot out of the wheel
+    node* take(unsigned slot) BOOST_NOEXCEPT
+    {
+      node* head = slots_[slot];
+      slots_[slot] = 0;
+      occupied_[slot / slots][(slot % slots) / 64] &= ~(boost::uint64_t(1) << (slot % 64));
+      return head;
+    }
+
+    // places the node in the level covering its distance to the next tick
+    void add(node* n) BOOST_NOEXCEPT
+    {
+      boost::uint64_t tick = (std::max)(n->tick, next_tick_);
+      const boost::uint64_t delta = tick - next_tick_;
+      unsigned level = 0;
+      while (level < levels - 1 && delta >= (boost::uint64_t(1) << (slot_bits * (level + 1)))) ++level;
+      if (level == levels - 1 && delta >= (boost::uint64_t(1) << (slot_bits * levels)))
+      {
+        // beyond the range of the wheel: parked at its end and added again when cascaded
+        tick = next_tick_ + (boost::uint64_t(1) << (slot_bits * levels)) - 1;
+      }
+      link(n, level * slots + static_cast<unsigned>((tick >> (slot_bits * level)) & (slots - 1)));
+    }
+
+    unsigned cascade(unsigned level, unsigned index) BOOST_NOEXCEPT
+    {
+      node* n = take(level * slots + index);
+      while (n)
+      {
+        node* next = n->next;
+        add(n);
+        n = next;
+      }
+      return index;
+    }
+
+    void expire(unsigned index) BOOST_NOEXCEPT
+    {
+      node* n = take(index);
+      while (n)
+      {
+        node* next = n->next;
+        --wheel_size_;
+        link_ready(n);
+        n = next;
+      }
+    }
+
+    /**
+     * A tick, not before next_tick_, such that there is nothing to cascade nor to expire before it.
+     *
+     * The slots of a level are visited once every 256^level ticks; the first occupied slot of the first
+     * level having one in the remaining of its revolution gives the tick. The tick at which a level
+     * wraps around is returned instead when higher levels are cascaded at this tick.
+     */
+    boost::uint64_t next_event() const BOOST_NOEXCEPT
+    {
+      for (unsigned level = 0; level < levels; ++level)
+      {
+        const unsigned shift = slot_bits * level;
+        // first tick at which this level is visited
+        const boost::uint64_t first = ((next_tick_ + (boost::uint64_t(1) << shift) - 1) >> shift) << shift;
+        const unsigned index = static_cast<unsigned>((first >> shift) & (slots - 1));
+        if (index == 0 && level + 1 < levels) return first;
+        const unsigned next_index = next_occupied(level, index);
+        if (next_index < slots) return first + (boost::uint64_t(next_index - index) << shift);
+        if (any_occupied(level)) return first + (boost::uint64_t(slots - index) << shift);
+      }
+      // only the elements beyond the range of the wheel are parked at its end
+      return next_tick_;
+    }
+
+    // first occupied slot of the level at or after index, slots if none
+    unsigned next_occupied(unsigned level, unsigned index) const BOOST_NOEXCEPT
+    {
+      while (index < slots)
+      {
+        const boost::uint64_t bits = occupied_[level][index / 64] >> (index % 64);
+        if (bits != 0) return index + lowest_bit(bits);
+        index = (index / 64 + 1) * 64;
+      }
+      return slots;
+    }
+
+    bool any_occupied(unsigned level) const BOOST_NOEXCEPT
+    {
+      for (unsigned word = 0; word < slots / 64; ++word)
+      {
+        if (occupied_[level][word] != 0) return true;
+      }
+      return false;
+    }
+
+    static unsigned lowest_bit(boost::uint64_t bits) BOOST_NOEXCEPT
+    {
+#if defined __GNUC__
+      return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+      unsigned n = 0;
+      while ((bits & 1) == 0)
+      {
+        bits >>= 1;
+        ++n;
+      }
+      return n;
+#endif
+    }
+  };
+
+} //end detail namespace
+
+  /**
+   * Timed queue backed by a hierarchical timing wheel.
+   *
+   * It has the interface of sync_timed_queue, but pushing and cancelling an element are constant time
+   * instead of logarithmic, at the cost of a resolution: the elements become ready up to a tick after
+   * their time point, and the ones becoming ready at the same tick are pulled in an unspecified order.
+   */
+  template <class T, class Clock = chrono::steady_clock>
+  class sync_timing_wheel_queue
+    : private concurrent::detail::sync_queue_base<T, concurrent::detail::timing_wheel<T, Clock> >
+  {
+    typedef concurrent::detail::timing_wheel<T, Clock> wheel_type;
+    typedef concurrent::detail::sync_queue_base<T, wheel_type> super;
+    typedef typename wheel_type::node node;
+  public:
+    typedef T value_type;
+    typedef Clock clock;
+    typedef typename clock::duration duration;
+    typedef typename clock::time_point time_point;
+    typedef typename super::size_type size_type;
+    typedef typename super::op_status op_status;
+
+    sync_timing_wheel_queue() : super() {}
+    /**
+     * \b Effects: Constructs an empty queue whose elements become ready with the given resolution.
+     */
+    explicit sync_timing_wheel_queue(duration const& resolution) : super()
+    {
+      super::data_.resolution(resolution);
+    }
+    ~sync_timing_wheel_queue() {}
+
+    using super::size;
+    using super::empty;
+    using super::full;
+    using super::close;
+    using super::closed;
+
+    duration resolution() const
+    {
+      return super::data_.resolution();
+    }
+
+    T pull();
+    void pull(T& elem);
+
+    template <class Duration>
+    queue_op_status pull_until(chrono::time_point<clock,Duration> const& tp, T& elem);
+    template <class Rep, class Period>
+    queue_op_status pull_for(chrono::duration<Rep,Period> const& dura, T& elem);
+
+    queue_op_status try_pull(T& elem);
+    queue_op_status wait_pull(T& elem);
+    queue_op_status nonblocking_pull(T& elem);
+
+    template <class Duration>
+    timer_handle push(const T& elem, chrono::time_point<clock,Duration> const& tp);
+    template <class Rep, class Period>
+    timer_handle push(const T& elem, chrono::duration<Rep,Period> const& dura);
+
+    template <class Duration>
+    timer_handle push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp);
+    template <class Rep, class Period>
+    timer_handle push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura);
+
+    template <class Duration>
+    queue_op_status try_push(const T& elem, chrono::time_point<clock,Duration> const& tp);
+    template <class Rep, class Period>
+    queue_op_status try_push(const T& elem, chrono::duration<Rep,Period> const& dura);
+
+    template <class Duration>
+    queue_op_status try_push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp);
+    template <class Rep, class Period>
+    queue_op_status try_push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura);
+
+  private:
+    inline bool not_empty_and_time_reached(unique_lock<mutex>& lk);
+    inline bool not_empty_and_time_reached(lock_guard<mutex>& lk);
+
+    bool wait_to_pull(unique_lock<mutex>&);
+    queue_op_status wait_to_pull_until(unique_lock<mutex>&, time_point const& tp);
+    template <class Rep, class Period>
+    queue_op_status wait_to_pull_for(unique_lock<mutex>& lk, chrono::duration<Rep,Period> const& dura);
+
+    inline queue_op_status timeout_or_not_ready(unique_lock<mutex>& lk);
+
+    template <class U>
+    timer_handle push(lock_guard<mutex>& lk, BOOST_THREAD_FWD_REF(U) elem, time_point const& tp);
+
+    queue_op_status try_pull(unique_lock<mutex>&, T& elem);
+    queue_op_status try_pull(lock_guard<mutex>&, T& elem);
+
+    queue_op_status wait_pull(unique_lock<mutex>& lk, T& elem);
+
+    static bool cancel(void* queue, void* entry, std::size_t generation);
+
+    sync_timing_wheel_queue(const sync_timing_wheel_queue&);
+    sync_timing_wheel_queue& operator=(const sync_timing_wheel_queue&);
+    sync_timing_wheel_queue(BOOST_THREAD_RV_REF(sync_timing_wheel_queue));
+    sync_timing_wheel_queue& operator=(BOOST_THREAD_RV_REF(sync_timing_wheel_queue));
+  }; //end class
+
+  ///////////////////////////
+  template <class T, class Clock>
+  template <class U>
+  timer_handle sync_timing_wheel_queue<T, Clock>::push(lock_guard<mutex>& lk, BOOST_THREAD_FWD_REF(U) elem, time_point const& tp)
+  {
+    super::throw_if_closed(lk);
+    node* n = super::data_.insert(boost::forward<U>(elem), tp);
+    super::notify_elem_added(lk);
+    return timer_handle(&sync_timing_wheel_queue::cancel, this, n, n->generation);
+  }
+
+  template <class T, class Clock>
+  bool sync_timing_wheel_queue<T, Clock>::cancel(void* queue, void* entry, std::size_t generation)
+  {
+    sync_timing_wheel_queue* self = static_cast<sync_timing_wheel_queue*>(queue);
+    lock_guard<mutex> lk(self->mtx_);
+    return self->data_.cancel(static_cast<node*>(entry), generation);
+  }
+
+  template <class T, class Clock>
+  template <class Duration>
+  timer_handle sync_timing_wheel_queue<T, Clock>::push(const T& elem, chrono::time_point<clock,Duration> const& tp)
+  {
+    lock_guard<mutex> lk(super::mtx_);
+    return push(lk, elem, tp);
+  }
+
+  template <class T, class Clock>
+  template <class Rep, class Period>
+  timer_handle sync_timing_wheel_queue<T, Clock>::push(const T& elem, chrono::duration<Rep,Period> const& dura)
+  {
+    return push(elem, clock::now() + dura);
+  }
+
+  template <class T, class Clock>
+  template <class Duration>
+  timer_handle sync_timing_wheel_queue<T, Clock>::push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp)
+  {
+    lock_guard<mutex> lk(super::mtx_);
+    return push(lk, boost::move(elem), tp);
+  }
+
+  template <class T, class Clock>
+  template <class Rep, class Period>
+  timer_handle sync_timing_wheel_queue<T, Clock>::push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura)
+  {
+    return push(boost::move(elem), clock::now() + dura);
+  }
+
+  template <class T, class Clock>
+  template <class Duration>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_push(const T& elem, chrono::time_point<clock,Duration> const& tp)
+  {
+    lock_guard<mutex> lk(super::mtx_);
+    if (super::closed(lk)) return queue_op_status::closed;
+    push(lk, elem, tp);
+    return queue_op_status::success;
+  }
+
+  template <class T, class Clock>
+  template <class Rep, class Period>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_push(const T& elem, chrono::duration<Rep,Period> const& dura)
+  {
+    return try_push(elem, clock::now() + dura);
+  }
+
+  template <class T, class Clock>
+  template <class Duration>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_push(BOOST_THREAD_RV_REF(T) elem, chrono::time_point<clock,Duration> const& tp)
+  {
+    lock_guard<mutex> lk(super::mtx_);
+    if (super::closed(lk)) return queue_op_status::closed;
+    push(lk, boost::move(elem), tp);
+    return queue_op_status::success;
+  }
+
+  template <class T, class Clock>
+  template <class Rep, class Period>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_push(BOOST_THREAD_RV_REF(T) elem, chrono::duration<Rep,Period> const& dura)
+  {
+    return try_push(boost::move(elem), clock::now() + dura);
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  bool sync_timing_wheel_queue<T, Clock>::not_empty_and_time_reached(unique_lock<mutex>& lk)
+  {
+    if (super::empty(lk)) return false;
+    super::data_.advance(clock::now());
+    return super::data_.has_ready();
+  }
+
+  template <class T, class Clock>
+  bool sync_timing_wheel_queue<T, Clock>::not_empty_and_time_reached(lock_guard<mutex>& lk)
+  {
+    if (super::empty(lk)) return false;
+    super::data_.advance(clock::now());
+    return super::data_.has_ready();
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::timeout_or_not_ready(unique_lock<mutex>& lk)
+  {
+    if (super::empty(lk)) return queue_op_status::timeout;
+    // this consumer could have consumed the notification of an element another consumer is waiting for
+    super::notify_not_empty_if_needed(lk);
+    return queue_op_status::not_ready;
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  bool sync_timing_wheel_queue<T, Clock>::wait_to_pull(unique_lock<mutex>& lk)
+  {
+    for (;;)
+    {
+      if (not_empty_and_time_reached(lk)) return false; // success
+      if (super::closed(lk)) return true; // closed
+
+      super::wait_until_not_empty_or_closed(lk);
+
+      if (not_empty_and_time_reached(lk)) return false; // success
+      if (super::closed(lk)) return true; // closed
+
+      const time_point tpmin(detail::limit_timepoint(super::data_.next_expiry()));
+      super::wait_elem_until(lk, tpmin);
+    }
+  }
+
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::wait_to_pull_until(unique_lock<mutex>& lk, time_point const& tp)
+  {
+    for (;;)
+    {
+      if (not_empty_and_time_reached(lk)) return queue_op_status::success;
+      if (super::closed(lk)) return queue_op_status::closed;
+      if (clock::now() >= tp) return timeout_or_not_ready(lk);
+
+      super::wait_until_not_empty_or_closed_until(lk, tp);
+
+      if (not_empty_and_time_reached(lk)) return queue_op_status::success;
+      if (super::closed(lk)) return queue_op_status::closed;
+      if (clock::now() >= tp) return timeout_or_not_ready(lk);
+
+      const time_point tpmin((std::min)(tp, detail::limit_timepoint(super::data_.next_expiry())));
+      super::wait_elem_until(lk, tpmin);
+    }
+  }
+
+  template <class T, class Clock>
+  template <class Rep, class Period>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::wait_to_pull_for(unique_lock<mutex>& lk, chrono::duration<Rep,Period> const& dura)
+  {
+    const chrono::steady_clock::time_point tp(chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(dura));
+    for (;;)
+    {
+      if (not_empty_and_time_reached(lk)) return queue_op_status::success;
+      if (super::closed(lk)) return queue_op_status::closed;
+      if (chrono::steady_clock::now() >= tp) return timeout_or_not_ready(lk);
+
+      super::wait_until_not_empty_or_closed_until(lk, tp);
+
+      if (not_empty_and_time_reached(lk)) return queue_op_status::success;
+      if (super::closed(lk)) return queue_op_status::closed;
+      if (chrono::steady_clock::now() >= tp) return timeout_or_not_ready(lk);
+
+      const chrono::steady_clock::time_point tpmin((std::min)(tp, detail::convert_to_steady_clock_timepoint(super::data_.next_expiry())));
+      super::wait_elem_until(lk, tpmin);
+    }
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  T sync_timing_wheel_queue<T, Clock>::pull()
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    const bool has_been_closed = wait_to_pull(lk);
+    if (has_been_closed) super::throw_if_closed(lk);
+    return super::data_.pull();
+  }
+
+  template <class T, class Clock>
+  void sync_timing_wheel_queue<T, Clock>::pull(T& elem)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    const bool has_been_closed = wait_to_pull(lk);
+    if (has_been_closed) super::throw_if_closed(lk);
+    super::data_.pull(elem);
+  }
+
+  //////////////////////
+  template <class T, class Clock>
+  template <class Duration>
+  queue_op_status
+  sync_timing_wheel_queue<T, Clock>::pull_until(chrono::time_point<clock,Duration> const& tp, T& elem)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    const queue_op_status rc = wait_to_pull_until(lk, chrono::time_point_cast<typename time_point::duration>(tp));
+    if (rc == queue_op_status::success) super::data_.pull(elem);
+    return rc;
+  }
+
+  //////////////////////
+  template <class T, class Clock>
+  template <class Rep, class Period>
+  queue_op_status
+  sync_timing_wheel_queue<T, Clock>::pull_for(chrono::duration<Rep,Period> const& dura, T& elem)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    const queue_op_status rc = wait_to_pull_for(lk, dura);
+    if (rc == queue_op_status::success) super::data_.pull(elem);
+    return rc;
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_pull(unique_lock<mutex>& lk, T& elem)
+  {
+    if (not_empty_and_time_reached(lk))
+    {
+      super::data_.pull(elem);
+      return queue_op_status::success;
+    }
+    if (super::closed(lk)) return queue_op_status::closed;
+    if (super::empty(lk)) return queue_op_status::empty;
+    return queue_op_status::not_ready;
+  }
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_pull(lock_guard<mutex>& lk, T& elem)
+  {
+    if (not_empty_and_time_reached(lk))
+    {
+      super::data_.pull(elem);
+      return queue_op_status::success;
+    }
+    if (super::closed(lk)) return queue_op_status::closed;
+    if (super::empty(lk)) return queue_op_status::empty;
+    return queue_op_status::not_ready;
+  }
+
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::try_pull(T& elem)
+  {
+    lock_guard<mutex> lk(super::mtx_);
+    return try_pull(lk, elem);
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::wait_pull(unique_lock<mutex>& lk, T& elem)
+  {
+    const bool has_been_closed = wait_to_pull(lk);
+    if (has_been_closed) return queue_op_status::closed;
+    super::data_.pull(elem);
+    return queue_op_status::success;
+  }
+
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::wait_pull(T& elem)
+  {
+    unique_lock<mutex> lk(super::mtx_);
+    return wait_pull(lk, elem);
+  }
+
+  ///////////////////////////
+  template <class T, class Clock>
+  queue_op_status sync_timing_wheel_queue<T, Clock>::nonblocking_pull(T& elem)
+  {
+    unique_lock<mutex> lk(super::mtx_, try_to_lock);
+    if (! lk.owns_lock()) return queue_op_status::busy;
+    return try_pull(lk, elem);
+  }
+
+} //end concurrent namespace
+
+using concurrent::sync_timing_wheel_queue;
+
+} //end boost namespace
+#include <boost/config/abi_suffix.hpp>
+
+#endif
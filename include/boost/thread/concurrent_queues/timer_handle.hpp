@@ -0,0 +1,64 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_THREAD_CONCURRENT_QUEUES_TIMER_HANDLE_HPP
+#define BOOST_THREAD_CONCURRENT_QUEUES_TIMER_HANDLE_HPP
+
+#include <boost/thread/detail/config.hpp>
+
+#include <cstddef>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace concurrent
+{
+
+  /**
+   * Lightweight handle to an element pushed on a timed queue, used to cancel it before it is pulled.
+   *
+   * The handle doesn't own the element and must not be used once the queue has been destroyed.
+   */
+  class timer_handle
+  {
+  public:
+    /// Removes the entry from the queue if its generation is still the given one.
+    typedef bool (*cancel_function)(void* queue, void* entry, std::size_t generation);
+
+    timer_handle() BOOST_NOEXCEPT
+      : cancel_(0), queue_(0), entry_(0), generation_(0)
+    {}
+
+    timer_handle(cancel_function cancel, void* queue, void* entry, std::size_t generation) BOOST_NOEXCEPT
+      : cancel_(cancel), queue_(queue), entry_(entry), generation_(generation)
+    {}
+
+    /**
+     * \b Effects: If the element has not been pulled nor cancelled yet, removes it from the queue
+     * and destroys it.
+     *
+     * \b Returns: Whether the element has been removed.
+     */
+    bool cancel()
+    {
+      return cancel_ != 0 && cancel_(queue_, entry_, generation_);
+    }
+
+  private:
+    cancel_function cancel_;
+    void* queue_;
+    void* entry_;
+    std::size_t generation_;
+  };
+
+} //end concurrent namespace
+
+using concurrent::timer_handle;
+
+} //end boost namespace
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -11,91 +11,274 @@
 
 #include <boost/config.hpp>
 
-#include <boost/thread/csbl/vector.hpp>
+#include <boost/assert.hpp>
+#include <boost/move/utility.hpp>
 #include <boost/move/detail/move_helpers.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// must be a power of two
+#ifndef BOOST_THREAD_DEVECTOR_MIN_CAPACITY
+#define BOOST_THREAD_DEVECTOR_MIN_CAPACITY 16
+#endif
+
 namespace boost
 {
   namespace csbl
   {
+    /**
+     * Growable circular buffer with constant time insertion and removal at both ends.
+     *
+     * The capacity is a power of two that only grows when the buffer is full, so the
+     * storage is bounded by twice the peak number of elements. shrink_to_fit() gives the
+     * storage back when the buffer is idle.
+     */
     template <class T>
     class devector
     {
-      typedef csbl::vector<T> vector_type;
-      vector_type data_;
-      std::size_t front_index_;
+      typedef std::allocator<T> allocator_type;
+
+      T* buffer_;
+      std::size_t capacity_;
+      std::size_t head_;
+      std::size_t size_;
 
       BOOST_COPYABLE_AND_MOVABLE(devector)
 
+      std::size_t index(std::size_t i) const BOOST_NOEXCEPT
+      { return (head_ + i) & (capacity_ - 1); }
+
+      static T* allocate(std::size_t n)
+      { return n == 0 ? 0 : allocator_type().allocate(n); }
+
+      static void deallocate(T* p, std::size_t n) BOOST_NOEXCEPT
+      { if (p) allocator_type().deallocate(p, n); }
+
+      static std::size_t capacity_for(std::size_t n) BOOST_NOEXCEPT
+      {
+        std::size_t cap = BOOST_THREAD_DEVECTOR_MIN_CAPACITY;
+        while (cap < n) cap *= 2;
+        return cap;
+      }
+
+      void destroy_all() BOOST_NOEXCEPT
+      {
+        for (std::size_t i = 0; i < size_; ++i)
+        {
+          buffer_[index(i)].~T();
+        }
+        size_ = 0;
+        head_ = 0;
+      }
+
+      // moves the elements to a new buffer of cap elements, the first one at index 0
+      void reallocate(std::size_t cap)
+      {
+        BOOST_ASSERT(cap >= size_);
+        T* buffer = allocate(cap);
+        std::size_t i = 0;
+        try
+        {
+          for (; i < size_; ++i)
+          {
+            ::new (static_cast<void*>(buffer + i)) T(boost::move(buffer_[index(i)]));
+          }
+        }
+        catch (...)
+        {
+          while (i > 0) buffer[--i].~T();
+          deallocate(buffer, cap);
+          throw;
+        }
+        for (i = 0; i < size_; ++i)
+        {
+          buffer_[index(i)].~T();
+        }
+        deallocate(buffer_, capacity_);
+        buffer_ = buffer;
+        capacity_ = cap;
+        head_ = 0;
+      }
+
+      void grow_if_full()
+      {
+        if (size_ == capacity_)
+        {
+          reallocate(capacity_ == 0 ? std::size_t(BOOST_THREAD_DEVECTOR_MIN_CAPACITY) : 2 * capacity_);
+        }
+      }
+
       template <class U>
       void priv_push_back(BOOST_FWD_REF(U) x)
-      { data_.push_back(boost::forward<U>(x)); }
+      {
+        grow_if_full();
+        ::new (static_cast<void*>(buffer_ + index(size_))) T(boost::forward<U>(x));
+        ++size_;
+      }
 
-    public:
-      typedef typename vector_type::size_type size_type;
-      typedef typename vector_type::reference reference;
-      typedef typename vector_type::const_reference const_reference;
+      template <class U>
+      void priv_push_front(BOOST_FWD_REF(U) x)
+      {
+        grow_if_full();
+        const std::size_t head = (head_ + capacity_ - 1) & (capacity_ - 1);
+        ::new (static_cast<void*>(buffer_ + head)) T(boost::forward<U>(x));
+        head_ = head;
+        ++size_;
+      }
 
+    public:
+      typedef T value_type;
+      typedef std::size_t size_type;
+      typedef T& reference;
+      typedef T const& const_reference;
 
-      devector() : front_index_(0) {}
-      devector(devector const& x) BOOST_NOEXCEPT
-         :  data_(x.data_),
-            front_index_(x.front_index_)
+      devector() BOOST_NOEXCEPT
+        : buffer_(0), capacity_(0), head_(0), size_(0)
       {}
+      devector(devector const& x)
+        : buffer_(0), capacity_(0), head_(0), size_(0)
+      {
+        if (x.size_ == 0) return;
+        buffer_ = allocate(capacity_for(x.size_));
+        capacity_ = capacity_for(x.size_);
+        try
+        {
+          for (; size_ < x.size_; ++size_)
+          {
+            ::new (static_cast<void*>(buffer_ + size_)) T(x[size_]);
+          }
+        }
+        catch (...)
+        {
+          destroy_all();
+          deallocate(buffer_, capacity_);
+          throw;
+        }
+      }
       devector(BOOST_RV_REF(devector) x) BOOST_NOEXCEPT
-         :  data_(boost::move(x.data_)),
-            front_index_(x.front_index_)
-      {}
+        : buffer_(x.buffer_), capacity_(x.capacity_), head_(x.head_), size_(x.size_)
+      {
+        x.buffer_ = 0;
+        x.capacity_ = 0;
+        x.head_ = 0;
+        x.size_ = 0;
+      }
+      ~devector()
+      {
+        destroy_all();
+        deallocate(buffer_, capacity_);
+      }
 
       devector& operator=(BOOST_COPY_ASSIGN_REF(devector) x)
       {
-         if (&x != this)
-         {
-           data_ = x.data_;
-           front_index_ = x.front_index_;
-         }
-         return *this;
+        if (&x != this)
+        {
+          devector tmp(x);
+          swap(tmp);
+        }
+        return *this;
       }
 
-      devector& operator=(BOOST_RV_REF(devector) x)
-#if defined BOOST_THREAD_USES_BOOST_VECTOR
-         BOOST_NOEXCEPT_IF(vector_type::allocator_traits_type::propagate_on_container_move_assignment::value)
-#endif
+      devector& operator=(BOOST_RV_REF(devector) x) BOOST_NOEXCEPT
       {
-        data_ = boost::move(x.data_);
-        front_index_ = x.front_index_;
+        if (&x != this)
+        {
+          destroy_all();
+          deallocate(buffer_, capacity_);
+          buffer_ = x.buffer_;
+          capacity_ = x.capacity_;
+          head_ = x.head_;
+          size_ = x.size_;
+          x.buffer_ = 0;
+          x.capacity_ = 0;
+          x.head_ = 0;
+          x.size_ = 0;
+        }
         return *this;
       }
 
+      void swap(devector& x) BOOST_NOEXCEPT
+      {
+        std::swap(buffer_, x.buffer_);
+        std::swap(capacity_, x.capacity_);
+        std::swap(head_, x.head_);
+        std::swap(size_, x.size_);
+      }
+
       bool empty() const BOOST_NOEXCEPT
-      { return data_.size() == front_index_; }
+      { return size_ == 0; }
 
       size_type size() const BOOST_NOEXCEPT
-      { return data_.size() - front_index_; }
+      { return size_; }
+
+      size_type capacity() const BOOST_NOEXCEPT
+      { return capacity_; }
+
+      reference         operator[](size_type i) BOOST_NOEXCEPT
+      { return buffer_[index(i)]; }
+
+      const_reference         operator[](size_type i) const BOOST_NOEXCEPT
+      { return buffer_[index(i)]; }
 
       reference         front() BOOST_NOEXCEPT
-      { return data_[front_index_]; }
+      { return buffer_[head_]; }
 
       const_reference         front() const BOOST_NOEXCEPT
-      { return data_[front_index_]; }
+      { return buffer_[head_]; }
 
       reference         back() BOOST_NOEXCEPT
-      { return data_.back(); }
+      { return buffer_[index(size_ - 1)]; }
 
       const_reference         back() const BOOST_NOEXCEPT
-      { return data_.back(); }
+      { return buffer_[index(size_ - 1)]; }
 
       BOOST_MOVE_CONVERSION_AWARE_CATCH(push_back, T, void, priv_push_back)
+      BOOST_MOVE_CONVERSION_AWARE_CATCH(push_front, T, void, priv_push_front)
 
-      void pop_front()
+      void pop_front() BOOST_NOEXCEPT
       {
-        ++front_index_;
-        if (empty()) {
-          data_.clear();
-          front_index_=0;
-        }
-       }
+        BOOST_ASSERT(size_ > 0);
+        buffer_[head_].~T();
+        head_ = (head_ + 1) & (capacity_ - 1);
+        --size_;
+      }
+
+      void pop_back() BOOST_NOEXCEPT
+      {
+        BOOST_ASSERT(size_ > 0);
+        buffer_[index(size_ - 1)].~T();
+        --size_;
+      }
+
+      void clear() BOOST_NOEXCEPT
+      { destroy_all(); }
 
+      void reserve(size_type n)
+      {
+        if (n > capacity_) reallocate(capacity_for(n));
+      }
+
+      /**
+       * Releases the unused storage: all of it when the buffer is empty, otherwise the
+       * capacity is reduced to the smallest power of two holding the elements.
+       */
+      void shrink_to_fit()
+      {
+        if (size_ == 0)
+        {
+          deallocate(buffer_, capacity_);
+          buffer_ = 0;
+          capacity_ = 0;
+          head_ = 0;
+        }
+        else if (capacity_for(size_) < capacity_)
+        {
+          reallocate(capacity_for(size_));
+        }
+      }
     };
   }
 }
@@ -58,6 +58,26 @@
 #define BOOST_THREAD_POLL_INTERVAL_MILLISECONDS 100
 #endif
 
+// Used to pad the data shared between threads so that it doesn't share a cache line.
+#if !defined(BOOST_THREAD_CACHE_LINE_SIZE)
+#define BOOST_THREAD_CACHE_LINE_SIZE 64
+#endif
+
+// Size of the storage executors::work uses to hold the closures without allocating them.
+#if !defined(BOOST_THREAD_WORK_INLINE_SIZE)
+#define BOOST_THREAD_WORK_INLINE_SIZE 48
+#endif
+
+// Number of threads of the default executor, 0 meaning one per hardware thread.
+#if !defined(BOOST_THREAD_DEFAULT_EXECUTOR_THREADS)
+#define BOOST_THREAD_DEFAULT_EXECUTOR_THREADS 0
+#endif
+
+// Stack size of the threads of the default executor, 0 meaning the platform default.
+#if !defined(BOOST_THREAD_DEFAULT_EXECUTOR_STACK_SIZE)
+#define BOOST_THREAD_DEFAULT_EXECUTOR_STACK_SIZE 0
+#endif
+
 #if defined BOOST_THREAD_THROW_IF_PRECONDITION_NOT_SATISFIED
 #define BOOST_THREAD_ASSERT_PRECONDITION(EXPR, EX) \
         if (EXPR) {} else boost::throw_exception(EX)
@@ -335,6 +355,12 @@
 
 #endif // BOOST_THREAD_VERSION>=4
 
+// when_all/when_any are made ready by the continuations of their futures
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY \
+ && ! defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+#undef BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#endif
+
 
 #if BOOST_THREAD_VERSION>=5
 //#define BOOST_THREAD_FUTURE_BLOCKING
@@ -439,6 +465,12 @@
   #endif
 #endif
 
+// FUTEX: the threads waiting on a condition_variable or a shared_mutex are parked on a futex word
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD) && defined(__linux__) \
+ && ! defined BOOST_THREAD_USES_FUTEX && ! defined BOOST_THREAD_DONT_USE_FUTEX
+#define BOOST_THREAD_USES_FUTEX
+#endif
+
 #if defined(BOOST_THREAD_PLATFORM_WIN32)
 #elif ! defined BOOST_THREAD_INTERNAL_CLOCK_IS_MONO
 #if defined BOOST_PTHREAD_HAS_TIMEDLOCK
@@ -9,12 +9,20 @@
 #include <boost/thread/detail/config.hpp>
 #include <boost/thread/detail/delete.hpp>
 
-//#include <boost/thread/mutex.hpp>
-//#include <boost/thread/lock_types.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_types.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/chrono/duration.hpp>
 #include <boost/chrono/time_point.hpp>
 #include <boost/assert.hpp>
+#include <boost/atomic.hpp>
+#if defined BOOST_THREAD_USES_FUTEX
+#include <boost/thread/pthread/futex.hpp>
+#include <boost/thread/detail/platform_time.hpp>
+#include <boost/chrono/system_clocks.hpp>
+#include <algorithm>
+#include <errno.h>
+#endif
 
 #include <boost/config/abi_prefix.hpp>
 
@@ -25,9 +33,11 @@ namespace boost
     {
       condition_variable cond_;
       std::size_t value_;
+      // The number of threads blocked on cond_, protected as value_ by the caller's mutex.
+      std::size_t sleepers_;
 
       counter(std::size_t value)
-      : value_(value)
+      : value_(value), sleepers_(0)
       {
 
       }
@@ -51,26 +61,173 @@ namespace boost
         return value_;
       }
 
+      // Notifies only when a thread is blocked, so that the changes nobody waits for are free.
+      void notify_all()
+      {
+        if (sleepers_ > 0) cond_.notify_all();
+      }
+
       void inc_and_notify_all()
       {
         ++value_;
-        cond_.notify_all();
+        notify_all();
       }
 
       void dec_and_notify_all()
       {
         --value_;
-        cond_.notify_all();
+        notify_all();
       }
       void assign_and_notify_all(counter const& rhs)
       {
         value_ = rhs.value_;
-        cond_.notify_all();
+        notify_all();
       }
       void assign_and_notify_all(std::size_t value)
       {
         value_ = value;
+        notify_all();
+      }
+
+      template <class Predicate>
+      void wait(unique_lock<mutex>& lk, Predicate pred)
+      {
+        sleeper s(*this);
+        cond_.wait(lk, pred);
+      }
+      template <class Rep, class Period, class Predicate>
+      bool wait_for(unique_lock<mutex>& lk, const chrono::duration<Rep, Period>& rel_time, Predicate pred)
+      {
+        sleeper s(*this);
+        return cond_.wait_for(lk, rel_time, pred);
+      }
+      template <class Clock, class Duration, class Predicate>
+      bool wait_until(unique_lock<mutex>& lk, const chrono::time_point<Clock, Duration>& abs_time, Predicate pred)
+      {
+        sleeper s(*this);
+        return cond_.wait_until(lk, abs_time, pred);
+      }
+
+    private:
+      struct sleeper
+      {
+        counter& that_;
+        sleeper(counter& that) : that_(that) { ++that_.sleepers_; }
+        ~sleeper() { --that_.sleepers_; }
+      };
+    };
+
+    /**
+     * A word the threads wait on until it changes. The last thread to arrive at a barrier or a latch
+     * advances it and wakes all the threads waiting for this generation at once.
+     *
+     * On Linux the threads park on the word itself. As thread::interrupt() increments the word a thread
+     * is parked on to wake it, the generation is kept in the high bits. Elsewhere the threads wait on a
+     * condition variable.
+     */
+    class generation
+    {
+#if defined BOOST_THREAD_USES_FUTEX
+      BOOST_STATIC_CONSTANT(unsigned int, step = 1u << 16);
+      futex_word value_;
+
+      // Returns true once the generation is no longer gen or false when abs_time, if any, is reached.
+      bool park(unsigned int gen, internal_platform_timepoint const* abs_time)
+      {
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        futex_interruption_checker check_for_interruption(&value_);
+#endif
+        for (;;)
+        {
+          unsigned int const v = value_.load();
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+          check_for_interruption.check_for_interruption();
+#endif
+          if ((v & ~(step - 1)) != gen) return true;
+          int const res = abs_time ? futex::wait_until(value_, v, abs_time->getTs()) : futex::wait(value_, v);
+          if (res == ETIMEDOUT) return (value_.load() & ~(step - 1)) != gen;
+        }
+      }
+#else
+      atomic<unsigned int> value_;
+      mutex mtx_;
+      condition_variable cond_;
+
+      struct changed
+      {
+        changed(generation const& that, unsigned int gen) : that_(that), gen_(gen) {}
+        bool operator()() const { return that_.value_.load() != gen_; }
+        generation const& that_;
+        unsigned int gen_;
+      };
+#endif
+
+    public:
+      BOOST_THREAD_NO_COPYABLE(generation)
+
+      generation() : value_(0) {}
+
+      unsigned int load() const
+      {
+#if defined BOOST_THREAD_USES_FUTEX
+        return value_.load() & ~(step - 1);
+#else
+        return value_.load();
+#endif
+      }
+
+      void advance()
+      {
+#if defined BOOST_THREAD_USES_FUTEX
+        unsigned int v = value_.load();
+        while (! value_.compare_exchange_weak(v, (v & ~(step - 1)) + step))
+        {
+        }
+        futex::wake_all(value_);
+#else
+        value_.fetch_add(1);
+        // a waiter has either seen the new value or is blocked on cond_ once the mutex is taken
+        { lock_guard<mutex> lk(mtx_); }
         cond_.notify_all();
+#endif
+      }
+
+      /**
+       * Effects: Blocks until the generation is no longer gen, as returned by load().
+       */
+      void wait(unsigned int gen)
+      {
+#if defined BOOST_THREAD_USES_FUTEX
+        park(gen, 0);
+#else
+        unique_lock<mutex> lk(mtx_);
+        cond_.wait(lk, changed(*this, gen));
+#endif
+      }
+
+      /**
+       * Effects: Blocks until the generation is no longer gen, as returned by load(), or abs_time is
+       * reached.
+       *
+       * Returns: Whether the generation changed.
+       */
+      template <class Clock, class Duration>
+      bool wait_until(unsigned int gen, const chrono::time_point<Clock, Duration>& abs_time)
+      {
+#if defined BOOST_THREAD_USES_FUTEX
+        typedef typename common_type<Duration, typename Clock::duration>::type common_duration;
+        for (;;)
+        {
+          common_duration d(abs_time - Clock::now());
+          d = (std::min)(d, common_duration(chrono::milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS)));
+          const internal_platform_timepoint t(internal_chrono_clock::now() + d);
+          if (park(gen, &t)) return true;
+          if ( abs_time <= Clock::now() ) return false; // timeout occurred
+        }
+#else
+        unique_lock<mutex> lk(mtx_);
+        return cond_.wait_until(lk, abs_time, changed(*this, gen));
+#endif
       }
     };
     struct counter_is_not_zero
@@ -0,0 +1,26 @@
+#ifndef BOOST_THREAD_DETAIL_CPU_TOPOLOGY_HPP
+#define BOOST_THREAD_DETAIL_CPU_TOPOLOGY_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#include <vector>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace detail
+  {
+    // The CPUs of the affinity mask of the process, grouped by core and by NUMA node. They are probed
+    // once, with hardware_concurrency(), and are empty when the platform doesn't describe them.
+    BOOST_THREAD_DECL std::vector<std::vector<unsigned> > cpus_by_core();
+    BOOST_THREAD_DECL std::vector<std::vector<unsigned> > cpus_by_node();
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
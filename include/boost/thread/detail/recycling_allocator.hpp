@@ -0,0 +1,99 @@
+#ifndef BOOST_THREAD_DETAIL_RECYCLING_ALLOCATOR_HPP
+#define BOOST_THREAD_DETAIL_RECYCLING_ALLOCATOR_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#include <cstddef>
+#include <new>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace thread_detail
+  {
+    // Blocks of up to 1KB, as the future shared states and their shared_ptr control blocks, are kept
+    // on per-thread free lists by size class when released, and reused by the next allocation of the
+    // same size class on that thread. Larger blocks, and all of them where thread_local isn't
+    // available, come from ::operator new.
+    BOOST_THREAD_DECL void* allocate_recycled(std::size_t size);
+    BOOST_THREAD_DECL void deallocate_recycled(void* p, std::size_t size) BOOST_NOEXCEPT;
+
+    template <class T>
+    class recycling_allocator
+    {
+    public:
+      typedef T value_type;
+      typedef T* pointer;
+      typedef const T* const_pointer;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+
+      template <class U>
+      struct rebind
+      {
+        typedef recycling_allocator<U> other;
+      };
+
+      recycling_allocator() BOOST_NOEXCEPT {}
+      template <class U>
+      recycling_allocator(recycling_allocator<U> const&) BOOST_NOEXCEPT {}
+
+      pointer allocate(size_type n, const void* = 0)
+      {
+#if defined __cpp_aligned_new
+        // the free lists only give the default new alignment
+        if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+          return static_cast<pointer>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+#endif
+        return static_cast<pointer>(allocate_recycled(n * sizeof(T)));
+      }
+      void deallocate(pointer p, size_type n) BOOST_NOEXCEPT
+      {
+#if defined __cpp_aligned_new
+        if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+          ::operator delete(p, n * sizeof(T), std::align_val_t(alignof(T)));
+          return;
+        }
+#endif
+        deallocate_recycled(p, n * sizeof(T));
+      }
+
+      void construct(pointer p, const T& v)
+      {
+        ::new(static_cast<void*>(p)) T(v);
+      }
+      void destroy(pointer p)
+      {
+        p->~T();
+      }
+      size_type max_size() const BOOST_NOEXCEPT
+      {
+        return size_type(-1) / sizeof(T);
+      }
+    };
+
+    template <class T, class U>
+    bool operator==(recycling_allocator<T> const&, recycling_allocator<U> const&) BOOST_NOEXCEPT
+    {
+      return true;
+    }
+    template <class T, class U>
+    bool operator!=(recycling_allocator<T> const&, recycling_allocator<U> const&) BOOST_NOEXCEPT
+    {
+      return false;
+    }
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -0,0 +1,229 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Move-only nullary_function storing the small closures in place.
+
+#ifndef BOOST_THREAD_DETAIL_SMALL_NULLARY_FUNCTION_HPP
+#define BOOST_THREAD_DETAIL_SMALL_NULLARY_FUNCTION_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_nothrow_move_constructible.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/core/enable_if.hpp>
+
+#include <new>
+
+namespace boost
+{
+  namespace detail
+  {
+    union small_function_storage
+    {
+      void* ptr;
+      void (*fptr)();
+      long double ld;
+      long long ll;
+      char buffer[BOOST_THREAD_WORK_INLINE_SIZE];
+    };
+
+    struct small_function_vtable
+    {
+      void (*call)(small_function_storage&);
+      // move constructs the closure in dst from the one in src and destroys the latter
+      void (*move)(small_function_storage& dst, small_function_storage& src);
+      void (*destroy)(small_function_storage&);
+    };
+
+    // the closure can be stored in place when it fits and moving it can not throw
+    template <typename F>
+    struct small_function_fits_in_place : integral_constant<bool,
+           sizeof(F) <= sizeof(small_function_storage)
+        && alignment_of<small_function_storage>::value % alignment_of<F>::value == 0
+        && is_nothrow_move_constructible<F>::value
+      >
+    {};
+
+    template <typename F, bool InPlace = small_function_fits_in_place<F>::value>
+    struct small_function_manager
+    {
+      static F& get(small_function_storage& s) BOOST_NOEXCEPT
+      { return *static_cast<F*>(static_cast<void*>(s.buffer)); }
+
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+      template <typename A>
+      static void create(small_function_storage& s, A&& a)
+      { ::new (static_cast<void*>(s.buffer)) F(boost::forward<A>(a)); }
+#else
+      static void create(small_function_storage& s, F const& f)
+      { ::new (static_cast<void*>(s.buffer)) F(f); }
+      static void create(small_function_storage& s, BOOST_THREAD_RV_REF(F) f)
+      { ::new (static_cast<void*>(s.buffer)) F(boost::move(f)); }
+#endif
+
+      static void call(small_function_storage& s)
+      { get(s)(); }
+      static void move(small_function_storage& dst, small_function_storage& src)
+      {
+        ::new (static_cast<void*>(dst.buffer)) F(boost::move(get(src)));
+        get(src).~F();
+      }
+      static void destroy(small_function_storage& s)
+      { get(s).~F(); }
+
+      static const small_function_vtable* vtable() BOOST_NOEXCEPT
+      {
+        static const small_function_vtable vt = { &call, &move, &destroy };
+        return &vt;
+      }
+    };
+
+    template <typename F>
+    struct small_function_manager<F, false>
+    {
+      static F& get(small_function_storage& s) BOOST_NOEXCEPT
+      { return *static_cast<F*>(s.ptr); }
+
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+      template <typename A>
+      static void create(small_function_storage& s, A&& a)
+      { s.ptr = new F(boost::forward<A>(a)); }
+#else
+      static void create(small_function_storage& s, F const& f)
+      { s.ptr = new F(f); }
+      static void create(small_function_storage& s, BOOST_THREAD_RV_REF(F) f)
+      { s.ptr = new F(boost::move(f)); }
+#endif
+
+      static void call(small_function_storage& s)
+      { get(s)(); }
+      static void move(small_function_storage& dst, small_function_storage& src)
+      {
+        dst.ptr = src.ptr;
+        src.ptr = 0;
+      }
+      static void destroy(small_function_storage& s)
+      { delete static_cast<F*>(s.ptr); }
+
+      static const small_function_vtable* vtable() BOOST_NOEXCEPT
+      {
+        static const small_function_vtable vt = { &call, &move, &destroy };
+        return &vt;
+      }
+    };
+
+    /**
+     * Move-only nullary_function<void()>.
+     *
+     * Closures up to BOOST_THREAD_WORK_INLINE_SIZE bytes that are nothrow move constructible
+     * are stored in place, so wrapping them neither allocates nor reference counts.
+     * Larger closures are allocated on the heap.
+     */
+    template <typename F>
+    class small_nullary_function;
+
+    template <>
+    class small_nullary_function<void()>
+    {
+      const small_function_vtable* vtable_;
+      small_function_storage storage_;
+
+      void reset() BOOST_NOEXCEPT
+      {
+        if (vtable_)
+        {
+          vtable_->destroy(storage_);
+          vtable_ = 0;
+        }
+      }
+      void move_from(small_nullary_function& other) BOOST_NOEXCEPT
+      {
+        if (other.vtable_)
+        {
+          other.vtable_->move(storage_, other.storage_);
+          vtable_ = other.vtable_;
+          other.vtable_ = 0;
+        }
+      }
+
+    public:
+      BOOST_THREAD_MOVABLE_ONLY(small_nullary_function)
+
+      explicit small_nullary_function(void (*f)())
+        : vtable_(0)
+      {
+        if (f)
+        {
+          small_function_manager<void (*)()>::create(storage_, f);
+          vtable_ = small_function_manager<void (*)()>::vtable();
+        }
+      }
+
+#ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
+      template<typename F>
+      explicit small_nullary_function(F& f
+                                , typename disable_if<is_same<typename decay<F>::type, small_nullary_function>, int* >::type=0
+                                )
+        : vtable_(0)
+      {
+        small_function_manager<F>::create(storage_, f);
+        vtable_ = small_function_manager<F>::vtable();
+      }
+      template<typename F>
+      small_nullary_function(BOOST_THREAD_RV_REF(F) f
+                       , typename disable_if<is_same<typename decay<F>::type, small_nullary_function>, int* >::type=0
+                       )
+        : vtable_(0)
+      {
+        small_function_manager<F>::create(storage_, boost::move(f));
+        vtable_ = small_function_manager<F>::vtable();
+      }
+#else
+      template<typename F>
+      small_nullary_function(F&& f
+                       , typename disable_if<is_same<typename decay<F>::type, small_nullary_function>, int* >::type=0
+                       )
+        : vtable_(0)
+      {
+        typedef typename decay<F>::type closure_type;
+        small_function_manager<closure_type>::create(storage_, boost::forward<F>(f));
+        vtable_ = small_function_manager<closure_type>::vtable();
+      }
+#endif
+
+      small_nullary_function() BOOST_NOEXCEPT
+        : vtable_(0)
+      {
+      }
+      small_nullary_function(BOOST_THREAD_RV_REF(small_nullary_function) other) BOOST_NOEXCEPT
+        : vtable_(0)
+      {
+        move_from(BOOST_THREAD_RV(other));
+      }
+      ~small_nullary_function()
+      {
+        reset();
+      }
+
+      small_nullary_function& operator=(BOOST_THREAD_RV_REF(small_nullary_function) other) BOOST_NOEXCEPT
+      {
+        if (this != &BOOST_THREAD_RV(other))
+        {
+          reset();
+          move_from(BOOST_THREAD_RV(other));
+        }
+        return *this;
+      }
+
+      void operator()()
+      { if (vtable_) vtable_->call(storage_); }
+
+    };
+  }
+  BOOST_THREAD_DCL_MOVABLE_BEG(F) detail::small_nullary_function<F> BOOST_THREAD_DCL_MOVABLE_END
+}
+
+#endif // header
@@ -81,6 +81,15 @@ namespace boost
             return new_thread.release();
         }
 
+        template<typename F>
+        thread* create_thread(thread::attributes const& attrs, F threadfunc)
+        {
+            boost::lock_guard<shared_mutex> guard(m);
+            boost::csbl::unique_ptr<thread> new_thread(new thread(attrs, threadfunc));
+            threads.push_back(new_thread.get());
+            return new_thread.release();
+        }
+
         void add_thread(thread* thrd)
         {
             if(thrd)
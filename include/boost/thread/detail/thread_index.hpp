@@ -0,0 +1,34 @@
+#ifndef BOOST_THREAD_DETAIL_THREAD_INDEX_HPP
+#define BOOST_THREAD_DETAIL_THREAD_INDEX_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/atomic.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace thread_detail
+  {
+    // A small number identifying the calling thread, handed out in turn to the threads asking for one,
+    // so that threads started together get consecutive indexes.
+    inline unsigned thread_index()
+    {
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+      static atomic<unsigned> next(0);
+      static thread_local unsigned const index = next.fetch_add(1, memory_order_relaxed);
+      return index;
+#else
+      return static_cast<unsigned>(hash_value(this_thread::get_id()));
+#endif
+    }
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
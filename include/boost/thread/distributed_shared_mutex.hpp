@@ -0,0 +1,362 @@
+#ifndef BOOST_THREAD_DISTRIBUTED_SHARED_MUTEX_HPP
+#define BOOST_THREAD_DISTRIBUTED_SHARED_MUTEX_HPP
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/detail/thread_index.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/lockable_traits.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread_only.hpp>
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#endif
+#include <boost/atomic.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  /**
+   * A shared_mutex for data read very often and written rarely.
+   *
+   * The shared owners only change the counter of their own slot, each on its own cache line, so that
+   * readers on different CPUs don't share any cache line while no thread wants the exclusive ownership.
+   * The threads get their slot in turn, and share it once there are more threads than slots.
+   *
+   * The exclusive owner sets the writer flag, which sends the new readers to the mutex and the
+   * condition variable, and then waits for the counters of all the slots to drop to zero. Taking the
+   * exclusive ownership costs therefore a pass over all the slots.
+   *
+   * It meets the SharedLockable and TimedLockable requirements, and the UpgradeLockable ones except
+   * for the conversions from the shared ownership. A thread owning it shared must release it from
+   * the same thread.
+   */
+  class distributed_shared_mutex
+  {
+    struct slot
+    {
+      atomic<unsigned> readers;
+      char pad_[BOOST_THREAD_CACHE_LINE_SIZE - sizeof(atomic<unsigned>)];
+
+      slot() : readers(0) {}
+    };
+
+    boost::scoped_array<slot> slots_;
+    unsigned mask_;
+    // Set while a thread owns or is taking the exclusive ownership.
+    atomic<bool> writer_;
+    mutex mtx_;
+    condition_variable cond_;
+    // Whether a thread owns it exclusively or with the upgrade ownership. Protected by mtx_.
+    bool owned_;
+
+    void init(unsigned hint)
+    {
+      unsigned n = 1;
+      while (n < hint && n < 256) n *= 2;
+      slots_.reset(new slot[n]);
+      mask_ = n - 1;
+    }
+
+    atomic<unsigned>& my_readers()
+    {
+      return slots_[thread_detail::thread_index() & mask_].readers;
+    }
+
+    bool no_readers() const
+    {
+      for (unsigned i = 0; i <= mask_; ++i)
+      {
+        if (slots_[i].readers.load() != 0) return false;
+      }
+      return true;
+    }
+    bool no_writer() const
+    {
+      return ! writer_.load();
+    }
+    bool not_owned() const
+    {
+      return ! owned_;
+    }
+
+    // Tells a thread waiting for the readers to leave that the calling one left.
+    void notify_writer()
+    {
+      if (writer_.load())
+      {
+        lock_guard<mutex> lk(mtx_);
+        cond_.notify_all();
+      }
+    }
+
+    void release_writer(unique_lock<mutex>&)
+    {
+      writer_.store(false);
+      cond_.notify_all();
+    }
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(distributed_shared_mutex)
+
+    /**
+     * Effects: Constructs a mutex with a slot per hardware thread, up to 256.
+     */
+    distributed_shared_mutex() :
+      writer_(false),
+      owned_(false)
+    {
+      init(thread::hardware_concurrency());
+    }
+
+    /**
+     * Effects: Constructs a mutex with at least n slots, rounded up to a power of two, up to 256.
+     */
+    explicit distributed_shared_mutex(unsigned n) :
+      writer_(false),
+      owned_(false)
+    {
+      init(n);
+    }
+
+    // Shared ownership
+
+    bool try_lock_shared()
+    {
+      atomic<unsigned>& readers = my_readers();
+      readers.fetch_add(1);
+      if (! writer_.load()) return true;
+      readers.fetch_sub(1);
+      notify_writer();
+      return false;
+    }
+
+    void lock_shared()
+    {
+      while (! try_lock_shared())
+      {
+        unique_lock<mutex> lk(mtx_);
+        cond_.wait(lk, boost::bind(&distributed_shared_mutex::no_writer, this));
+      }
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_shared_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_shared_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      while (! try_lock_shared())
+      {
+        unique_lock<mutex> lk(mtx_);
+        if (! cond_.wait_until(lk, abs_time, boost::bind(&distributed_shared_mutex::no_writer, this)))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+#endif
+
+    void unlock_shared()
+    {
+      my_readers().fetch_sub(1);
+      notify_writer();
+    }
+
+    // Exclusive ownership
+
+    bool try_lock()
+    {
+      unique_lock<mutex> lk(mtx_);
+      if (owned_) return false;
+      writer_.store(true);
+      if (! no_readers())
+      {
+        release_writer(lk);
+        return false;
+      }
+      owned_ = true;
+      return true;
+    }
+
+    void lock()
+    {
+      unique_lock<mutex> lk(mtx_);
+      cond_.wait(lk, boost::bind(&distributed_shared_mutex::not_owned, this));
+      owned_ = true;
+      writer_.store(true);
+      cond_.wait(lk, boost::bind(&distributed_shared_mutex::no_readers, this));
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      unique_lock<mutex> lk(mtx_);
+      if (! cond_.wait_until(lk, abs_time, boost::bind(&distributed_shared_mutex::not_owned, this)))
+      {
+        return false;
+      }
+      owned_ = true;
+      writer_.store(true);
+      if (! cond_.wait_until(lk, abs_time, boost::bind(&distributed_shared_mutex::no_readers, this)))
+      {
+        owned_ = false;
+        release_writer(lk);
+        return false;
+      }
+      return true;
+    }
+#endif
+
+    void unlock()
+    {
+      unique_lock<mutex> lk(mtx_);
+      owned_ = false;
+      release_writer(lk);
+    }
+
+    // Upgrade ownership: excludes the exclusive and the other upgrade owners, not the readers.
+
+    bool try_lock_upgrade()
+    {
+      lock_guard<mutex> lk(mtx_);
+      if (owned_) return false;
+      owned_ = true;
+      return true;
+    }
+
+    void lock_upgrade()
+    {
+      unique_lock<mutex> lk(mtx_);
+      cond_.wait(lk, boost::bind(&distributed_shared_mutex::not_owned, this));
+      owned_ = true;
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_upgrade_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_upgrade_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_upgrade_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      unique_lock<mutex> lk(mtx_);
+      if (! cond_.wait_until(lk, abs_time, boost::bind(&distributed_shared_mutex::not_owned, this)))
+      {
+        return false;
+      }
+      owned_ = true;
+      return true;
+    }
+#endif
+
+    void unlock_upgrade()
+    {
+      lock_guard<mutex> lk(mtx_);
+      owned_ = false;
+      cond_.notify_all();
+    }
+
+    // Upgrade <-> Exclusive
+
+    void unlock_upgrade_and_lock()
+    {
+      unique_lock<mutex> lk(mtx_);
+      writer_.store(true);
+      cond_.wait(lk, boost::bind(&distributed_shared_mutex::no_readers, this));
+    }
+
+    bool try_unlock_upgrade_and_lock()
+    {
+      unique_lock<mutex> lk(mtx_);
+      writer_.store(true);
+      if (! no_readers())
+      {
+        release_writer(lk);
+        return false;
+      }
+      return true;
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_unlock_upgrade_and_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_unlock_upgrade_and_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_unlock_upgrade_and_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      unique_lock<mutex> lk(mtx_);
+      writer_.store(true);
+      if (! cond_.wait_until(lk, abs_time, boost::bind(&distributed_shared_mutex::no_readers, this)))
+      {
+        release_writer(lk);
+        return false;
+      }
+      return true;
+    }
+#endif
+
+    void unlock_and_lock_upgrade()
+    {
+      unique_lock<mutex> lk(mtx_);
+      release_writer(lk);
+    }
+
+    // Shared <-> Exclusive and Upgrade
+
+    void unlock_and_lock_shared()
+    {
+      my_readers().fetch_add(1);
+      unlock();
+    }
+
+    void unlock_upgrade_and_lock_shared()
+    {
+      my_readers().fetch_add(1);
+      unlock_upgrade();
+    }
+  };
+
+#ifdef BOOST_THREAD_NO_AUTO_DETECT_MUTEX_TYPES
+  namespace sync
+  {
+    template<>
+    struct is_basic_lockable<distributed_shared_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+    template<>
+    struct is_lockable<distributed_shared_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+  }
+#endif
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -18,8 +18,11 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/concurrent_queues/sync_queue.hpp>
 #include <boost/thread/executors/work.hpp>
+#include <boost/thread/executors/thread_pinning.hpp>
 #include <boost/thread/csbl/vector.hpp>
 
+#include <boost/bind/bind.hpp>
+
 #include <boost/config/abi_prefix.hpp>
 
 namespace boost
@@ -159,6 +162,32 @@ namespace executors
         throw;
       }
     }
+    /**
+     * \b Effects: creates a thread pool that runs closures on \c thread_count threads created with the
+     * given attributes, e.g. to bound their stack size, each thread being restricted to one core, or to
+     * the CPUs of one NUMA node, in turn when pinning is requested.
+     *
+     * \b Throws: Whatever exception is thrown while initializing the needed resources.
+     */
+    basic_thread_pool(unsigned const thread_count, thread::attributes const& attrs,
+        BOOST_SCOPED_ENUM(thread_pinning) pinning = thread_pinning::none)
+    {
+      try
+      {
+        std::vector<thread::attributes> const pinned = detail::pinned_attributes(attrs, pinning);
+        threads.reserve(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+          thread th (detail::pinned_attributes_of(pinned, attrs, i), boost::bind(&basic_thread_pool::worker_thread, this));
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+    }
     /**
      * \b Effects: creates a thread pool that runs closures on \c thread_count threads
      * and executes the at_thread_entry function at the entry of each created thread. .
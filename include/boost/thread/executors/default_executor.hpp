@@ -0,0 +1,96 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_THREAD_EXECUTORS_DEFAULT_EXECUTOR_HPP
+#define BOOST_THREAD_EXECUTORS_DEFAULT_EXECUTOR_HPP
+
+#include <boost/thread/detail/config.hpp>
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION && defined BOOST_THREAD_PROVIDES_EXECUTORS && defined BOOST_THREAD_USES_MOVE
+
+#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <boost/thread/executors/executor_adaptor.hpp>
+#include <boost/thread/thread_only.hpp>
+
+#include <cstddef>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace executors
+{
+namespace detail
+{
+  struct default_executor_parameters
+  {
+    unsigned thread_count;
+    std::size_t stack_size;
+    bool created;
+  };
+
+  inline default_executor_parameters& default_executor_params()
+  {
+    static default_executor_parameters params =
+    {
+      BOOST_THREAD_DEFAULT_EXECUTOR_THREADS,
+      BOOST_THREAD_DEFAULT_EXECUTOR_STACK_SIZE,
+      false
+    };
+    return params;
+  }
+
+  inline executor* make_default_executor()
+  {
+    default_executor_parameters& params = default_executor_params();
+    params.created = true;
+    unsigned thread_count = params.thread_count;
+    if (thread_count == 0) thread_count = thread::hardware_concurrency();
+    if (thread_count == 0) thread_count = 1;
+    thread::attributes attrs;
+    attrs.set_stack_size(params.stack_size);
+    thread::attributes const& cattrs = attrs;
+    return new executor_adaptor<basic_thread_pool>(thread_count, cattrs);
+  }
+}
+
+  /**
+   * \b Effects: Sets the number of threads and the stack size of the default executor, 0 meaning one
+   * thread per hardware thread and the platform stack size respectively.
+   *
+   * \b Returns: false, doing nothing, when the default executor has already been created.
+   *
+   * \b Requires: No other thread is using the default executor.
+   */
+  inline bool set_default_executor_parameters(unsigned thread_count, std::size_t stack_size = 0)
+  {
+    detail::default_executor_parameters& params = detail::default_executor_params();
+    if (params.created) return false;
+    params.thread_count = thread_count;
+    params.stack_size = stack_size;
+    return true;
+  }
+
+  /**
+   * \b Returns: The thread pool shared by the whole process, on which launch::pool runs the asynchronous
+   * functions and the continuations.
+   *
+   * It is created on the first call, with BOOST_THREAD_DEFAULT_EXECUTOR_THREADS threads of
+   * BOOST_THREAD_DEFAULT_EXECUTOR_STACK_SIZE bytes unless set_default_executor_parameters has been
+   * called before. It is never destroyed, so that it can be used until the end of the program.
+   */
+  inline executor& default_executor()
+  {
+    static executor* ex = detail::make_default_executor();
+    return *ex;
+  }
+
+} // executors
+using executors::default_executor;
+using executors::set_default_executor_parameters;
+} // boost
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+#endif
@@ -9,6 +9,7 @@
 #define BOOST_THREAD_EXECUTORS_DETAIL_SCHEDULED_EXECUTOR_BASE_HPP
 
 #include <boost/thread/concurrent_queues/sync_timed_queue.hpp>
+#include <boost/thread/concurrent_queues/sync_timing_wheel_queue.hpp>
 #include <boost/thread/executors/detail/priority_executor_base.hpp>
 #include <boost/thread/executors/work.hpp>
 #include <boost/thread/thread.hpp>
@@ -24,8 +25,12 @@ namespace executors
 {
 namespace detail
 {
-  template <class Clock=chrono::steady_clock>
-  class scheduled_executor_base : public priority_executor_base<concurrent::sync_timed_queue<executors::work_pq, Clock  > >
+  /**
+   * Queue is the timed queue storing the delayed work: sync_timed_queue<work_pq, Clock> or
+   * sync_timing_wheel_queue<work_pq, Clock>.
+   */
+  template <class Clock=chrono::steady_clock, class Queue=concurrent::sync_timed_queue<executors::work_pq, Clock> >
+  class scheduled_executor_base : public priority_executor_base<Queue>
   {
   public:
     typedef executors::work_pq work;
@@ -45,14 +50,18 @@ namespace detail
       }
     }
 
-    void submit_at(work w, const time_point& tp)
+    /**
+     * \b Returns: a handle cancelling the work, which is then destroyed at once, as long as it has not
+     * been pulled by a worker.
+     */
+    timer_handle submit_at(work w, const time_point& tp)
     {
-      this->_workq.push(boost::move(w), tp);
+      return this->_workq.push(boost::move(w), tp);
     }
 
-    void submit_after(work w, const duration& dura)
+    timer_handle submit_after(work w, const duration& dura)
     {
-      this->_workq.push(boost::move(w), dura+clock::now());
+      return this->_workq.push(boost::move(w), dura+clock::now());
     }
 
   }; //end class
@@ -12,19 +12,26 @@
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION && defined BOOST_THREAD_PROVIDES_EXECUTORS && defined BOOST_THREAD_USES_MOVE
 
 #include <boost/thread/executors/detail/scheduled_executor_base.hpp>
+#include <boost/thread/executors/thread_pinning.hpp>
 
 namespace boost
 {
 namespace executors
 {
 
-  class scheduled_thread_pool : public detail::scheduled_executor_base<>
+  /**
+   * Thread pool running the work at/after a given time point/duration.
+   *
+   * TimedQueue is the timed queue storing the delayed work, e.g. sync_timing_wheel_queue<work_pq>.
+   */
+  template <class TimedQueue = concurrent::sync_timed_queue<work_pq> >
+  class basic_scheduled_thread_pool : public detail::scheduled_executor_base<typename TimedQueue::clock, TimedQueue>
   {
   private:
     thread_group _workers;
   public:
 
-    scheduled_thread_pool(size_t num_threads) : super()
+    basic_scheduled_thread_pool(size_t num_threads) : super()
     {
       for(size_t i = 0; i < num_threads; i++)
       {
@@ -32,7 +39,21 @@ namespace executors
       }
     }
 
-    ~scheduled_thread_pool()
+    /**
+     * \b Effects: creates a pool of \c num_threads threads created with the given attributes, each thread
+     * being restricted to one core, or to the CPUs of one NUMA node, in turn when pinning is requested.
+     */
+    basic_scheduled_thread_pool(size_t num_threads, thread::attributes const& attrs,
+        BOOST_SCOPED_ENUM(thread_pinning) pinning = thread_pinning::none) : super()
+    {
+      std::vector<thread::attributes> const pinned = detail::pinned_attributes(attrs, pinning);
+      for(size_t i = 0; i < num_threads; i++)
+      {
+        _workers.create_thread(detail::pinned_attributes_of(pinned, attrs, i), bind(&super::loop, this));
+      }
+    }
+
+    ~basic_scheduled_thread_pool()
     {
       this->close();
       _workers.interrupt_all();
@@ -40,11 +61,30 @@ namespace executors
     }
 
   private:
-    typedef detail::scheduled_executor_base<> super;
+    typedef detail::scheduled_executor_base<typename TimedQueue::clock, TimedQueue> super;
+  }; //end class
+
+  /**
+   * The basic_scheduled_thread_pool storing the delayed work in a sync_timed_queue. A class rather
+   * than a typedef, so that it can still be forward declared.
+   */
+  class scheduled_thread_pool : public basic_scheduled_thread_pool<>
+  {
+  public:
+    scheduled_thread_pool(size_t num_threads) : basic_scheduled_thread_pool<>(num_threads)
+    {
+    }
+
+    scheduled_thread_pool(size_t num_threads, thread::attributes const& attrs,
+        BOOST_SCOPED_ENUM(thread_pinning) pinning = thread_pinning::none)
+    : basic_scheduled_thread_pool<>(num_threads, attrs, pinning)
+    {
+    }
   }; //end class
 
 } //end executors namespace
 
+using executors::basic_scheduled_thread_pool;
 using executors::scheduled_thread_pool;
 
 } //end boost
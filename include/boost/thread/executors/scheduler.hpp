@@ -222,11 +222,12 @@ namespace boost
     /// A @c Scheduler using a specific thread. Note that a Scheduler is not an Executor.
     /// It provides factory helper functions such as at/after that convert a @c Scheduler into an @c Executor
     /// that submit the work at/after a specific time/duration respectively.
-    template <class Clock = chrono::steady_clock>
-    class scheduler : public detail::scheduled_executor_base<Clock>
+    /// @c TimedQueue is the timed queue storing the delayed work, e.g. @c sync_timing_wheel_queue<work_pq,Clock>.
+    template <class Clock = chrono::steady_clock, class TimedQueue = concurrent::sync_timed_queue<work_pq, Clock> >
+    class scheduler : public detail::scheduled_executor_base<Clock, TimedQueue>
     {
     public:
-      typedef typename detail::scheduled_executor_base<Clock>::work work;
+      typedef typename detail::scheduled_executor_base<Clock, TimedQueue>::work work;
 
       typedef Clock clock;
 
@@ -259,7 +260,7 @@ namespace boost
       }
 
     private:
-      typedef detail::scheduled_executor_base<Clock> super;
+      typedef detail::scheduled_executor_base<Clock, TimedQueue> super;
       thread thr;
     };
 
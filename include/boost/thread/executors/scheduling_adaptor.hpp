@@ -22,8 +22,11 @@ namespace boost
 namespace executors
 {
 
-  template <typename Executor>
-  class scheduling_adaptor : public detail::scheduled_executor_base<>
+  /**
+   * TimedQueue is the timed queue storing the delayed work, e.g. sync_timing_wheel_queue<work_pq>.
+   */
+  template <typename Executor, class TimedQueue = concurrent::sync_timed_queue<work_pq> >
+  class scheduling_adaptor : public detail::scheduled_executor_base<typename TimedQueue::clock, TimedQueue>
   {
   private:
     Executor& _exec;
@@ -48,7 +51,7 @@ namespace executors
     }
 
   private:
-    typedef detail::scheduled_executor_base<> super;
+    typedef detail::scheduled_executor_base<typename TimedQueue::clock, TimedQueue> super;
   }; //end class
 
 } //end executors
@@ -0,0 +1,70 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_THREAD_EXECUTORS_THREAD_PINNING_HPP
+#define BOOST_THREAD_EXECUTORS_THREAD_PINNING_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/cpu_topology.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/core/scoped_enum.hpp>
+
+#include <vector>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace executors
+{
+  /**
+   * How the threads of a pool are restricted to the CPUs: not at all, each thread to the CPUs of one
+   * core, or each thread to the CPUs of one NUMA node, the cores and nodes being used in turn.
+   */
+  BOOST_SCOPED_ENUM_DECLARE_BEGIN(thread_pinning)
+  {
+    none,
+    per_core,
+    per_node
+  }
+  BOOST_SCOPED_ENUM_DECLARE_END(thread_pinning)
+
+namespace detail
+{
+  /**
+   * The attributes of the pool threads, one set per core or node, the threads being created with them in
+   * turn. Empty, the attrs being used as they are, when the threads aren't pinned or the platform doesn't
+   * describe its cores or nodes.
+   */
+  inline std::vector<thread::attributes> pinned_attributes(thread::attributes const& attrs, BOOST_SCOPED_ENUM(thread_pinning) pinning)
+  {
+    std::vector<thread::attributes> pinned;
+#if defined BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_AFFINITY
+    if (pinning != thread_pinning::none)
+    {
+      std::vector<std::vector<unsigned> > const groups =
+          (pinning == thread_pinning::per_core) ? boost::detail::cpus_by_core() : boost::detail::cpus_by_node();
+      for (std::size_t i = 0; i < groups.size(); ++i)
+      {
+        pinned.push_back(attrs);
+        pinned.back().set_affinity(groups[i]);
+      }
+    }
+#endif
+    return pinned;
+  }
+
+  inline thread::attributes const& pinned_attributes_of(std::vector<thread::attributes> const& pinned,
+      thread::attributes const& attrs, std::size_t index)
+  {
+    return pinned.empty() ? attrs : pinned[index % pinned.size()];
+  }
+}
+
+} // executors
+} // boost
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
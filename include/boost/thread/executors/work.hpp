@@ -11,16 +11,23 @@
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION && defined BOOST_THREAD_PROVIDES_EXECUTORS && defined BOOST_THREAD_USES_MOVE
 
 #include <boost/thread/detail/nullary_function.hpp>
+#include <boost/thread/detail/small_nullary_function.hpp>
 #include <boost/thread/csbl/functional.hpp>
 
 namespace boost
 {
   namespace executors
   {
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    // move-only, small closures are stored in place
+    typedef detail::small_nullary_function<void()> work;
+#else
+    // the continuations and the queues copy the work when rvalue references are emulated
     typedef detail::nullary_function<void()> work;
+#endif
 
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-    typedef detail::nullary_function<void()> work_pq;
+    typedef detail::small_nullary_function<void()> work_pq;
     //typedef csbl::function<void()> work_pq;
 #else
     typedef csbl::function<void()> work_pq;
@@ -0,0 +1,589 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//    A thread pool where each worker owns a deque of works. Works submitted from a worker
+//    stay in its deque (LIFO for the owner, FIFO for the thieves) and only the works submitted
+//    from other threads go through the shared injection queue.
+
+#ifndef BOOST_THREAD_EXECUTORS_WORK_STEALING_THREAD_POOL_HPP
+#define BOOST_THREAD_EXECUTORS_WORK_STEALING_THREAD_POOL_HPP
+
+#include <boost/thread/detail/config.hpp>
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION && defined BOOST_THREAD_PROVIDES_EXECUTORS && defined BOOST_THREAD_USES_MOVE
+
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/concurrent_queues/queue_op_status.hpp>
+#include <boost/thread/executors/work.hpp>
+#include <boost/thread/executors/thread_pinning.hpp>
+#include <boost/thread/csbl/deque.hpp>
+#include <boost/thread/csbl/vector.hpp>
+#include <boost/thread/csbl/memory/unique_ptr.hpp>
+#if defined BOOST_NO_CXX11_THREAD_LOCAL
+#include <boost/thread/tss.hpp>
+#endif
+#include <boost/atomic.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace executors
+{
+  class work_stealing_thread_pool
+  {
+  public:
+    /// type-erasure to store the works to do
+    typedef  executors::work work;
+  private:
+    typedef thread thread_t;
+    /// A move aware vector type
+    typedef csbl::vector<thread_t> thread_vector;
+
+    /// The deque owned by a worker thread.
+    struct worker_queue
+    {
+      mutex mtx;
+      csbl::deque<work> works;
+    };
+    typedef csbl::vector<csbl::unique_ptr<worker_queue> > worker_queue_vector;
+
+    /// Identifies the pool and the worker the current thread belongs to, if any.
+    struct worker_id
+    {
+      work_stealing_thread_pool* pool;
+      std::size_t index;
+      worker_id() : pool(0), index(0) {}
+    };
+
+    /// A move aware vector
+    thread_vector threads;
+    /// the deques of the worker threads
+    worker_queue_vector worker_queues;
+    /// protects the injection queue and the sleeping workers
+    mutable mutex mtx_;
+    condition_variable not_empty_;
+    /// the works submitted from outside the pool
+    csbl::deque<work> injection_queue;
+    /// set under mtx_, so that the sleeping workers don't miss it, but read without it
+    atomic<bool> closed_;
+    /// number of works stored in the worker deques
+    atomic<std::size_t> local_works_;
+    /// incremented on each submission, the sleeping workers wait for it to change
+    atomic<std::size_t> epoch_;
+    /// number of workers waiting on not_empty_
+    atomic<std::size_t> waiting_;
+
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+    static worker_id& this_worker()
+    {
+      static thread_local worker_id id;
+      return id;
+    }
+#else
+    static worker_id& this_worker()
+    {
+      static thread_specific_ptr<worker_id> id;
+      if (id.get() == 0) id.reset(new worker_id());
+      return *id;
+    }
+#endif
+
+    /**
+     * Returns: the index of the current worker if the current thread is a worker of this pool,
+     * worker_queues.size() otherwise.
+     */
+    std::size_t current_worker_index()
+    {
+      worker_id const& id = this_worker();
+      return id.pool == this ? id.index : worker_queues.size();
+    }
+
+    /**
+     * Effects: pulls the most recently pushed work from the deque of the worker \c i.
+     */
+    bool try_pop_local(std::size_t i, work& task)
+    {
+      worker_queue& q = *worker_queues[i];
+      lock_guard<mutex> lk(q.mtx);
+      if (q.works.empty()) return false;
+      task = boost::move(q.works.back());
+      q.works.pop_back();
+      --local_works_;
+      return true;
+    }
+
+    /**
+     * Effects: pulls the oldest work from the deque of any worker other than \c thief.
+     *
+     * The deques are locked in turn, so that a failure means they were all seen empty and the thief
+     * can sleep until the next submission.
+     */
+    bool try_steal(std::size_t thief, work& task)
+    {
+      std::size_t const n = worker_queues.size();
+      if (local_works_.load(memory_order_relaxed) == 0) return false;
+      for (std::size_t k = 1; k <= n; ++k)
+      {
+        std::size_t const victim = (thief + k) % n;
+        if (victim == thief) continue;
+        worker_queue& q = *worker_queues[victim];
+        lock_guard<mutex> lk(q.mtx);
+        if (q.works.empty()) continue;
+        task = boost::move(q.works.front());
+        q.works.pop_front();
+        --local_works_;
+        return true;
+      }
+      return false;
+    }
+
+    bool try_pull_injected(work& task)
+    {
+      lock_guard<mutex> lk(mtx_);
+      if (injection_queue.empty()) return false;
+      task = boost::move(injection_queue.front());
+      injection_queue.pop_front();
+      return true;
+    }
+
+    /**
+     * Effects: pulls a work, looking first at the own deque, then at the injection queue and
+     * last at the deques of the other workers.
+     */
+    bool try_pull(std::size_t i, work& task)
+    {
+      if (i < worker_queues.size() && try_pop_local(i, task)) return true;
+      if (try_pull_injected(task)) return true;
+      return try_steal(i, task);
+    }
+
+    bool submitted_or_closed(unique_lock<mutex>& , std::size_t epoch)
+    {
+      return epoch_.load() != epoch || closed_.load();
+    }
+
+    /**
+     * Effects: blocks until a work is submitted after \c epoch was read, or the pool is closed.
+     * The works in the deques of the busy workers don't wake the sleeping ones: they have been
+     * looked for since \c epoch was read.
+     * Returns: whether the pool is closed and there are no more works to do.
+     */
+    bool wait_until_submitted_or_closed(std::size_t epoch)
+    {
+      unique_lock<mutex> lk(mtx_);
+      // seq_cst: either the submitter sees the waiter or the waiter sees the new epoch
+      ++waiting_;
+      try
+      {
+        while (! submitted_or_closed(lk, epoch))
+        {
+          not_empty_.wait(lk);
+        }
+      }
+      catch (...)
+      {
+        --waiting_;
+        throw;
+      }
+      --waiting_;
+      return closed_.load() && injection_queue.empty() && local_works_.load() == 0;
+    }
+
+    /**
+     * Effects: wakes a sleeping worker, if any, after a work has been stored. mtx_ is only locked
+     * when a worker sleeps, so that it can't miss the notification.
+     */
+    void notify_work_added()
+    {
+      ++epoch_;
+      if (waiting_.load() != 0)
+      {
+        { lock_guard<mutex> lk(mtx_); }
+        not_empty_.notify_one();
+      }
+    }
+
+    /**
+     * The main loop of the worker threads
+     */
+    void worker_thread(std::size_t i)
+    {
+      this_worker().pool = this;
+      this_worker().index = i;
+      try
+      {
+        for(;;)
+        {
+          work task;
+          try
+          {
+            std::size_t const epoch = epoch_.load();
+            if (try_pull(i, task))
+            {
+              task();
+              continue;
+            }
+            if (wait_until_submitted_or_closed(epoch))
+            {
+              return;
+            }
+          }
+          catch (boost::thread_interrupted&)
+          {
+            return;
+          }
+        }
+      }
+      catch (...)
+      {
+        std::terminate();
+        return;
+      }
+    }
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <class AtThreadEntry>
+    void worker_thread1(std::size_t i, AtThreadEntry& at_thread_entry)
+    {
+      at_thread_entry(*this);
+      worker_thread(i);
+    }
+#endif
+    void worker_thread2(std::size_t i, void(*at_thread_entry)(work_stealing_thread_pool&))
+    {
+      at_thread_entry(*this);
+      worker_thread(i);
+    }
+    template <class AtThreadEntry>
+    void worker_thread3(std::size_t i, BOOST_THREAD_FWD_REF(AtThreadEntry) at_thread_entry)
+    {
+      at_thread_entry(*this);
+      worker_thread(i);
+    }
+
+    void create_worker_queues(unsigned const thread_count)
+    {
+      worker_queues.reserve(thread_count);
+      for (unsigned i = 0; i < thread_count; ++i)
+      {
+        worker_queues.push_back(csbl::unique_ptr<worker_queue>(new worker_queue()));
+      }
+      threads.reserve(thread_count);
+    }
+
+  public:
+    /// work_stealing_thread_pool is not copyable.
+    BOOST_THREAD_NO_COPYABLE(work_stealing_thread_pool)
+
+    /**
+     * \b Effects: creates a thread pool that runs closures on \c thread_count threads.
+     *
+     * \b Throws: Whatever exception is thrown while initializing the needed resources.
+     */
+    work_stealing_thread_pool(unsigned const thread_count = thread::hardware_concurrency()+1)
+    : closed_(false), local_works_(0), epoch_(0), waiting_(0)
+    {
+      try
+      {
+        create_worker_queues(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+          thread th (&work_stealing_thread_pool::worker_thread, this, std::size_t(i));
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+    }
+    /**
+     * \b Effects: creates a thread pool that runs closures on \c thread_count threads created with the
+     * given attributes, each thread being restricted to one core, or to the CPUs of one NUMA node, in turn
+     * when pinning is requested. The queue of each worker is then local to its core or node.
+     *
+     * \b Throws: Whatever exception is thrown while initializing the needed resources.
+     */
+    work_stealing_thread_pool(unsigned const thread_count, thread::attributes const& attrs,
+        BOOST_SCOPED_ENUM(thread_pinning) pinning = thread_pinning::none)
+    : closed_(false), local_works_(0), epoch_(0), waiting_(0)
+    {
+      try
+      {
+        std::vector<thread::attributes> const pinned = detail::pinned_attributes(attrs, pinning);
+        create_worker_queues(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+          thread th (detail::pinned_attributes_of(pinned, attrs, i), boost::bind(&work_stealing_thread_pool::worker_thread, this, std::size_t(i)));
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+    }
+    /**
+     * \b Effects: creates a thread pool that runs closures on \c thread_count threads
+     * and executes the at_thread_entry function at the entry of each created thread. .
+     *
+     * \b Throws: Whatever exception is thrown while initializing the needed resources.
+     */
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <class AtThreadEntry>
+    work_stealing_thread_pool( unsigned const thread_count, AtThreadEntry& at_thread_entry)
+    : closed_(false), local_works_(0), epoch_(0), waiting_(0)
+    {
+      try
+      {
+        create_worker_queues(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+          thread th (&work_stealing_thread_pool::worker_thread1<AtThreadEntry>, this, std::size_t(i), at_thread_entry);
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+    }
+#endif
+    work_stealing_thread_pool( unsigned const thread_count, void(*at_thread_entry)(work_stealing_thread_pool&))
+    : closed_(false), local_works_(0), epoch_(0), waiting_(0)
+    {
+      try
+      {
+        create_worker_queues(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+          thread th (&work_stealing_thread_pool::worker_thread2, this, std::size_t(i), at_thread_entry);
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+    }
+    template <class AtThreadEntry>
+    work_stealing_thread_pool( unsigned const thread_count, BOOST_THREAD_FWD_REF(AtThreadEntry) at_thread_entry)
+    : closed_(false), local_works_(0), epoch_(0), waiting_(0)
+    {
+      try
+      {
+        create_worker_queues(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+        {
+          thread th (&work_stealing_thread_pool::worker_thread3<AtThreadEntry>, this, std::size_t(i), boost::forward<AtThreadEntry>(at_thread_entry));
+          threads.push_back(thread_t(boost::move(th)));
+        }
+      }
+      catch (...)
+      {
+        close();
+        throw;
+      }
+    }
+    /**
+     * \b Effects: Destroys the thread pool.
+     *
+     * \b Synchronization: The completion of all the closures happen before the completion of the \c work_stealing_thread_pool destructor.
+     */
+    ~work_stealing_thread_pool()
+    {
+      // signal to all the worker threads that there will be no more submissions.
+      close();
+      // joins all the threads before destroying the thread pool resources (e.g. the queues).
+      interrupt_and_join();
+    }
+
+    /**
+     * \b Effects: join all the threads.
+     */
+    void join()
+    {
+      for (unsigned i = 0; i < threads.size(); ++i)
+      {
+        threads[i].join();
+      }
+    }
+
+    /**
+     * \b Effects: interrupt all the threads.
+     */
+    void interrupt()
+    {
+      for (unsigned i = 0; i < threads.size(); ++i)
+      {
+        threads[i].interrupt();
+      }
+    }
+
+    /**
+     * \b Effects: interrupt and join all the threads.
+     */
+    void interrupt_and_join()
+    {
+      for (unsigned i = 0; i < threads.size(); ++i)
+      {
+        threads[i].interrupt();
+        threads[i].join();
+      }
+    }
+
+    /**
+     * \b Effects: close the \c work_stealing_thread_pool for submissions.
+     * The worker threads will work until there is no more closures to run.
+     */
+    void close()
+    {
+      {
+        lock_guard<mutex> lk(mtx_);
+        closed_ = true;
+      }
+      not_empty_.notify_all();
+    }
+
+    /**
+     * \b Returns: whether the pool is closed for submissions.
+     */
+    bool closed()
+    {
+      return closed_.load();
+    }
+
+    /**
+     * Effects: try to execute one task.
+     * Returns: whether a task has been executed.
+     * Throws: whatever the current task constructor throws or the task() throws.
+     */
+    bool try_executing_one()
+    {
+      try
+      {
+        work task;
+        if (try_pull(current_worker_index(), task))
+        {
+          task();
+          return true;
+        }
+        return false;
+      }
+      catch (...)
+      {
+        std::terminate();
+        //return false;
+      }
+    }
+    /**
+     * Effects: schedule one task or yields
+     * Throws: whatever the current task constructor throws or the task() throws.
+     */
+    void schedule_one_or_yield()
+    {
+        if ( ! try_executing_one())
+        {
+          this_thread::yield();
+        }
+    }
+
+    /**
+     * \b Requires: \c Closure is a model of \c Callable(void()) and a model of \c CopyConstructible/MoveConstructible.
+     *
+     * \b Effects: The specified \c closure will be scheduled for execution at some point in the future.
+     * When called from one of the worker threads the closure is pushed on the worker's own deque,
+     * otherwise on the shared injection queue.
+     * If invoked closure throws an exception the \c work_stealing_thread_pool will call \c std::terminate, as is the case with threads.
+     *
+     * \b Synchronization: completion of \c closure on a particular thread happens before destruction of thread's thread local variables.
+     *
+     * \b Throws: \c sync_queue_is_closed if the thread pool is closed.
+     * Whatever exception that can be throw while storing the closure.
+     */
+    void submit(BOOST_THREAD_RV_REF(work) closure)
+    {
+      std::size_t const i = current_worker_index();
+      if (i < worker_queues.size())
+      {
+        // Without mtx_: a work pushed by a worker while the pool is being closed is still run, by
+        // that worker at least, before it leaves.
+        if (closed_.load()) BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+        worker_queue& q = *worker_queues[i];
+        {
+          lock_guard<mutex> lk(q.mtx);
+          q.works.push_back(boost::move(closure));
+          ++local_works_;
+        }
+        notify_work_added();
+      }
+      else
+      {
+        unique_lock<mutex> lk(mtx_);
+        if (closed_.load()) BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+        injection_queue.push_back(boost::move(closure));
+        ++epoch_;
+        if (waiting_.load() != 0)
+        {
+          lk.unlock();
+          not_empty_.notify_one();
+        }
+      }
+    }
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <typename Closure>
+    void submit(Closure & closure)
+    {
+      submit(work(closure));
+    }
+#endif
+    void submit(void (*closure)())
+    {
+      submit(work(closure));
+    }
+
+    template <typename Closure>
+    void submit(BOOST_THREAD_FWD_REF(Closure) closure)
+    {
+      work w((boost::forward<Closure>(closure)));
+      submit(boost::move(w));
+    }
+
+    /**
+     * \b Requires: This must be called from an scheduled task.
+     *
+     * \b Effects: reschedule functions until pred()
+     */
+    template <typename Pred>
+    bool reschedule_until(Pred const& pred)
+    {
+      do {
+        if ( ! try_executing_one())
+        {
+          return false;
+        }
+      } while (! pred());
+      return true;
+    }
+
+  };
+}
+using executors::work_stealing_thread_pool;
+
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+#endif
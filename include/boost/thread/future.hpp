@@ -31,6 +31,7 @@ struct shared_state_base {
 #include <boost/thread/detail/invoker.hpp>
 #include <boost/thread/detail/invoke.hpp>
 #include <boost/thread/detail/is_convertible.hpp>
+#include <boost/thread/detail/recycling_allocator.hpp>
 #include <boost/thread/exceptional_ptr.hpp>
 #include <boost/thread/futures/future_error.hpp>
 #include <boost/thread/futures/future_error_code.hpp>
@@ -46,6 +47,7 @@ struct shared_state_base {
 #include <boost/thread/thread_time.hpp>
 #include <boost/thread/executor.hpp>
 #include <boost/thread/executors/generic_executor_ref.hpp>
+#include <boost/thread/executors/default_executor.hpp>
 
 #if defined BOOST_THREAD_FUTURE_USES_OPTIONAL
 #include <boost/optional.hpp>
@@ -54,10 +56,12 @@ struct shared_state_base {
 #endif
 
 #include <boost/assert.hpp>
+#include <boost/atomic.hpp>
 #include <boost/bind/bind.hpp>
 #ifdef BOOST_THREAD_USES_CHRONO
 #include <boost/chrono/system_clocks.hpp>
 #endif
+#include <boost/core/checked_delete.hpp>
 #include <boost/core/enable_if.hpp>
 #include <boost/core/ref.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -157,19 +161,57 @@ namespace boost
             typedef shared_ptr<shared_state_base> continuation_ptr_type;
             typedef std::vector<continuation_ptr_type> continuations_type;
 
+            // The ready bit is set together with done and the waiters bit when a thread waits on waiters, both
+            // under the mutex, so that a ready state is checked and consumed without the mutex and that making
+            // the state ready only notifies when someone waits.
+            BOOST_STATIC_CONSTANT(unsigned, state_ready = 1);
+            BOOST_STATIC_CONSTANT(unsigned, state_has_waiters = 2);
+
+            // The parts of the state that most futures never use: the condition variable of the threads blocked
+            // on it, the wait_for_any waiters, the wait callback, the continuations after the first one and the
+            // executor. They are allocated under the mutex by the first operation that needs them, so that the
+            // common state fits in two cache lines.
+            struct extras_type
+            {
+                boost::condition_variable waiters;
+                waiter_list external_waiters;
+                boost::function<void()> callback;
+                continuations_type continuations;
+                executor_ptr_type ex_;
+
+                static void* operator new(std::size_t size)
+                {
+                    return thread_detail::allocate_recycled(size);
+                }
+                static void operator delete(void* p, std::size_t size)
+                {
+                    thread_detail::deallocate_recycled(p, size);
+                }
+#if defined __cpp_aligned_new
+                static void* operator new(std::size_t size, std::align_val_t al)
+                {
+                    return ::operator new(size, al);
+                }
+                static void operator delete(void* p, std::size_t size, std::align_val_t al)
+                {
+                    ::operator delete(p, size, al);
+                }
+#endif
+            };
+
             boost::exception_ptr exception;
             bool done;
-            bool is_valid_;
+            boost::atomic<bool> is_valid_;
             bool is_deferred_;
             bool is_constructed;
+            boost::atomic<unsigned> state_word;
             launch policy_;
             mutable boost::mutex mutex;
-            boost::condition_variable waiters;
-            waiter_list external_waiters;
-            boost::function<void()> callback;
-            // This declaration should be only included conditionally, but is included to maintain the same layout.
-            continuations_type continuations;
-            executor_ptr_type ex_;
+            // Almost every shared state has at most one continuation, which is stored inline; the extras hold
+            // the ones after the first, attached through shared_futures.
+            continuation_ptr_type first_continuation;
+            // Written once, under the mutex, but read without it by get_executor().
+            boost::atomic<extras_type*> extras_;
 
             // This declaration should be only included conditionally, but is included to maintain the same layout.
             virtual void launch_continuation()
@@ -181,9 +223,10 @@ namespace boost
                 is_valid_(true),
                 is_deferred_(false),
                 is_constructed(false),
+                state_word(0),
                 policy_(launch::none),
-                continuations(),
-                ex_()
+                first_continuation(),
+                extras_(0)
             {}
 
             shared_state_base(exceptional_ptr const& ex):
@@ -192,57 +235,117 @@ namespace boost
                 is_valid_(true),
                 is_deferred_(false),
                 is_constructed(false),
+                state_word(state_ready),
                 policy_(launch::none),
-                continuations(),
-                ex_()
+                first_continuation(),
+                extras_(0)
             {}
 
 
             virtual ~shared_state_base()
             {
+                delete extras_.load(boost::memory_order_relaxed);
             }
 
+            // The shared states are recycled through per-thread free lists. The sized delete gets the
+            // size of the most derived state through the virtual destructor.
+            static void* operator new(std::size_t size)
+            {
+                return thread_detail::allocate_recycled(size);
+            }
+            static void operator delete(void* p, std::size_t size)
+            {
+                thread_detail::deallocate_recycled(p, size);
+            }
+#if defined __cpp_aligned_new
+            // The free lists only give the default new alignment: the states of over-aligned values
+            // aren't recycled.
+            static void* operator new(std::size_t size, std::align_val_t al)
+            {
+                return ::operator new(size, al);
+            }
+            static void operator delete(void* p, std::size_t size, std::align_val_t al)
+            {
+                ::operator delete(p, size, al);
+            }
+#endif
+
             bool is_done()
             {
                 return done;
             }
 
+            bool is_ready() const
+            {
+                return (state_word.load(boost::memory_order_acquire) & state_ready) != 0;
+            }
+
+            // Whether get() and wait() can return without the mutex: the state is ready and waiting has
+            // nothing else to do, as joining the thread of a blocking async future.
+            bool is_ready_to_get() const
+            {
+#ifdef BOOST_THREAD_FUTURE_BLOCKING
+                return false;
+#else
+                return is_ready();
+#endif
+            }
+
+            extras_type& extras()
+            {
+                extras_type* e = extras_.load(boost::memory_order_relaxed);
+                if (! e)
+                {
+                    e = new extras_type();
+                    extras_.store(e, boost::memory_order_release);
+                }
+                return *e;
+            }
+
+            // The extras if they have been allocated, to be called under the mutex.
+            extras_type* allocated_extras() const
+            {
+                return extras_.load(boost::memory_order_relaxed);
+            }
+
+            // Returns the condition variable to wait on.
+            boost::condition_variable& register_waiter(boost::unique_lock<boost::mutex>&)
+            {
+                boost::condition_variable& waiters = extras().waiters;
+                state_word.fetch_or(state_has_waiters, boost::memory_order_relaxed);
+                return waiters;
+            }
+
+            // The executor is set before the state is shared or under the mutex. The extras may be
+            // allocated concurrently by a waiter, hence the acquire.
             executor_ptr_type get_executor()
             {
-              return ex_;
+              extras_type* const e = extras_.load(boost::memory_order_acquire);
+              return e ? e->ex_ : executor_ptr_type();
             }
 
             void set_executor_policy(executor_ptr_type aex)
             {
               set_executor();
-              ex_ = aex;
+              extras().ex_ = aex;
             }
             void set_executor_policy(executor_ptr_type aex, boost::lock_guard<boost::mutex>&)
             {
               set_executor();
-              ex_ = aex;
+              extras().ex_ = aex;
             }
             void set_executor_policy(executor_ptr_type aex, boost::unique_lock<boost::mutex>&)
             {
               set_executor();
-              ex_ = aex;
+              extras().ex_ = aex;
             }
 
-            bool valid(boost::unique_lock<boost::mutex>&) { return is_valid_; }
-            bool valid() {
-              boost::unique_lock<boost::mutex> lk(this->mutex);
-              return valid(lk);
-            }
-            void invalidate(boost::unique_lock<boost::mutex>&) { is_valid_ = false; }
-            void invalidate() {
-              boost::unique_lock<boost::mutex> lk(this->mutex);
-              invalidate(lk);
-            }
-            void validate(boost::unique_lock<boost::mutex>&) { is_valid_ = true; }
-            void validate() {
-              boost::unique_lock<boost::mutex> lk(this->mutex);
-              validate(lk);
-            }
+            bool valid(boost::unique_lock<boost::mutex>&) { return valid(); }
+            bool valid() { return is_valid_.load(boost::memory_order_relaxed); }
+            void invalidate(boost::unique_lock<boost::mutex>&) { invalidate(); }
+            void invalidate() { is_valid_.store(false, boost::memory_order_relaxed); }
+            void validate(boost::unique_lock<boost::mutex>&) { validate(); }
+            void validate() { is_valid_.store(true, boost::memory_order_relaxed); }
 
             void set_deferred()
             {
@@ -269,13 +372,14 @@ namespace boost
             {
                 boost::unique_lock<boost::mutex> lock(this->mutex);
                 do_callback(lock);
+                waiter_list& external_waiters = extras().external_waiters;
                 return external_waiters.insert(external_waiters.end(),&cv);
             }
 
             void unnotify_when_ready(notify_when_ready_handle it)
             {
                 boost::lock_guard<boost::mutex> lock(this->mutex);
-                external_waiters.erase(it);
+                allocated_extras()->external_waiters.erase(it);
             }
 
 #if 0
@@ -285,10 +389,13 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
             void do_continuation(boost::unique_lock<boost::mutex>& lock)
             {
-                if (! continuations.empty()) {
-                  continuations_type the_continuations = continuations;
-                  continuations.clear();
+                if (first_continuation) {
+                  continuation_ptr_type the_continuation;
+                  the_continuation.swap(first_continuation);
+                  continuations_type the_continuations;
+                  if (extras_type* const e = allocated_extras()) the_continuations.swap(e->continuations);
                   relocker rlk(lock);
+                  the_continuation->launch_continuation();
                   for (continuations_type::iterator it = the_continuations.begin(); it != the_continuations.end(); ++it) {
                     (*it)->launch_continuation();
                   }
@@ -305,10 +412,13 @@ namespace boost
 #define BOOST_THREAD_DO_CONTINUATION \
             void do_continuation(boost::unique_lock<boost::mutex>& lock) \
             { \
-                if (! this->continuations.empty()) { \
-                  continuations_type the_continuations = this->continuations; \
-                  this->continuations.clear(); \
+                if (this->first_continuation) { \
+                  continuation_ptr_type the_continuation; \
+                  the_continuation.swap(this->first_continuation); \
+                  continuations_type the_continuations; \
+                  if (extras_type* const e = this->allocated_extras()) the_continuations.swap(e->continuations); \
                   relocker rlk(lock); \
+                  the_continuation->launch_continuation(); \
                   for (continuations_type::iterator it = the_continuations.begin(); it != the_continuations.end(); ++it) { \
                     (*it)->launch_continuation(); \
                   } \
@@ -325,9 +435,13 @@ namespace boost
 #endif
 
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
-            virtual void set_continuation_ptr(continuation_ptr_type continuation, boost::unique_lock<boost::mutex>& lock)
+            virtual void set_continuation_ptr(continuation_ptr_type c, boost::unique_lock<boost::mutex>& lock)
             {
-              continuations.push_back(continuation);
+              if (! first_continuation) {
+                first_continuation.swap(c);
+              } else {
+                extras().continuations.push_back(c);
+              }
               if (done) {
                 do_continuation(lock);
               }
@@ -336,11 +450,18 @@ namespace boost
             void mark_finished_internal(boost::unique_lock<boost::mutex>& lock)
             {
                 done=true;
-                waiters.notify_all();
-                for(waiter_list::const_iterator it=external_waiters.begin(),
-                        end=external_waiters.end();it!=end;++it)
+                const unsigned previous = state_word.exchange(state_ready, boost::memory_order_release);
+                if (extras_type* const e = allocated_extras())
                 {
-                    (*it)->notify_all();
+                    if (previous & state_has_waiters)
+                    {
+                        e->waiters.notify_all();
+                    }
+                    for(waiter_list::const_iterator it=e->external_waiters.begin(),
+                            end=e->external_waiters.end();it!=end;++it)
+                    {
+                        (*it)->notify_all();
+                    }
                 }
                 do_continuation(lock);
             }
@@ -352,9 +473,10 @@ namespace boost
 
             void do_callback(boost::unique_lock<boost::mutex>& lock)
             {
-                if(callback && !done)
+                extras_type* const e = allocated_extras();
+                if(e && e->callback && !done)
                 {
-                    boost::function<void()> local_callback=callback;
+                    boost::function<void()> local_callback=e->callback;
                     relocker relock(lock);
                     local_callback();
                 }
@@ -393,7 +515,10 @@ namespace boost
                 is_deferred_=false;
                 execute(lk);
               }
-              waiters.wait(lk, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
+              if (! done)
+              {
+                register_waiter(lk).wait(lk, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
+              }
               if(rethrow && exception)
               {
                   boost::rethrow_exception(exception);
@@ -407,6 +532,14 @@ namespace boost
 
             void wait(bool rethrow=true)
             {
+                if (is_ready_to_get())
+                {
+                    if(rethrow && exception)
+                    {
+                        boost::rethrow_exception(exception);
+                    }
+                    return;
+                }
                 boost::unique_lock<boost::mutex> lock(this->mutex);
                 wait(lock, rethrow);
             }
@@ -420,7 +553,7 @@ namespace boost
                     return false;
 
                 do_callback(lock);
-                return waiters.timed_wait(lock, rel_time, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
+                return register_waiter(lock).timed_wait(lock, rel_time, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
             }
 
             bool timed_wait_until(boost::system_time const& target_time)
@@ -430,7 +563,7 @@ namespace boost
                     return false;
 
                 do_callback(lock);
-                return waiters.timed_wait(lock, target_time, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
+                return register_waiter(lock).timed_wait(lock, target_time, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
             }
 #endif
 #ifdef BOOST_THREAD_USES_CHRONO
@@ -439,11 +572,13 @@ namespace boost
             future_status
             wait_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
+              if (is_ready_to_get())
+                  return future_status::ready;
               boost::unique_lock<boost::mutex> lock(this->mutex);
               if (is_deferred_)
                   return future_status::deferred;
               do_callback(lock);
-              if(!waiters.wait_until(lock, abs_time, boost::bind(&shared_state_base::is_done, boost::ref(*this))))
+              if(!register_waiter(lock).wait_until(lock, abs_time, boost::bind(&shared_state_base::is_done, boost::ref(*this))))
               {
                   return future_status::timeout;
               }
@@ -487,8 +622,7 @@ namespace boost
 
             bool has_value() const
             {
-                boost::lock_guard<boost::mutex> lock(this->mutex);
-                return done && ! exception;
+                return is_ready() && ! exception;
             }
 
             bool has_value(unique_lock<boost::mutex>& )  const
@@ -498,8 +632,7 @@ namespace boost
 
             bool has_exception()  const
             {
-                boost::lock_guard<boost::mutex> lock(this->mutex);
-                return done && exception;
+                return is_ready() && exception;
             }
 
             launch launch_policy(boost::unique_lock<boost::mutex>&) const
@@ -520,8 +653,7 @@ namespace boost
             }
             future_state::state get_state() const
             {
-                boost::lock_guard<boost::mutex> guard(this->mutex);
-                if(!done)
+                if(!is_ready())
                 {
                     return future_state::waiting;
                 }
@@ -542,7 +674,7 @@ namespace boost
             void set_wait_callback(F f,U* u)
             {
                 boost::lock_guard<boost::mutex> lock(this->mutex);
-                callback=boost::bind(f,boost::ref(*u));
+                extras().callback=boost::bind(f,boost::ref(*u));
             }
 
             virtual void execute(boost::unique_lock<boost::mutex>&) {}
@@ -552,6 +684,14 @@ namespace boost
             shared_state_base& operator=(shared_state_base const&);
         };
 
+        // Shares a shared state allocated with its operator new, allocating the control block from the
+        // same per-thread free lists.
+        template <typename S>
+        shared_ptr<S> share_state(S* s)
+        {
+            return shared_ptr<S>(s, boost::checked_deleter<S>(), thread_detail::recycling_allocator<S>());
+        }
+
         // Used to create stand-alone futures
         template<typename T>
         struct shared_state:
@@ -654,6 +794,11 @@ namespace boost
             }
             move_dest_type get()
             {
+                if (this->is_ready_to_get())
+                {
+                    this->wait(true);
+                    return boost::move(*result);
+                }
                 boost::unique_lock<boost::mutex> lk(this->mutex);
                 return this->get(lk);
             }
@@ -664,6 +809,11 @@ namespace boost
             }
             shared_future_get_result_type get_sh()
             {
+                if (this->is_ready_to_get())
+                {
+                    this->wait(true);
+                    return *result;
+                }
                 boost::unique_lock<boost::mutex> lk(this->mutex);
                 return this->get_sh(lk);
             }
@@ -793,6 +943,11 @@ namespace boost
             }
             T& get()
             {
+                if (this->is_ready_to_get())
+                {
+                    this->wait(true);
+                    return *result;
+                }
                 boost::unique_lock<boost::mutex> lk(this->mutex);
                 return get(lk);
             }
@@ -804,6 +959,11 @@ namespace boost
             }
             T& get_sh()
             {
+                if (this->is_ready_to_get())
+                {
+                    this->wait(true);
+                    return *result;
+                }
                 boost::unique_lock<boost::mutex> lock(this->mutex);
                 return get_sh(lock);
             }
@@ -869,6 +1029,11 @@ namespace boost
             }
             void get()
             {
+                if (this->is_ready_to_get())
+                {
+                    this->wait(true);
+                    return;
+                }
                 boost::unique_lock<boost::mutex> lock(this->mutex);
                 this->get(lock);
             }
@@ -879,6 +1044,11 @@ namespace boost
             }
             void get_sh()
             {
+                if (this->is_ready_to_get())
+                {
+                    this->wait(true);
+                    return;
+                }
                 boost::unique_lock<boost::mutex> lock(this->mutex);
                 this->get_sh(lock);
             }
@@ -940,7 +1110,7 @@ namespace boost
             join();
 #elif defined BOOST_THREAD_ASYNC_FUTURE_WAITS
             unique_lock<boost::mutex> lk(this->mutex);
-            this->waiters.wait(lk, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
+            this->register_waiter(lk).wait(lk, boost::bind(&shared_state_base::is_done, boost::ref(*this)));
 #endif
           }
 
@@ -1337,7 +1507,7 @@ namespace boost
 
         static //BOOST_CONSTEXPR
         future_ptr make_exceptional_future_ptr(exceptional_ptr const& ex) {
-          return future_ptr(new detail::shared_state<R>(ex));
+          return future_ptr(detail::share_state(new detail::shared_state<R>(ex)));
         }
 
         future_ptr future_;
@@ -1534,6 +1704,15 @@ namespace boost
         template <class Rp, class Fp>
         BOOST_THREAD_FUTURE<Rp>
         make_future_deferred_shared_state(BOOST_THREAD_FWD_REF(Fp) f);
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+        template <class Rp, class Fp, class Allocator>
+        BOOST_THREAD_FUTURE<Rp>
+        make_future_async_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f);
+
+        template <class Rp, class Fp, class Allocator>
+        BOOST_THREAD_FUTURE<Rp>
+        make_future_deferred_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f);
+#endif
 #endif // #if (!defined _MSC_VER || _MSC_VER >= 1400)
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
         template<typename F, typename Rp, typename Fp>
@@ -1574,11 +1753,17 @@ namespace boost
         template<typename Ex, typename F, typename Rp, typename Fp>
         BOOST_THREAD_FUTURE<Rp>
         make_shared_future_executor_continuation_shared_state(Ex& ex, boost::unique_lock<boost::mutex> &lock, F f, BOOST_THREAD_FWD_REF(Fp) c);
-
+  #endif
+#endif
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
         template <class Rp, class Fp, class Executor>
         BOOST_THREAD_FUTURE<Rp>
         make_future_executor_shared_state(Executor& ex, BOOST_THREAD_FWD_REF(Fp) f);
-  #endif
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+        template <class Rp, class Fp, class Allocator, class Executor>
+        BOOST_THREAD_FUTURE<Rp>
+        make_future_executor_shared_state(Allocator const& a, Executor& ex, BOOST_THREAD_FWD_REF(Fp) f);
+#endif
 #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
         template<typename F, typename Rp>
@@ -1670,6 +1855,11 @@ namespace boost
         template <class Rp, class Fp, class Executor>
         friend BOOST_THREAD_FUTURE<Rp>
         detail::make_future_executor_shared_state(Executor& ex, BOOST_THREAD_FWD_REF(Fp) f);
+    #if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+        template <class Rp, class Fp, class Allocator, class Executor>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_executor_shared_state(Allocator const& a, Executor& ex, BOOST_THREAD_FWD_REF(Fp) f);
+    #endif
   #endif
 #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
@@ -1722,6 +1912,15 @@ namespace boost
         template <class Rp, class Fp>
         friend BOOST_THREAD_FUTURE<Rp>
         detail::make_future_deferred_shared_state(BOOST_THREAD_FWD_REF(Fp) f);
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+        template <class Rp, class Fp, class Allocator>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_async_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f);
+
+        template <class Rp, class Fp, class Allocator>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_deferred_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f);
+#endif
 
         typedef typename base_type::move_dest_type move_dest_type;
 
@@ -1794,15 +1993,15 @@ namespace boost
             {
                 boost::throw_exception(future_uninitialized());
             }
-            unique_lock<boost::mutex> lk(this->future_->mutex);
-            if (! this->future_->valid(lk))
+            if (! this->future_->valid())
             {
                 boost::throw_exception(future_uninitialized());
             }
 #ifdef BOOST_THREAD_PROVIDES_FUTURE_INVALID_AFTER_GET
-            this->future_->invalidate(lk);
+            this->future_->invalidate();
 #endif
-            return this->future_->get(lk);
+            // a ready state is consumed without locking its mutex
+            return this->future_->get();
         }
 
         template <typename R2>
@@ -1936,6 +2135,11 @@ namespace boost
             template <class Rp, class Fp, class Executor>
             friend BOOST_THREAD_FUTURE<Rp>
             detail::make_future_executor_shared_state(Executor& ex, BOOST_THREAD_FWD_REF(Fp) f);
+        #if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+            template <class Rp, class Fp, class Allocator, class Executor>
+            friend BOOST_THREAD_FUTURE<Rp>
+            detail::make_future_executor_shared_state(Allocator const& a, Executor& ex, BOOST_THREAD_FWD_REF(Fp) f);
+        #endif
       #endif
 
 #endif
@@ -1990,6 +2194,15 @@ namespace boost
             template <class Rp, class Fp>
             friend BOOST_THREAD_FUTURE<Rp>
             detail::make_future_deferred_shared_state(BOOST_THREAD_FWD_REF(Fp) f);
+    #if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+            template <class Rp, class Fp, class Allocator>
+            friend BOOST_THREAD_FUTURE<Rp>
+            detail::make_future_async_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f);
+
+            template <class Rp, class Fp, class Allocator>
+            friend BOOST_THREAD_FUTURE<Rp>
+            detail::make_future_deferred_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f);
+    #endif
 
             typedef typename base_type::move_dest_type move_dest_type;
 
@@ -2055,15 +2268,15 @@ namespace boost
                 {
                     boost::throw_exception(future_uninitialized());
                 }
-                unique_lock<boost::mutex> lk(this->future_->mutex);
-                if (! this->future_->valid(lk))
+                if (! this->future_->valid())
                 {
                     boost::throw_exception(future_uninitialized());
                 }
     #ifdef BOOST_THREAD_PROVIDES_FUTURE_INVALID_AFTER_GET
-                this->future_->invalidate(lk);
+                this->future_->invalidate();
     #endif
-                return this->future_->get(lk);
+                // a ready state is consumed without locking its mutex
+                return this->future_->get();
             }
             move_dest_type get_or(BOOST_THREAD_RV_REF(R) v) // EXTENSION
             {
@@ -2277,7 +2490,7 @@ namespace boost
           if(!atomic_load(&future_))
             {
                 future_ptr blank;
-                atomic_compare_exchange(&future_,&blank,future_ptr(new detail::shared_state<R>));
+                atomic_compare_exchange(&future_,&blank,future_ptr(detail::share_state(new detail::shared_state<R>)));
             }
 #include <boost/thread/detail/atomic_redef_macros.hpp>
 #endif
@@ -2301,7 +2514,7 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_PROMISE_LAZY
             future_(),
 #else
-            future_(new detail::shared_state<R>()),
+            future_(detail::share_state(new detail::shared_state<R>())),
 #endif
             future_obtained(false)
         {}
@@ -2568,7 +2781,7 @@ namespace boost
             if(!atomic_load(&future_))
             {
                 future_ptr blank;
-                atomic_compare_exchange(&future_,&blank,future_ptr(new detail::shared_state<R&>));
+                atomic_compare_exchange(&future_,&blank,future_ptr(detail::share_state(new detail::shared_state<R&>)));
             }
 #include <boost/thread/detail/atomic_redef_macros.hpp>
 #endif
@@ -2592,7 +2805,7 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_PROMISE_LAZY
             future_(),
 #else
-            future_(new detail::shared_state<R&>()),
+            future_(detail::share_state(new detail::shared_state<R&>())),
 #endif
             future_obtained(false)
         {}
@@ -2750,7 +2963,7 @@ namespace boost
             if(!atomic_load(&future_))
             {
                 future_ptr blank;
-                atomic_compare_exchange(&future_,&blank,future_ptr(new detail::shared_state<void>));
+                atomic_compare_exchange(&future_,&blank,future_ptr(detail::share_state(new detail::shared_state<void>)));
             }
 #endif
         }
@@ -2773,7 +2986,7 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_PROMISE_LAZY
             future_(),
 #else
-            future_(new detail::shared_state<void>),
+            future_(detail::share_state(new detail::shared_state<void>)),
 #endif
             future_obtained(false)
         {}
@@ -3540,7 +3753,7 @@ namespace boost
         {
             typedef R(*FR)(BOOST_THREAD_FWD_REF(ArgTypes)...);
             typedef detail::task_shared_state<FR,R(ArgTypes...)> task_shared_state_type;
-            task= task_ptr(new task_shared_state_type(f, boost::move(args)...));
+            task= task_ptr(detail::share_state(new task_shared_state_type(f, boost::move(args)...)));
             future_obtained=false;
         }
   #else
@@ -3548,7 +3761,7 @@ namespace boost
         {
             typedef R(*FR)();
             typedef detail::task_shared_state<FR,R()> task_shared_state_type;
-            task= task_ptr(new task_shared_state_type(f));
+            task= task_ptr(detail::share_state(new task_shared_state_type(f)));
             future_obtained=false;
         }
   #endif
@@ -3557,7 +3770,7 @@ namespace boost
         {
               typedef R(*FR)();
             typedef detail::task_shared_state<FR,R> task_shared_state_type;
-            task= task_ptr(new task_shared_state_type(f));
+            task= task_ptr(detail::share_state(new task_shared_state_type(f)));
             future_obtained=false;
         }
 #endif
@@ -3578,7 +3791,7 @@ namespace boost
 #else
             typedef detail::task_shared_state<FR,R> task_shared_state_type;
 #endif
-            task = task_ptr(new task_shared_state_type(boost::forward<F>(f)));
+            task = task_ptr(detail::share_state(new task_shared_state_type(boost::forward<F>(f))));
             future_obtained = false;
 
         }
@@ -3598,7 +3811,7 @@ namespace boost
 #else
             typedef detail::task_shared_state<F,R> task_shared_state_type;
 #endif
-            task = task_ptr(new task_shared_state_type(f));
+            task = task_ptr(detail::share_state(new task_shared_state_type(f)));
             future_obtained=false;
         }
         template <class F>
@@ -3607,14 +3820,14 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_SIGNATURE_PACKAGED_TASK
 #if defined(BOOST_THREAD_PROVIDES_VARIADIC_THREAD)
             typedef detail::task_shared_state<F,R(ArgTypes...)> task_shared_state_type;
-            task = task_ptr(new task_shared_state_type(boost::move(f)));
+            task = task_ptr(detail::share_state(new task_shared_state_type(boost::move(f))));
 #else
             typedef detail::task_shared_state<F,R()> task_shared_state_type;
-            task = task_ptr(new task_shared_state_type(boost::move(f)));
+            task = task_ptr(detail::share_state(new task_shared_state_type(boost::move(f))));
 #endif
 #else
             typedef detail::task_shared_state<F,R> task_shared_state_type;
-            task = task_ptr(new task_shared_state_type(boost::move(f)));
+            task = task_ptr(detail::share_state(new task_shared_state_type(boost::move(f))));
 #endif
             future_obtained=false;
 
@@ -3838,7 +4051,7 @@ namespace detail
   BOOST_THREAD_FUTURE<Rp>
   make_future_deferred_shared_state(BOOST_THREAD_FWD_REF(Fp) f) {
     shared_ptr<future_deferred_shared_state<Rp, Fp> >
-        h(new future_deferred_shared_state<Rp, Fp>(boost::forward<Fp>(f)));
+        h(detail::share_state(new future_deferred_shared_state<Rp, Fp>(boost::forward<Fp>(f))));
     return BOOST_THREAD_FUTURE<Rp>(h);
   }
 
@@ -3849,10 +4062,35 @@ namespace detail
   BOOST_THREAD_FUTURE<Rp>
   make_future_async_shared_state(BOOST_THREAD_FWD_REF(Fp) f) {
     shared_ptr<future_async_shared_state<Rp, Fp> >
-        h(new future_async_shared_state<Rp, Fp>());
+        h(detail::share_state(new future_async_shared_state<Rp, Fp>()));
     h->init(boost::forward<Fp>(f));
     return BOOST_THREAD_FUTURE<Rp>(h);
   }
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+  template <class Rp, class Fp, class Allocator>
+  BOOST_THREAD_FUTURE<Rp>
+  make_future_deferred_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f) {
+    typedef future_deferred_shared_state<Rp, Fp> state_type;
+    typedef typename Allocator::template rebind<state_type>::other A2;
+    A2 a2(a);
+    typedef thread_detail::allocator_destructor<A2> D;
+    shared_ptr<state_type> h(::new(a2.allocate(1)) state_type(boost::forward<Fp>(f)), D(a2, 1) );
+    return BOOST_THREAD_FUTURE<Rp>(h);
+  }
+
+  template <class Rp, class Fp, class Allocator>
+  BOOST_THREAD_FUTURE<Rp>
+  make_future_async_shared_state(Allocator const& a, BOOST_THREAD_FWD_REF(Fp) f) {
+    typedef future_async_shared_state<Rp, Fp> state_type;
+    typedef typename Allocator::template rebind<state_type>::other A2;
+    A2 a2(a);
+    typedef thread_detail::allocator_destructor<A2> D;
+    shared_ptr<state_type> h(::new(a2.allocate(1)) state_type(), D(a2, 1) );
+    h->init(boost::forward<Fp>(f));
+    return BOOST_THREAD_FUTURE<Rp>(h);
+  }
+#endif
 }
 
     ////////////////////////////////
@@ -3877,6 +4115,15 @@ namespace detail
                   , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
               )
           ));
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_executor_shared_state<Rp>(executors::default_executor(),
+              BF(
+                  f
+                  , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
+              )
+          ));
+#endif
     } else if (underlying_cast<int>(policy) & int(launch::deferred)) {
       return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_deferred_shared_state<Rp>(
               BF(
@@ -3908,6 +4155,12 @@ namespace detail
       ret.set_async();
       boost::thread( boost::move(pt) ).detach();
       return ::boost::move(ret);
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_executor_shared_state<R>(executors::default_executor(),
+              detail::invoker<R(*)()>(f)
+          ));
+#endif
     } else if (underlying_cast<int>(policy) & int(launch::deferred)) {
       std::terminate();
       //BOOST_THREAD_FUTURE<R> ret;
@@ -3938,6 +4191,15 @@ namespace detail
                 , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
               )
           ));
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_executor_shared_state<Rp>(executors::default_executor(),
+              BF(
+                  thread_detail::decay_copy(boost::forward<F>(f))
+                , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
+              )
+          ));
+#endif
     } else if (underlying_cast<int>(policy) & int(launch::deferred)) {
       return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_deferred_shared_state<Rp>(
               BF(
@@ -3952,6 +4214,45 @@ namespace detail
     }
   }
 
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+  // As async(policy, f, args...), allocating the shared state with the allocator.
+  template <class Allocator, class F, class ...ArgTypes>
+  BOOST_THREAD_FUTURE<typename boost::result_of<typename decay<F>::type(
+      typename decay<ArgTypes>::type...
+  )>::type>
+  async(boost::allocator_arg_t, Allocator const& a, launch policy, BOOST_THREAD_FWD_REF(F) f, BOOST_THREAD_FWD_REF(ArgTypes)... args) {
+    typedef detail::invoker<typename decay<F>::type, typename decay<ArgTypes>::type...> BF;
+    typedef typename BF::result_type Rp;
+
+    if (underlying_cast<int>(policy) & int(launch::async)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_async_shared_state<Rp>(a,
+              BF(
+                  thread_detail::decay_copy(boost::forward<F>(f))
+                , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
+              )
+          ));
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_executor_shared_state<Rp>(a, executors::default_executor(),
+              BF(
+                  thread_detail::decay_copy(boost::forward<F>(f))
+                , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
+              )
+          ));
+#endif
+    } else if (underlying_cast<int>(policy) & int(launch::deferred)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_deferred_shared_state<Rp>(a,
+              BF(
+                  thread_detail::decay_copy(boost::forward<F>(f))
+                , thread_detail::decay_copy(boost::forward<ArgTypes>(args))...
+              )
+          ));
+    } else {
+      std::terminate();
+    }
+  }
+#endif
+
 #else // defined(BOOST_THREAD_PROVIDES_VARIADIC_THREAD)
 
   template <class F>
@@ -3970,6 +4271,12 @@ namespace detail
       ret.set_async();
       boost::thread( boost::move(pt) ).detach();
       return ::boost::move(ret);
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      return BOOST_THREAD_MAKE_RV_REF(boost::detail::make_future_executor_shared_state<R>(executors::default_executor(),
+              detail::invoker<typename decay<F>::type>(thread_detail::decay_copy(boost::forward<F>(f)))
+          ));
+#endif
     } else if (underlying_cast<int>(policy) & int(launch::deferred)) {
       std::terminate();
       //BOOST_THREAD_FUTURE<R> ret;
@@ -4133,10 +4440,24 @@ namespace detail {
     BOOST_THREAD_FUTURE<Rp>
     make_future_executor_shared_state(Executor& ex, BOOST_THREAD_FWD_REF(Fp) f) {
       shared_ptr<future_executor_shared_state<Rp> >
-          h(new future_executor_shared_state<Rp>());
+          h(detail::share_state(new future_executor_shared_state<Rp>()));
+      h->init(ex, boost::forward<Fp>(f));
+      return BOOST_THREAD_FUTURE<Rp>(h);
+    }
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+    template <class Rp, class Fp, class Allocator, class Executor>
+    BOOST_THREAD_FUTURE<Rp>
+    make_future_executor_shared_state(Allocator const& a, Executor& ex, BOOST_THREAD_FWD_REF(Fp) f) {
+      typedef future_executor_shared_state<Rp> state_type;
+      typedef typename Allocator::template rebind<state_type>::other A2;
+      A2 a2(a);
+      typedef thread_detail::allocator_destructor<A2> D;
+      shared_ptr<state_type> h(::new(a2.allocate(1)) state_type(), D(a2, 1) );
       h->init(ex, boost::forward<Fp>(f));
       return BOOST_THREAD_FUTURE<Rp>(h);
     }
+#endif
 
 } // detail
 
@@ -4413,6 +4734,25 @@ namespace detail {
   }
 #endif
 
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+  // As make_ready_future(value) and make_ready_future(), allocating the shared state with the allocator.
+  template <class Allocator, class T>
+  BOOST_THREAD_FUTURE<typename detail::deduced_type<T>::type>
+  make_ready_future(boost::allocator_arg_t, Allocator const& a, BOOST_THREAD_FWD_REF(T) value) {
+    typedef typename detail::deduced_type<T>::type future_value_type;
+    promise<future_value_type> p(boost::allocator_arg, a);
+    p.set_value(boost::forward<T>(value));
+    return BOOST_THREAD_MAKE_RV_REF(p.get_future());
+  }
+
+  template <class Allocator>
+  BOOST_THREAD_FUTURE<void> make_ready_future(boost::allocator_arg_t, Allocator const& a) {
+    promise<void> p(boost::allocator_arg, a);
+    p.set_value();
+    return BOOST_THREAD_MAKE_RV_REF(p.get_future());
+  }
+#endif
+
 
   template <typename T>
   BOOST_THREAD_FUTURE<T> make_exceptional_future(exception_ptr ex) {
@@ -4849,7 +5189,7 @@ namespace detail {
       BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<future_deferred_continuation_shared_state<F, Rp, Cont> >
-        h(new future_deferred_continuation_shared_state<F, Rp, Cont>(boost::move(f), boost::forward<Fp>(c)));
+        h(detail::share_state(new future_deferred_continuation_shared_state<F, Rp, Cont>(boost::move(f), boost::forward<Fp>(c))));
     h->init(lock);
     return BOOST_THREAD_FUTURE<Rp>(h);
   }
@@ -4864,7 +5204,7 @@ namespace detail {
       BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<future_async_continuation_shared_state<F,Rp, Cont> >
-        h(new future_async_continuation_shared_state<F,Rp, Cont>(boost::move(f), boost::forward<Fp>(c)));
+        h(detail::share_state(new future_async_continuation_shared_state<F,Rp, Cont>(boost::move(f), boost::forward<Fp>(c))));
     h->init(lock);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -4879,7 +5219,7 @@ namespace detail {
       BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<future_sync_continuation_shared_state<F,Rp, Cont> >
-        h(new future_sync_continuation_shared_state<F,Rp, Cont>(boost::move(f), boost::forward<Fp>(c)));
+        h(detail::share_state(new future_sync_continuation_shared_state<F,Rp, Cont>(boost::move(f), boost::forward<Fp>(c))));
     h->init(lock);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -4897,7 +5237,7 @@ namespace detail {
       BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<future_executor_continuation_shared_state<F,Rp, Cont> >
-        h(new future_executor_continuation_shared_state<F,Rp, Cont>(boost::move(f), boost::forward<Fp>(c)));
+        h(detail::share_state(new future_executor_continuation_shared_state<F,Rp, Cont>(boost::move(f), boost::forward<Fp>(c))));
     h->init(lock, ex);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -4914,7 +5254,7 @@ namespace detail {
       F f, BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<shared_future_deferred_continuation_shared_state<F, Rp, Cont> >
-        h(new shared_future_deferred_continuation_shared_state<F, Rp, Cont>(f, boost::forward<Fp>(c)));
+        h(detail::share_state(new shared_future_deferred_continuation_shared_state<F, Rp, Cont>(f, boost::forward<Fp>(c))));
     h->init(lock);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -4929,7 +5269,7 @@ namespace detail {
       BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<shared_future_async_continuation_shared_state<F,Rp, Cont> >
-        h(new shared_future_async_continuation_shared_state<F,Rp, Cont>(f, boost::forward<Fp>(c)));
+        h(detail::share_state(new shared_future_async_continuation_shared_state<F,Rp, Cont>(f, boost::forward<Fp>(c))));
     h->init(lock);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -4944,7 +5284,7 @@ namespace detail {
       BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<shared_future_sync_continuation_shared_state<F,Rp, Cont> >
-        h(new shared_future_sync_continuation_shared_state<F,Rp, Cont>(f, boost::forward<Fp>(c)));
+        h(detail::share_state(new shared_future_sync_continuation_shared_state<F,Rp, Cont>(f, boost::forward<Fp>(c))));
     h->init(lock);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -4960,7 +5300,7 @@ namespace detail {
       BOOST_THREAD_FWD_REF(Fp) c) {
     typedef typename decay<Fp>::type Cont;
     shared_ptr<shared_future_executor_continuation_shared_state<F, Rp, Cont> >
-        h(new shared_future_executor_continuation_shared_state<F, Rp, Cont>(f, boost::forward<Fp>(c)));
+        h(detail::share_state(new shared_future_executor_continuation_shared_state<F, Rp, Cont>(f, boost::forward<Fp>(c))));
     h->init(lock, ex);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -5003,6 +5343,12 @@ namespace detail {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_executor_continuation_shared_state<Ex, BOOST_THREAD_FUTURE<R>, future_type>(ex,
                     lock, boost::move(*this), boost::forward<F>(func)
                 )));
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      typedef executor Ex;
+      Ex& ex = executors::default_executor();
+      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_executor_continuation_shared_state<Ex, BOOST_THREAD_FUTURE<R>, future_type>(ex,
+                    lock, boost::move(*this), boost::forward<F>(func)
+                )));
 #endif
     } else if (underlying_cast<int>(policy) & int(launch::inherit)) {
 
@@ -5129,6 +5475,12 @@ namespace detail {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_executor_continuation_shared_state<Ex, BOOST_THREAD_FUTURE<R>, future_type>(ex,
                     lock, boost::move(*this), boost::forward<F>(func)
                 )));
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      typedef executor Ex;
+      Ex& ex = executors::default_executor();
+      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_executor_continuation_shared_state<Ex, BOOST_THREAD_FUTURE<R>, future_type>(ex,
+                    lock, boost::move(*this), boost::forward<F>(func)
+                )));
 #endif
     } else if (underlying_cast<int>(policy) & int(launch::inherit)) {
         launch policy_ = this->launch_policy(lock);
@@ -5255,6 +5607,12 @@ namespace detail {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_shared_future_executor_continuation_shared_state<Ex, shared_future<R>, future_type>(ex,
                     lock, *this, boost::forward<F>(func)
                 )));
+    } else if (underlying_cast<int>(policy) & int(launch::pool)) {
+      typedef executor Ex;
+      Ex& ex = executors::default_executor();
+      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_shared_future_executor_continuation_shared_state<Ex, shared_future<R>, future_type>(ex,
+                    lock, *this, boost::forward<F>(func)
+                )));
 #endif
     } else if (underlying_cast<int>(policy) & int(launch::inherit)) {
 
@@ -5480,7 +5838,7 @@ namespace detail
   BOOST_THREAD_FUTURE<Rp>
   make_future_unwrap_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f) {
     shared_ptr<future_unwrap_shared_state<F, Rp> >
-        h(new future_unwrap_shared_state<F, Rp>(boost::move(f)));
+        h(detail::share_state(new future_unwrap_shared_state<F, Rp>(boost::move(f))));
     h->wrapped.future_->set_continuation_ptr(h, lock);
 
     return BOOST_THREAD_FUTURE<Rp>(h);
@@ -5518,63 +5876,96 @@ namespace detail
   BOOST_CONSTEXPR_OR_CONST vector_tag vector_tag_value = {};
   BOOST_CONSTEXPR_OR_CONST values_tag values_tag_value = {};
   ////////////////////////////////
-  // detail::future_async_when_all_shared_state
+  // detail::future_when_shared_state_base
+  ////////////////////////////////
+  /**
+   * Shared state of when_all/when_any, made ready by the continuations of the futures it waits for so
+   * that no thread is blocked waiting for them.
+   */
+  template<typename Rp>
+  struct future_when_shared_state_base: shared_state<Rp>
+  {
+    typedef csbl::vector<shared_ptr<shared_state_base> > inputs_type;
+
+    /**
+     * Registers this shared state as a continuation of each input, which calls launch_continuation()
+     * at once for the inputs already ready. When an input is not valid the shared state becomes
+     * exceptional and none is registered.
+     *
+     * The inputs are a copy of the shared states of the futures, as the futures can be moved to the
+     * result as soon as the first continuation runs.
+     */
+    void attach(inputs_type const& inputs)
+    {
+      for (std::size_t i = 0; i < inputs.size(); ++i)
+      {
+        if (! inputs[i])
+        {
+          boost::unique_lock<boost::mutex> lk(this->mutex);
+          this->mark_exceptional_finish_internal(boost::copy_exception(future_uninitialized()), lk);
+          return;
+        }
+      }
+      shared_ptr<shared_state_base> that = this->shared_from_this();
+      for (std::size_t i = 0; i < inputs.size(); ++i)
+      {
+        boost::unique_lock<boost::mutex> lk(inputs[i]->mutex);
+        inputs[i]->set_continuation_ptr(that, lk);
+      }
+    }
+  };
+
+  ////////////////////////////////
+  // detail::future_when_all_vector_shared_state
   ////////////////////////////////
   template<typename F>
-  struct future_when_all_vector_shared_state: future_async_shared_state_base<csbl::vector<F> >
+  struct future_when_all_vector_shared_state: future_when_shared_state_base<csbl::vector<F> >
   {
+    typedef future_when_shared_state_base<csbl::vector<F> > base_type;
     typedef csbl::vector<F> vector_type;
     typedef typename F::value_type value_type;
     vector_type vec_;
+    // the number of futures not ready yet
+    boost::atomic<std::size_t> pending_;
 
-    static void run(shared_ptr<boost::detail::shared_state_base> that_) {
-      future_when_all_vector_shared_state* that = static_cast<future_when_all_vector_shared_state*>(that_.get());
-      try {
-        boost::wait_for_all(that->vec_.begin(), that->vec_.end());
-        that->mark_finished_with_result(boost::move(that->vec_));
-      } catch(...) {
-        that->mark_exceptional_finish();
-      }
+    void launch_continuation() {
+      if (pending_.fetch_sub(1, boost::memory_order_acq_rel) != 1) return;
+      boost::unique_lock<boost::mutex> lk(this->mutex);
+      this->mark_finished_with_result_internal(boost::move(vec_), lk);
     }
-    bool run_deferred() {
-
-      bool res = false;
+    void run_deferred() {
       for (typename csbl::vector<F>::iterator it = vec_.begin(); it != vec_.end(); ++it) {
-        if (! it->run_if_is_deferred())
-        {
-          res = true;
-        }
+        it->run_if_is_deferred();
       }
-      return res;
     }
     void init() {
-      if (! run_deferred())
-      {
-        future_when_all_vector_shared_state::run(this->shared_from_this());
-        return;
+      run_deferred();
+      typename base_type::inputs_type inputs;
+      inputs.reserve(vec_.size());
+      for (typename csbl::vector<F>::iterator it = vec_.begin(); it != vec_.end(); ++it) {
+        inputs.push_back(it->future_);
       }
-#ifdef BOOST_THREAD_FUTURE_BLOCKING
-      this->thr_ = boost::thread(&future_when_all_vector_shared_state::run, this->shared_from_this());
-#else
-      boost::thread(&future_when_all_vector_shared_state::run, this->shared_from_this()).detach();
-#endif
+      pending_.store(inputs.size(), boost::memory_order_relaxed);
+      this->attach(inputs);
     }
 
   public:
     template< typename InputIterator>
     future_when_all_vector_shared_state(input_iterator_tag, InputIterator first, InputIterator last)
-    : vec_(std::make_move_iterator(first), std::make_move_iterator(last))
+    : vec_(std::make_move_iterator(first), std::make_move_iterator(last)), pending_(0)
     {
     }
 
     future_when_all_vector_shared_state(vector_tag, BOOST_THREAD_RV_REF(csbl::vector<F>) v)
-    : vec_(boost::move(v))
+    : vec_(boost::move(v)), pending_(0)
     {
     }
 
 #if ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
     template< typename T0, typename ...T>
-    future_when_all_vector_shared_state(values_tag, BOOST_THREAD_FWD_REF(T0) f, BOOST_THREAD_FWD_REF(T) ... futures) {
+    future_when_all_vector_shared_state(values_tag, BOOST_THREAD_FWD_REF(T0) f, BOOST_THREAD_FWD_REF(T) ... futures)
+    : pending_(0)
+    {
       vec_.push_back(boost::forward<T0>(f));
       typename alias_t<char[]>::type{
           ( //first part of magic unpacker
@@ -5588,24 +5979,22 @@ namespace detail
   };
 
   ////////////////////////////////
-  // detail::future_async_when_any_shared_state
+  // detail::future_when_any_vector_shared_state
   ////////////////////////////////
   template<typename F>
-  struct future_when_any_vector_shared_state: future_async_shared_state_base<csbl::vector<F> >
+  struct future_when_any_vector_shared_state: future_when_shared_state_base<csbl::vector<F> >
   {
+    typedef future_when_shared_state_base<csbl::vector<F> > base_type;
     typedef csbl::vector<F> vector_type;
     typedef typename F::value_type value_type;
     vector_type vec_;
+    // set by the first future ready, the only one making the shared state ready
+    boost::atomic<bool> fired_;
 
-    static void run(shared_ptr<boost::detail::shared_state_base> that_)
-    {
-      future_when_any_vector_shared_state* that = static_cast<future_when_any_vector_shared_state*>(that_.get());
-      try {
-        boost::wait_for_any(that->vec_.begin(), that->vec_.end());
-        that->mark_finished_with_result(boost::move(that->vec_));
-      } catch(...) {
-        that->mark_exceptional_finish();
-      }
+    void launch_continuation() {
+      if (fired_.exchange(true, boost::memory_order_acq_rel)) return;
+      boost::unique_lock<boost::mutex> lk(this->mutex);
+      this->mark_finished_with_result_internal(boost::move(vec_), lk);
     }
     bool run_deferred() {
 
@@ -5620,26 +6009,26 @@ namespace detail
     void init() {
       if (run_deferred())
       {
-        future_when_any_vector_shared_state::run(this->shared_from_this());
+        launch_continuation();
         return;
       }
-
-#ifdef BOOST_THREAD_FUTURE_BLOCKING
-      this->thr_ = boost::thread(&future_when_any_vector_shared_state::run, this->shared_from_this());
-#else
-      boost::thread(&future_when_any_vector_shared_state::run, this->shared_from_this()).detach();
-#endif
+      typename base_type::inputs_type inputs;
+      inputs.reserve(vec_.size());
+      for (typename csbl::vector<F>::iterator it = vec_.begin(); it != vec_.end(); ++it) {
+        inputs.push_back(it->future_);
+      }
+      this->attach(inputs);
     }
 
   public:
     template< typename InputIterator>
     future_when_any_vector_shared_state(input_iterator_tag, InputIterator first, InputIterator last)
-    : vec_(std::make_move_iterator(first), std::make_move_iterator(last))
+    : vec_(std::make_move_iterator(first), std::make_move_iterator(last)), fired_(false)
     {
     }
 
     future_when_any_vector_shared_state(vector_tag, BOOST_THREAD_RV_REF(csbl::vector<F>) v)
-    : vec_(boost::move(v))
+    : vec_(boost::move(v)), fired_(false)
     {
     }
 
@@ -5647,7 +6036,8 @@ namespace detail
     template< typename T0, typename ...T>
     future_when_any_vector_shared_state(values_tag,
         BOOST_THREAD_FWD_REF(T0) f, BOOST_THREAD_FWD_REF(T) ... futures
-    ) {
+    ) : fired_(false)
+    {
       vec_.push_back(boost::forward<T0>(f));
       typename alias_t<char[]>::type{
           ( //first part of magic unpacker
@@ -5663,21 +6053,6 @@ namespace detail
   };
 
 #if ! defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
-  struct wait_for_all_fctr {
-    template <class ...T>
-    void operator()(T&&... v) {
-      boost::wait_for_all(boost::forward<T>(v)...);
-    }
-  };
-
-  struct wait_for_any_fctr {
-    template <class ...T>
-    void operator()(T&&... v) {
-      boost::wait_for_any(boost::forward<T>(v)...);
-    }
-  };
-
-
   template <class Tuple, std::size_t i=csbl::tuple_size<Tuple>::value>
   struct accumulate_run_if_is_deferred {
     bool operator ()(Tuple& t)
@@ -5693,55 +6068,51 @@ namespace detail
     }
   };
 
+  template <class Tuple, std::size_t i=csbl::tuple_size<Tuple>::value>
+  struct collect_shared_states {
+    void operator ()(Tuple& t, csbl::vector<shared_ptr<shared_state_base> >& states)
+    {
+      collect_shared_states<Tuple,i-1>()(t, states);
+      states.push_back(csbl::get<i-1>(t).future_);
+    }
+  };
+  template <class Tuple>
+  struct collect_shared_states<Tuple, 0> {
+    void operator ()(Tuple&, csbl::vector<shared_ptr<shared_state_base> >& )
+    {
+    }
+  };
 
   template< typename Tuple, typename T0, typename ...T>
-  struct future_when_all_tuple_shared_state: future_async_shared_state_base<Tuple>
+  struct future_when_all_tuple_shared_state: future_when_shared_state_base<Tuple>
   {
+    typedef future_when_shared_state_base<Tuple> base_type;
     Tuple tup_;
-    typedef typename make_tuple_indices<1+sizeof...(T)>::type Index;
-
-    static void run(shared_ptr<boost::detail::shared_state_base> that_) {
-      future_when_all_tuple_shared_state* that = static_cast<future_when_all_tuple_shared_state*>(that_.get());
-      try {
-        // TODO make use of apply(that->tup_, boost::detail::wait_for_all_fctor());
-        that->wait_for_all(Index());
-
-        that->mark_finished_with_result(boost::move(that->tup_));
-      } catch(...) {
-        that->mark_exceptional_finish();
-      }
-    }
+    // the number of futures not ready yet
+    boost::atomic<std::size_t> pending_;
 
-    template <size_t ...Indices>
-    void wait_for_all(tuple_indices<Indices...>) {
-#if defined BOOST_THREAD_PROVIDES_INVOKE
-      return invoke<void>(wait_for_all_fctr(), csbl::get<Indices>(tup_)...);
-#else
-      return wait_for_all_fctr()(csbl::get<Indices>(tup_)...);
-#endif
+    void launch_continuation() {
+      if (pending_.fetch_sub(1, boost::memory_order_acq_rel) != 1) return;
+      boost::unique_lock<boost::mutex> lk(this->mutex);
+      this->mark_finished_with_result_internal(boost::move(tup_), lk);
     }
-
     bool run_deferred() {
 
       return accumulate_run_if_is_deferred<Tuple>()(tup_);
     }
     void init() {
-      if (! run_deferred())
-      {
-        future_when_all_tuple_shared_state::run(this->shared_from_this());
-        return;
-      }
-#ifdef BOOST_THREAD_FUTURE_BLOCKING
-      this->thr_ = boost::thread(&future_when_all_tuple_shared_state::run, this->shared_from_this());
-#else
-      boost::thread(&future_when_all_tuple_shared_state::run, this->shared_from_this()).detach();
-#endif
-
+      run_deferred();
+      typename base_type::inputs_type inputs;
+      inputs.reserve(1+sizeof...(T));
+      collect_shared_states<Tuple>()(tup_, inputs);
+      pending_.store(inputs.size(), boost::memory_order_relaxed);
+      this->attach(inputs);
     }
   public:
     template< typename F, typename ...Fs>
     future_when_all_tuple_shared_state(values_tag, BOOST_THREAD_FWD_REF(F) f, BOOST_THREAD_FWD_REF(Fs) ... futures) :
-      tup_(boost::csbl::make_tuple(boost::forward<F>(f), boost::forward<Fs>(futures)...))
+      tup_(boost::csbl::make_tuple(boost::forward<F>(f), boost::forward<Fs>(futures)...)),
+      pending_(0)
     {
     }
 
@@ -5767,30 +6138,17 @@ namespace detail
   };
 
   template< typename Tuple, typename T0, typename ...T >
-  struct future_when_any_tuple_shared_state: future_async_shared_state_base<Tuple>
+  struct future_when_any_tuple_shared_state: future_when_shared_state_base<Tuple>
   {
+    typedef future_when_shared_state_base<Tuple> base_type;
     Tuple tup_;
-    typedef typename make_tuple_indices<1+sizeof...(T)>::type Index;
+    // set by the first future ready, the only one making the shared state ready
+    boost::atomic<bool> fired_;
 
-    static void run(shared_ptr<boost::detail::shared_state_base> that_)
-    {
-      future_when_any_tuple_shared_state* that = static_cast<future_when_any_tuple_shared_state*>(that_.get());
-      try {
-        // TODO make use of apply(that->tup_, wait_for_any_fctr);
-        that->wait_for_any(Index());
-
-        that->mark_finished_with_result(boost::move(that->tup_));
-      } catch(...) {
-        that->mark_exceptional_finish();
-      }
-    }
-    template <size_t ...Indices>
-    void wait_for_any(tuple_indices<Indices...>) {
-#if defined BOOST_THREAD_PROVIDES_INVOKE
-      return invoke<void>(wait_for_any_fctr(), csbl::get<Indices>(tup_)...);
-#else
-      return wait_for_any_fctr()(csbl::get<Indices>(tup_)...);
-#endif
+    void launch_continuation() {
+      if (fired_.exchange(true, boost::memory_order_acq_rel)) return;
+      boost::unique_lock<boost::mutex> lk(this->mutex);
+      this->mark_finished_with_result_internal(boost::move(tup_), lk);
     }
     bool run_deferred() {
       return apply_any_run_if_is_deferred_or_ready<Tuple>()(tup_);
@@ -5798,15 +6156,13 @@ namespace detail
     void init() {
       if (run_deferred())
       {
-        future_when_any_tuple_shared_state::run(this->shared_from_this());
+        launch_continuation();
         return;
       }
-
-#ifdef BOOST_THREAD_FUTURE_BLOCKING
-      this->thr_ = boost::thread(&future_when_any_tuple_shared_state::run, this->shared_from_this());
-#else
-      boost::thread(&future_when_any_tuple_shared_state::run, this->shared_from_this()).detach();
-#endif
+      typename base_type::inputs_type inputs;
+      inputs.reserve(1+sizeof...(T));
+      collect_shared_states<Tuple>()(tup_, inputs);
+      this->attach(inputs);
     }
 
   public:
@@ -5814,7 +6170,8 @@ namespace detail
     future_when_any_tuple_shared_state(values_tag,
         BOOST_THREAD_FWD_REF(F) f, BOOST_THREAD_FWD_REF(Fs) ... futures
     ) :
-      tup_(boost::csbl::make_tuple(boost::forward<F>(f), boost::forward<Fs>(futures)...))
+      tup_(boost::csbl::make_tuple(boost::forward<F>(f), boost::forward<Fs>(futures)...)),
+      fired_(false)
     {
     }
 
@@ -5835,7 +6192,7 @@ namespace detail
 
     if (first==last) return make_ready_future(container_type());
     shared_ptr<factory_type >
-        h(new factory_type(detail::input_iterator_tag_value, first,last));
+        h(detail::share_state(new factory_type(detail::input_iterator_tag_value, first,last)));
     h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
@@ -5852,7 +6209,7 @@ namespace detail
     typedef detail::future_when_all_tuple_shared_state<container_type, typename decay<T0>::type, typename decay<T>::type...> factory_type;
 
     shared_ptr<factory_type>
-        h(new factory_type(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...));
+        h(detail::share_state(new factory_type(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...)));
     h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
@@ -5869,7 +6226,7 @@ namespace detail
 
     if (first==last) return make_ready_future(container_type());
     shared_ptr<factory_type >
-        h(new factory_type(detail::input_iterator_tag_value, first,last));
+        h(detail::share_state(new factory_type(detail::input_iterator_tag_value, first,last)));
     h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
@@ -5886,7 +6243,7 @@ namespace detail
     typedef detail::future_when_any_tuple_shared_state<container_type, typename decay<T0>::type, typename decay<T>::type...> factory_type;
 
     shared_ptr<factory_type>
-        h(new factory_type(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...));
+        h(detail::share_state(new factory_type(detail::values_tag_value, boost::forward<T0>(f), boost::forward<T>(futures)...)));
     h->init();
     return BOOST_THREAD_FUTURE<container_type>(h);
   }
@@ -24,6 +24,9 @@ namespace boost
 #endif
       inherit = 8,
       sync = 16,
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+      pool = 32,
+#endif
       any = async | deferred
   }
   BOOST_SCOPED_ENUM_DECLARE_END(launch)
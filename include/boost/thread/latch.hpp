@@ -10,9 +10,9 @@
 #include <boost/thread/detail/delete.hpp>
 #include <boost/thread/detail/counter.hpp>
 
-#include <boost/thread/mutex.hpp>
-#include <boost/thread/lock_types.hpp>
-#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/cv_status.hpp>
+#include <boost/atomic.hpp>
+#include <boost/chrono/system_clocks.hpp>
 #include <boost/chrono/duration.hpp>
 #include <boost/chrono/time_point.hpp>
 #include <boost/assert.hpp>
@@ -21,42 +21,18 @@
 
 namespace boost
 {
+  /**
+   * The count is an atomic word: counting down is a single atomic decrement, and the thread taking it
+   * to zero advances the generation the waiting threads are blocked on, waking them all at once.
+   */
   class latch
   {
-    /// @Requires: count_ must be greater than 0
-    /// Effect: Decrement the count. Unlocks the lock and notify anyone waiting if we reached zero.
-    /// Returns: true if count_ reached the value 0.
-    /// @ThreadSafe ensured by the @c lk parameter
-    bool count_down(unique_lock<mutex> &)
-    /// pre_condition (count_ > 0)
-    {
-      BOOST_ASSERT(count_ > 0);
-      if (--count_ == 0)
-      {
-        ++generation_;
-        //lk.unlock();
-        cond_.notify_all();
-        return true;
-      }
-      return false;
-    }
-    /// Effect: Decrement the count is > 0. Unlocks the lock notify anyone waiting if we reached zero.
-    /// Returns: true if count_ is 0.
-    /// @ThreadSafe ensured by the @c lk parameter
-    bool try_count_down(unique_lock<mutex> &lk)
-    {
-      if (count_ > 0)
-      {
-        return count_down(lk);
-      }
-      return true;
-    }
   public:
     BOOST_THREAD_NO_COPYABLE( latch)
 
     /// Constructs a latch with a given count.
     latch(std::size_t count) :
-      count_(count), generation_(0)
+      count_(count)
     {
     }
 
@@ -71,17 +47,15 @@ namespace boost
     /// Blocks until the latch has counted down to zero.
     void wait()
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      if (count_ == 0) return;
-      std::size_t generation(generation_);
-      cond_.wait(lk, detail::not_equal(generation, generation_));
+      unsigned int const gen = generation_.load();
+      if (count_.load() == 0) return;
+      generation_.wait(gen);
     }
 
     /// @return true if the internal counter is already 0, false otherwise
     bool try_wait()
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      return (count_ == 0);
+      return (count_.load() == 0);
     }
 
     /// try to wait for a specified amount of time is elapsed.
@@ -89,12 +63,7 @@ namespace boost
     template <class Rep, class Period>
     cv_status wait_for(const chrono::duration<Rep, Period>& rel_time)
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      if (count_ == 0) return cv_status::no_timeout;
-      std::size_t generation(generation_);
-      return cond_.wait_for(lk, rel_time, detail::not_equal(generation, generation_))
-              ? cv_status::no_timeout
-              : cv_status::timeout;
+      return wait_until(chrono::steady_clock::now() + rel_time);
     }
 
     /// try to wait until the specified time_point is reached
@@ -102,10 +71,9 @@ namespace boost
     template <class Clock, class Duration>
     cv_status wait_until(const chrono::time_point<Clock, Duration>& abs_time)
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      if (count_ == 0) return cv_status::no_timeout;
-      std::size_t generation(generation_);
-      return cond_.wait_until(lk, abs_time, detail::not_equal(generation, generation_))
+      unsigned int const gen = generation_.load();
+      if (count_.load() == 0) return cv_status::no_timeout;
+      return generation_.wait_until(gen, abs_time)
           ? cv_status::no_timeout
           : cv_status::timeout;
     }
@@ -114,15 +82,22 @@ namespace boost
     /// @Requires count must be greater than 0
     void count_down()
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      count_down(lk);
+      count_down_and_notify();
     }
     /// Effect: Decrement the count if it is > 0 and notify anyone waiting if we reached zero.
     /// Returns: true if count_ was 0 or reached 0.
     bool try_count_down()
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      return try_count_down(lk);
+      std::size_t count = count_.load();
+      while (count > 0)
+      {
+        if (count_.compare_exchange_weak(count, count - 1))
+        {
+          if (count == 1) generation_.advance();
+          return count == 1;
+        }
+      }
+      return true;
     }
     void signal()
     {
@@ -134,13 +109,12 @@ namespace boost
     /// @Requires count must be greater than 0
     void count_down_and_wait()
     {
-      boost::unique_lock<boost::mutex> lk(mutex_);
-      std::size_t generation(generation_);
-      if (count_down(lk))
+      unsigned int const gen = generation_.load();
+      if (count_down_and_notify())
       {
         return;
       }
-      cond_.wait(lk, detail::not_equal(generation, generation_));
+      generation_.wait(gen);
     }
     void sync()
     {
@@ -151,16 +125,28 @@ namespace boost
     /// #Requires This method may only be invoked when there are no other threads currently inside the count_down_and_wait() method.
     void reset(std::size_t count)
     {
-      boost::lock_guard<boost::mutex> lk(mutex_);
       //BOOST_ASSERT(count_ == 0);
-      count_ = count;
+      count_.store(count);
     }
 
   private:
-    mutex mutex_;
-    condition_variable cond_;
-    std::size_t count_;
-    std::size_t generation_;
+    /// @Requires: count_ must be greater than 0
+    /// Effect: Decrement the count. Notify anyone waiting if we reached zero.
+    /// Returns: true if count_ reached the value 0.
+    bool count_down_and_notify()
+    {
+      std::size_t const count = count_.fetch_sub(1);
+      BOOST_ASSERT(count > 0);
+      if (count == 1)
+      {
+        generation_.advance();
+        return true;
+      }
+      return false;
+    }
+
+    atomic<std::size_t> count_;
+    detail::generation generation_;
   };
 
 } // namespace boost
@@ -59,8 +59,106 @@ namespace boost
                 }
            }
         };
+
+#if defined BOOST_THREAD_USES_FUTEX
+        // counts the thread as a waiter of a condition_variable
+        struct futex_waiter
+        {
+            detail::futex_word& waiters;
+
+            explicit futex_waiter(detail::futex_word& waiters_):
+                waiters(waiters_)
+            {
+                waiters.fetch_add(1);
+            }
+            ~futex_waiter()
+            {
+                waiters.fetch_sub(1, memory_order_release);
+            }
+        private:
+            void operator=(futex_waiter&);
+        };
+#endif
+    }
+
+#if defined BOOST_THREAD_USES_FUTEX
+    // Returns false when abs_time has been reached.
+    // As the pthread based implementation, it can return true on spurious wake-ups.
+    inline bool condition_variable::futex_wait(unique_lock<mutex>& m, timespec const* abs_time)
+    {
+        // A notification changing seq_ after it is read has either seen this thread as a waiter, or
+        // the thread reads the new value.
+        thread_cv_detail::futex_waiter waiter(waiters_);
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        detail::futex_interruption_checker check_for_interruption(&seq_);
+#endif
+        unsigned const seq = seq_.load();
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        check_for_interruption.check_for_interruption();
+#endif
+        int res;
+        {
+            thread_cv_detail::lock_on_exit<unique_lock<mutex> > guard;
+            guard.activate(m);
+            res = abs_time ? detail::futex::wait_until(seq_, seq, *abs_time) : detail::futex::wait(seq_, seq);
+        }
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        check_for_interruption.unregister();
+        check_for_interruption.check_for_interruption();
+#endif
+        if(res==ETIMEDOUT)
+        {
+            return false;
+        }
+        if(res && res!=EAGAIN && res!=EINTR)
+        {
+            boost::throw_exception(condition_error(res, "boost::condition_variable::wait failed in futex wait"));
+        }
+        return true;
     }
 
+    inline void condition_variable::wait(unique_lock<mutex>& m)
+    {
+#if defined BOOST_THREAD_THROW_IF_PRECONDITION_NOT_SATISFIED
+        if(! m.owns_lock())
+        {
+            boost::throw_exception(condition_error(-1, "boost::condition_variable::wait() failed precondition mutex not owned"));
+        }
+#endif
+        futex_wait(m, 0);
+    }
+
+    inline bool condition_variable::do_wait_until(
+                unique_lock<mutex>& m,
+                detail::internal_platform_timepoint const &timeout)
+    {
+#if defined BOOST_THREAD_THROW_IF_PRECONDITION_NOT_SATISFIED
+        if (!m.owns_lock())
+        {
+            boost::throw_exception(condition_error(EPERM, "boost::condition_variable::do_wait_until() failed precondition mutex not owned"));
+        }
+#endif
+        return futex_wait(m, &timeout.getTs());
+    }
+
+    inline void condition_variable::notify_one() BOOST_NOEXCEPT
+    {
+        seq_.fetch_add(1);
+        if(waiters_.load() != 0)
+        {
+            detail::futex::wake_one(seq_);
+        }
+    }
+
+    inline void condition_variable::notify_all() BOOST_NOEXCEPT
+    {
+        seq_.fetch_add(1);
+        if(waiters_.load() != 0)
+        {
+            detail::futex::wake_all(seq_);
+        }
+    }
+#else
     inline void condition_variable::wait(unique_lock<mutex>& m)
     {
 #if defined BOOST_THREAD_THROW_IF_PRECONDITION_NOT_SATISFIED
@@ -156,6 +254,7 @@ namespace boost
 #endif
         BOOST_VERIFY(!posix::pthread_cond_broadcast(&cond));
     }
+#endif
 
     class condition_variable_any
     {
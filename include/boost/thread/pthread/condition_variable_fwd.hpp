@@ -15,6 +15,7 @@
 #include <boost/thread/thread_time.hpp>
 #include <boost/thread/detail/platform_time.hpp>
 #include <boost/thread/pthread/pthread_helpers.hpp>
+#include <boost/thread/pthread/futex.hpp>
 
 #if defined BOOST_THREAD_USES_DATETIME
 #include <boost/thread/xtime.hpp>
@@ -36,10 +37,21 @@ namespace boost
     class condition_variable
     {
     private:
+#if defined BOOST_THREAD_USES_FUTEX
+        // Incremented by each notification and interruption, the waiters block until it changes.
+        // thread::interrupt() wakes the thread directly through this word, so that neither the waits
+        // nor the notifications need an internal mutex.
+        detail::futex_word seq_;
+        // the number of waiting threads, so that the notifications without waiters avoid the syscall
+        detail::futex_word waiters_;
+
+        bool futex_wait(unique_lock<mutex>& lock, timespec const* abs_time);
+#else
 //#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
         pthread_mutex_t internal_mutex;
 //#endif
         pthread_cond_t cond;
+#endif
 
     public:
     //private: // used by boost::thread::try_join_until
@@ -50,6 +62,12 @@ namespace boost
 
     public:
       BOOST_THREAD_NO_COPYABLE(condition_variable)
+#if defined BOOST_THREAD_USES_FUTEX
+        condition_variable() BOOST_NOEXCEPT
+        : seq_(0), waiters_(0)
+        {
+        }
+#else
         condition_variable()
         {
             int res;
@@ -82,6 +100,7 @@ namespace boost
 //#endif
             BOOST_VERIFY(!posix::pthread_cond_destroy(&cond));
         }
+#endif
 
         void wait(unique_lock<mutex>& m);
 
@@ -323,11 +342,20 @@ namespace boost
 #endif
 
 #define BOOST_THREAD_DEFINES_CONDITION_VARIABLE_NATIVE_HANDLE
+#if defined BOOST_THREAD_USES_FUTEX
+        // the futex word the threads wait on
+        typedef detail::futex_word* native_handle_type;
+        native_handle_type native_handle()
+        {
+            return &seq_;
+        }
+#else
         typedef pthread_cond_t* native_handle_type;
         native_handle_type native_handle()
         {
             return &cond;
         }
+#endif
 
         void notify_one() BOOST_NOEXCEPT;
         void notify_all() BOOST_NOEXCEPT;
@@ -0,0 +1,91 @@
+#ifndef BOOST_THREAD_PTHREAD_FUTEX_HPP
+#define BOOST_THREAD_PTHREAD_FUTEX_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/atomic.hpp>
+
+#if defined BOOST_THREAD_USES_FUTEX
+#include <boost/static_assert.hpp>
+
+#include <climits>
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace detail
+  {
+    // A 32 bits word the threads can block on until it changes. Declared even without futexes, so
+    // that the thread data referring to it has the same layout either way.
+    typedef boost::atomic<unsigned int> futex_word;
+#if defined BOOST_THREAD_USES_FUTEX
+    BOOST_STATIC_ASSERT(sizeof(futex_word) == sizeof(int));
+
+    namespace futex
+    {
+      inline long call(futex_word& word, int op, unsigned int val, timespec const* ts, unsigned int val3)
+      {
+        return ::syscall(SYS_futex, static_cast<void*>(&word), op | FUTEX_PRIVATE_FLAG, val, ts, 0, val3);
+      }
+
+      /**
+       * \b Effects: Blocks the calling thread while word holds expected, until woken by wake().
+       *
+       * \b Returns: 0 when woken, EAGAIN when word did not hold expected and EINTR when interrupted by
+       * a signal. The thread can also be woken spuriously.
+       */
+      inline int wait(futex_word& word, unsigned int expected)
+      {
+        if (call(word, FUTEX_WAIT, expected, 0, 0) == 0) return 0;
+        return errno;
+      }
+
+      /**
+       * \b Effects: As wait(), returning ETIMEDOUT once abs_time, a time point of the internal clock,
+       * is reached.
+       */
+      inline int wait_until(futex_word& word, unsigned int expected, timespec const& abs_time)
+      {
+#if defined BOOST_THREAD_INTERNAL_CLOCK_IS_MONO
+        int const op = FUTEX_WAIT_BITSET;
+#else
+        int const op = FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME;
+#endif
+        if (call(word, op, expected, &abs_time, FUTEX_BITSET_MATCH_ANY) == 0) return 0;
+        return errno;
+      }
+
+      /**
+       * \b Effects: Wakes up to count threads blocked on word.
+       */
+      inline void wake(futex_word& word, int count) BOOST_NOEXCEPT
+      {
+        call(word, FUTEX_WAKE, static_cast<unsigned int>(count), 0, 0);
+      }
+
+      inline void wake_one(futex_word& word) BOOST_NOEXCEPT
+      {
+        wake(word, 1);
+      }
+
+      inline void wake_all(futex_word& word) BOOST_NOEXCEPT
+      {
+        wake(word, INT_MAX);
+      }
+    }
+#endif
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
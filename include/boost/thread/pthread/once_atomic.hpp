@@ -46,10 +46,19 @@ namespace boost
 
     typedef boost::atomic<atomic_int_type> atomic_type;
 
+    // the value of a once_flag whose function has completed, the other states are private to the library
+    atomic_int_type const once_flag_initialized = 2;
+
     BOOST_THREAD_DECL bool enter_once_region(once_flag& flag) BOOST_NOEXCEPT;
     BOOST_THREAD_DECL void commit_once_region(once_flag& flag) BOOST_NOEXCEPT;
     BOOST_THREAD_DECL void rollback_once_region(once_flag& flag) BOOST_NOEXCEPT;
     inline atomic_type& get_atomic_storage(once_flag& flag)  BOOST_NOEXCEPT;
+
+    // the fast path of call_once, once the flag has been initialized
+    inline bool is_once_region_committed(once_flag& flag) BOOST_NOEXCEPT
+    {
+      return get_atomic_storage(flag).load(memory_order_acquire) == once_flag_initialized;
+    }
   }
 
 #ifdef BOOST_THREAD_PROVIDES_ONCE_CXX11
@@ -120,7 +129,7 @@ namespace boost
   template<typename Function, class ...ArgTypes>
   inline void call_once(once_flag& flag, BOOST_THREAD_RV_REF(Function) f, BOOST_THREAD_RV_REF(ArgTypes)... args)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -142,7 +151,7 @@ namespace boost
   template<typename Function>
   inline void call_once(once_flag& flag, Function f)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -161,7 +170,7 @@ namespace boost
   template<typename Function, typename T1>
   inline void call_once(once_flag& flag, Function f, T1 p1)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -180,7 +189,7 @@ namespace boost
   template<typename Function, typename T1, typename T2>
   inline void call_once(once_flag& flag, Function f, T1 p1, T2 p2)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -199,7 +208,7 @@ namespace boost
   template<typename Function, typename T1, typename T2, typename T3>
   inline void call_once(once_flag& flag, Function f, T1 p1, T2 p2, T3 p3)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -218,7 +227,7 @@ namespace boost
   template<typename Function>
   inline void call_once(once_flag& flag, BOOST_THREAD_RV_REF(Function) f)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -237,7 +246,7 @@ namespace boost
   template<typename Function, typename T1>
   inline void call_once(once_flag& flag, BOOST_THREAD_RV_REF(Function) f, BOOST_THREAD_RV_REF(T1) p1)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -258,7 +267,7 @@ namespace boost
   template<typename Function, typename T1, typename T2>
   inline void call_once(once_flag& flag, BOOST_THREAD_RV_REF(Function) f, BOOST_THREAD_RV_REF(T1) p1, BOOST_THREAD_RV_REF(T2) p2)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
@@ -280,7 +289,7 @@ namespace boost
   template<typename Function, typename T1, typename T2, typename T3>
   inline void call_once(once_flag& flag, BOOST_THREAD_RV_REF(Function) f, BOOST_THREAD_RV_REF(T1) p1, BOOST_THREAD_RV_REF(T2) p2, BOOST_THREAD_RV_REF(T3) p3)
   {
-    if (thread_detail::enter_once_region(flag))
+    if (! thread_detail::is_once_region_committed(flag) && thread_detail::enter_once_region(flag))
     {
       BOOST_TRY
       {
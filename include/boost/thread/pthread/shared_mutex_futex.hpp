@@ -0,0 +1,472 @@
+#ifndef BOOST_THREAD_PTHREAD_SHARED_MUTEX_FUTEX_HPP
+#define BOOST_THREAD_PTHREAD_SHARED_MUTEX_FUTEX_HPP
+
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#if defined BOOST_THREAD_USES_FUTEX
+#include <boost/assert.hpp>
+#include <boost/thread/pthread/futex.hpp>
+#include <boost/thread/detail/platform_time.hpp>
+#include <boost/thread/thread_time.hpp>
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#include <boost/chrono/ceil.hpp>
+#endif
+#include <boost/thread/detail/delete.hpp>
+
+#include <algorithm>
+#include <errno.h>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+    /**
+     * A shared_mutex whose whole state is one futex word: the number of shared owners, including the
+     * upgrade owner, and the exclusive, upgrade, exclusive waiting and waiters bits.
+     *
+     * Locking and unlocking are a single compare-and-swap or fetch-and-sub on this word when there is no
+     * contention. The threads that can't take the lock park on the word, and the thread changing the
+     * state so that they may proceed wakes them all when the waiters bit is set.
+     *
+     * As the mutex based implementation, a thread waiting for the exclusive ownership blocks the new
+     * shared and upgrade owners, so that the writers aren't starved by a stream of readers.
+     */
+    class shared_mutex
+    {
+    private:
+        BOOST_STATIC_CONSTANT(unsigned, exclusive = 1u << 31);
+        BOOST_STATIC_CONSTANT(unsigned, upgrade = 1u << 30);
+        BOOST_STATIC_CONSTANT(unsigned, exclusive_waiting = 1u << 29);
+        BOOST_STATIC_CONSTANT(unsigned, has_waiters = 1u << 28);
+        BOOST_STATIC_CONSTANT(unsigned, shared_mask = has_waiters - 1);
+
+        // The acquisitions, as the condition on the state to take the ownership, the state once taken,
+        // and the bits to set while waiting.
+        struct shared_acquisition
+        {
+            static bool can(unsigned s) { return ! (s & (exclusive | exclusive_waiting)); }
+            static unsigned next(unsigned s) { return s + 1; }
+            BOOST_STATIC_CONSTANT(unsigned, waiting = has_waiters);
+        };
+        struct upgrade_acquisition
+        {
+            static bool can(unsigned s) { return ! (s & (exclusive | exclusive_waiting | upgrade)); }
+            static unsigned next(unsigned s) { return (s + 1) | upgrade; }
+            BOOST_STATIC_CONSTANT(unsigned, waiting = has_waiters);
+        };
+        struct exclusive_acquisition
+        {
+            static bool can(unsigned s) { return ! (s & (exclusive | shared_mask)); }
+            static unsigned next(unsigned s) { return (s & ~exclusive_waiting) | exclusive; }
+            BOOST_STATIC_CONSTANT(unsigned, waiting = has_waiters | exclusive_waiting);
+        };
+        // from the upgrade ownership, once the other shared owners are gone
+        struct upgrade_to_exclusive
+        {
+            static bool can(unsigned s) { return (s & shared_mask) == 1; }
+            static unsigned next(unsigned s) { return ((s - 1 - upgrade) & ~exclusive_waiting) | exclusive; }
+            BOOST_STATIC_CONSTANT(unsigned, waiting = has_waiters | exclusive_waiting);
+        };
+#ifdef BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+        struct shared_to_exclusive
+        {
+            static bool can(unsigned s) { return (s & shared_mask) == 1; }
+            static unsigned next(unsigned s) { return ((s - 1) & ~exclusive_waiting) | exclusive; }
+            BOOST_STATIC_CONSTANT(unsigned, waiting = has_waiters | exclusive_waiting);
+        };
+        struct shared_to_upgrade
+        {
+            static bool can(unsigned s) { return ! (s & (exclusive_waiting | upgrade)); }
+            static unsigned next(unsigned s) { return s | upgrade; }
+            BOOST_STATIC_CONSTANT(unsigned, waiting = has_waiters);
+        };
+#endif
+
+        detail::futex_word state;
+
+        template <typename Acquisition>
+        bool try_acquire()
+        {
+            unsigned s = state.load(memory_order_relaxed);
+            while (Acquisition::can(s))
+            {
+                if (state.compare_exchange_weak(s, Acquisition::next(s), memory_order_acquire, memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Returns false when timeout, if any, is reached before the ownership is taken.
+        template <typename Acquisition>
+        bool acquire(detail::internal_platform_timepoint const* timeout)
+        {
+            unsigned s = state.load(memory_order_relaxed);
+            bool timed_out = false;
+            for (;;)
+            {
+                if (Acquisition::can(s))
+                {
+                    if (state.compare_exchange_weak(s, Acquisition::next(s), memory_order_acquire, memory_order_relaxed))
+                    {
+                        return true;
+                    }
+                    continue;
+                }
+                if (timed_out)
+                {
+                    if (Acquisition::waiting & exclusive_waiting)
+                    {
+                        // let in the shared owners this thread was blocking; the other threads waiting
+                        // for the exclusive ownership set the bit again
+                        if (state.fetch_and(~(exclusive_waiting | has_waiters), memory_order_relaxed) & has_waiters)
+                        {
+                            detail::futex::wake_all(state);
+                        }
+                    }
+                    return false;
+                }
+                unsigned const waiting = s | Acquisition::waiting;
+                if (waiting != s && ! state.compare_exchange_weak(s, waiting, memory_order_relaxed, memory_order_relaxed))
+                {
+                    continue;
+                }
+                int const res = timeout ? detail::futex::wait_until(state, waiting, timeout->getTs()) : detail::futex::wait(state, waiting);
+                timed_out = (res == ETIMEDOUT);
+                s = state.load(memory_order_relaxed);
+            }
+        }
+
+        // Replaces the ownership from of the calling thread by to, and wakes the waiting threads.
+        void release(unsigned from, unsigned to)
+        {
+            unsigned s = state.load(memory_order_relaxed);
+            while (! state.compare_exchange_weak(s, (s - from + to) & ~has_waiters, memory_order_release, memory_order_relaxed))
+            {
+            }
+            if (s & has_waiters)
+            {
+                detail::futex::wake_all(state);
+            }
+        }
+
+        void wake_waiters()
+        {
+            if (state.fetch_and(~has_waiters, memory_order_relaxed) & has_waiters)
+            {
+                detail::futex::wake_all(state);
+            }
+        }
+
+        typedef bool (shared_mutex::*timed_acquire)(detail::internal_platform_timepoint const*);
+
+#if defined BOOST_THREAD_USES_DATETIME
+        bool acquire_until(timed_acquire f, system_time const& abs_time)
+        {
+            const detail::real_platform_timepoint ts(abs_time);
+#if defined BOOST_THREAD_INTERNAL_CLOCK_IS_MONO
+            detail::platform_duration d(ts - detail::real_platform_clock::now());
+            d = (std::min)(d, detail::platform_milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS));
+            for (;;)
+            {
+              const detail::internal_platform_timepoint t(detail::internal_platform_clock::now() + d);
+              if ((this->*f)(&t)) return true;
+              d = ts - detail::real_platform_clock::now();
+              if ( d <= detail::platform_duration::zero() ) return false; // timeout occurred
+              d = (std::min)(d, detail::platform_milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS));
+            }
+#else
+            return (this->*f)(&ts);
+#endif
+        }
+
+        template<typename TimeDuration>
+        bool acquire_for(timed_acquire f, TimeDuration const & relative_time)
+        {
+            if (relative_time.is_pos_infinity())
+            {
+                return (this->*f)(0);
+            }
+            if (relative_time.is_special())
+            {
+                return true;
+            }
+            const detail::internal_platform_timepoint t(detail::internal_platform_clock::now() + detail::platform_duration(relative_time));
+            return (this->*f)(&t);
+        }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Clock, class Duration>
+        bool acquire_until(timed_acquire f, const chrono::time_point<Clock, Duration>& abs_time)
+        {
+            typedef typename common_type<Duration, typename Clock::duration>::type common_duration;
+            common_duration d(abs_time - Clock::now());
+            d = (std::min)(d, common_duration(chrono::milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS)));
+            for (;;)
+            {
+                const detail::internal_platform_timepoint t(detail::internal_chrono_clock::now() + d);
+                if ((this->*f)(&t)) return true;
+                d = abs_time - Clock::now();
+                if ( d <= common_duration::zero() ) return false; // timeout occurred
+                d = (std::min)(d, common_duration(chrono::milliseconds(BOOST_THREAD_POLL_INTERVAL_MILLISECONDS)));
+            }
+        }
+#endif
+
+    public:
+
+        BOOST_THREAD_NO_COPYABLE(shared_mutex)
+
+        shared_mutex() BOOST_NOEXCEPT :
+            state(0)
+        {
+        }
+
+        ~shared_mutex()
+        {
+        }
+
+        void lock_shared()
+        {
+            unsigned s = state.load(memory_order_relaxed);
+            if (! shared_acquisition::can(s)
+                || ! state.compare_exchange_weak(s, s + 1, memory_order_acquire, memory_order_relaxed))
+            {
+                acquire<shared_acquisition>(0);
+            }
+        }
+
+        bool try_lock_shared()
+        {
+            return try_acquire<shared_acquisition>();
+        }
+
+#if defined BOOST_THREAD_USES_DATETIME
+        bool timed_lock_shared(system_time const& timeout)
+        {
+            return acquire_until(&shared_mutex::acquire<shared_acquisition>, timeout);
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock_shared(TimeDuration const & relative_time)
+        {
+            return acquire_for(&shared_mutex::acquire<shared_acquisition>, relative_time);
+        }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Rep, class Period>
+        bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time)
+        {
+          return try_lock_shared_until(chrono::steady_clock::now() + rel_time);
+        }
+        template <class Clock, class Duration>
+        bool try_lock_shared_until(const chrono::time_point<Clock, Duration>& abs_time)
+        {
+          return acquire_until(&shared_mutex::acquire<shared_acquisition>, abs_time);
+        }
+#endif
+        void unlock_shared()
+        {
+            unsigned const s = state.fetch_sub(1, memory_order_release);
+            BOOST_ASSERT( ! (s & exclusive) && (s & shared_mask) > 0 );
+            // the threads waiting for the exclusive ownership need no shared owner left, the ones converting
+            // their shared or upgrade ownership need no other
+            if ((s & has_waiters) && (s & shared_mask) <= 2)
+            {
+                wake_waiters();
+            }
+        }
+
+        void lock()
+        {
+            unsigned s = 0;
+            if (! state.compare_exchange_strong(s, exclusive, memory_order_acquire, memory_order_relaxed))
+            {
+                acquire<exclusive_acquisition>(0);
+            }
+        }
+
+#if defined BOOST_THREAD_USES_DATETIME
+        bool timed_lock(system_time const& timeout)
+        {
+            return acquire_until(&shared_mutex::acquire<exclusive_acquisition>, timeout);
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock(TimeDuration const & relative_time)
+        {
+            return acquire_for(&shared_mutex::acquire<exclusive_acquisition>, relative_time);
+        }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Rep, class Period>
+        bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+        {
+          return try_lock_until(chrono::steady_clock::now() + rel_time);
+        }
+        template <class Clock, class Duration>
+        bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+        {
+          return acquire_until(&shared_mutex::acquire<exclusive_acquisition>, abs_time);
+        }
+#endif
+
+        bool try_lock()
+        {
+            return try_acquire<exclusive_acquisition>();
+        }
+
+        void unlock()
+        {
+            BOOST_ASSERT( (state.load(memory_order_relaxed) & (exclusive | upgrade | shared_mask)) == exclusive );
+            release(exclusive, 0);
+        }
+
+        void lock_upgrade()
+        {
+            acquire<upgrade_acquisition>(0);
+        }
+
+#if defined BOOST_THREAD_USES_DATETIME
+        bool timed_lock_upgrade(system_time const& timeout)
+        {
+            return acquire_until(&shared_mutex::acquire<upgrade_acquisition>, timeout);
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock_upgrade(TimeDuration const & relative_time)
+        {
+            return acquire_for(&shared_mutex::acquire<upgrade_acquisition>, relative_time);
+        }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Rep, class Period>
+        bool try_lock_upgrade_for(const chrono::duration<Rep, Period>& rel_time)
+        {
+          return try_lock_upgrade_until(chrono::steady_clock::now() + rel_time);
+        }
+        template <class Clock, class Duration>
+        bool try_lock_upgrade_until(const chrono::time_point<Clock, Duration>& abs_time)
+        {
+          return acquire_until(&shared_mutex::acquire<upgrade_acquisition>, abs_time);
+        }
+#endif
+        bool try_lock_upgrade()
+        {
+            return try_acquire<upgrade_acquisition>();
+        }
+
+        void unlock_upgrade()
+        {
+            BOOST_ASSERT( (state.load(memory_order_relaxed) & (exclusive | upgrade)) == upgrade );
+            release(upgrade + 1, 0);
+        }
+
+        // Upgrade <-> Exclusive
+        void unlock_upgrade_and_lock()
+        {
+            BOOST_ASSERT( (state.load(memory_order_relaxed) & (exclusive | upgrade)) == upgrade );
+            acquire<upgrade_to_exclusive>(0);
+        }
+
+        void unlock_and_lock_upgrade()
+        {
+            release(exclusive, upgrade + 1);
+        }
+
+        bool try_unlock_upgrade_and_lock()
+        {
+            return try_acquire<upgrade_to_exclusive>();
+        }
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Rep, class Period>
+        bool
+        try_unlock_upgrade_and_lock_for(
+                                const chrono::duration<Rep, Period>& rel_time)
+        {
+          return try_unlock_upgrade_and_lock_until(
+                                 chrono::steady_clock::now() + rel_time);
+        }
+        template <class Clock, class Duration>
+        bool
+        try_unlock_upgrade_and_lock_until(
+                          const chrono::time_point<Clock, Duration>& abs_time)
+        {
+          return acquire_until(&shared_mutex::acquire<upgrade_to_exclusive>, abs_time);
+        }
+#endif
+
+        // Shared <-> Exclusive
+        void unlock_and_lock_shared()
+        {
+            release(exclusive, 1);
+        }
+
+#ifdef BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+        bool try_unlock_shared_and_lock()
+        {
+          return try_acquire<shared_to_exclusive>();
+        }
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Rep, class Period>
+            bool
+            try_unlock_shared_and_lock_for(
+                                const chrono::duration<Rep, Period>& rel_time)
+        {
+          return try_unlock_shared_and_lock_until(
+                                 chrono::steady_clock::now() + rel_time);
+        }
+        template <class Clock, class Duration>
+            bool
+            try_unlock_shared_and_lock_until(
+                          const chrono::time_point<Clock, Duration>& abs_time)
+        {
+          return acquire_until(&shared_mutex::acquire<shared_to_exclusive>, abs_time);
+        }
+#endif
+#endif
+
+        // Shared <-> Upgrade
+        void unlock_upgrade_and_lock_shared()
+        {
+            release(upgrade, 0);
+        }
+
+#ifdef BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+        bool try_unlock_shared_and_lock_upgrade()
+        {
+          return try_acquire<shared_to_upgrade>();
+        }
+#ifdef BOOST_THREAD_USES_CHRONO
+        template <class Rep, class Period>
+            bool
+            try_unlock_shared_and_lock_upgrade_for(
+                                const chrono::duration<Rep, Period>& rel_time)
+        {
+          return try_unlock_shared_and_lock_upgrade_until(
+                                 chrono::steady_clock::now() + rel_time);
+        }
+        template <class Clock, class Duration>
+            bool
+            try_unlock_shared_and_lock_upgrade_until(
+                          const chrono::time_point<Clock, Duration>& abs_time)
+        {
+          return acquire_until(&shared_mutex::acquire<shared_to_upgrade>, abs_time);
+        }
+#endif
+#endif
+    };
+
+    typedef shared_mutex upgrade_mutex;
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+#endif
@@ -13,16 +13,24 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/pthread/condition_variable_fwd.hpp>
 #include <boost/thread/pthread/pthread_helpers.hpp>
+#include <boost/thread/pthread/futex.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/core/no_exceptions_support.hpp>
 #include <boost/thread/detail/platform_time.hpp>
 #ifdef BOOST_THREAD_USES_CHRONO
 #include <boost/chrono/system_clocks.hpp>
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <new>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -32,7 +40,9 @@
 # endif
 #endif
 
+#include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 
 #include <boost/config/abi_prefix.hpp>
@@ -45,6 +55,29 @@ namespace boost
             int res = pthread_attr_init(&val_);
             BOOST_VERIFY(!res && "pthread_attr_init failed");
         }
+        thread_attributes(thread_attributes const& other) {
+            int res = pthread_attr_init(&val_);
+            BOOST_VERIFY(!res && "pthread_attr_init failed");
+            BOOST_TRY {
+              copy_from(other);
+            } BOOST_CATCH (...) {
+              // the destructor won't run
+              res = pthread_attr_destroy(&val_);
+              BOOST_VERIFY(!res && "pthread_attr_destroy failed");
+              BOOST_RETHROW
+            }
+            BOOST_CATCH_END
+        }
+        thread_attributes& operator=(thread_attributes const& other) {
+            if (this != &other) {
+              int res = pthread_attr_destroy(&val_);
+              BOOST_VERIFY(!res && "pthread_attr_destroy failed");
+              res = pthread_attr_init(&val_);
+              BOOST_VERIFY(!res && "pthread_attr_init failed");
+              copy_from(other);
+            }
+            return *this;
+        }
         ~thread_attributes() {
           int res = pthread_attr_destroy(&val_);
           BOOST_VERIFY(!res && "pthread_attr_destroy failed");
@@ -71,6 +104,125 @@ namespace boost
             BOOST_VERIFY(!res && "pthread_attr_getstacksize failed");
             return size;
         }
+
+#if defined __linux__ && defined __GLIBC__
+#define BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_AFFINITY
+        // affinity
+        /**
+         * \b Effects: Restricts the thread to the given CPUs from its creation, no restriction when cpus
+         * is empty.
+         *
+         * \b Throws: thread_resource_error when the system rejects the CPUs, and the attributes are
+         * unchanged.
+         */
+        void set_affinity(std::vector<unsigned> const& cpus) {
+          unsigned const count = cpus.empty() ? CPU_SETSIZE : *std::max_element(cpus.begin(), cpus.end()) + 1;
+          cpu_set_t* const set = CPU_ALLOC(count);
+          if (!set) boost::throw_exception(std::bad_alloc());
+          std::size_t const size = CPU_ALLOC_SIZE(count);
+          CPU_ZERO_S(size, set);
+          for (std::size_t i = 0; i < cpus.size(); ++i) CPU_SET_S(cpus[i], size, set);
+          // all the CPUs
+          if (cpus.empty()) std::memset(set, 0xff, size);
+          int res = pthread_attr_setaffinity_np(&val_, size, set);
+          CPU_FREE(set);
+          if (res) {
+            boost::throw_exception(thread_resource_error(res, "boost::thread_attributes::set_affinity() failed in pthread_attr_setaffinity_np"));
+          }
+        }
+
+        /**
+         * \b Returns: The CPUs set by set_affinity(), empty when the thread isn't restricted.
+         */
+        std::vector<unsigned> get_affinity() const {
+          std::vector<unsigned> cpus;
+          for (unsigned count = CPU_SETSIZE; count <= (1u << 20); count *= 2) {
+            cpu_set_t* const set = CPU_ALLOC(count);
+            if (!set) boost::throw_exception(std::bad_alloc());
+            std::size_t const size = CPU_ALLOC_SIZE(count);
+            int const res = pthread_attr_getaffinity_np(&val_, size, set);
+            if (res == 0) {
+              for (unsigned cpu = 0; cpu < size * 8; ++cpu) {
+                if (CPU_ISSET_S(cpu, size, set)) cpus.push_back(cpu);
+              }
+              // without restriction, all the CPUs are set
+              if (cpus.size() == size * 8) cpus.clear();
+            }
+            CPU_FREE(set);
+            if (res != EINVAL) break;
+          }
+          return cpus;
+        }
+#endif
+
+        // scheduling
+        /**
+         * \b Effects: The thread is created with the given scheduling policy, e.g. SCHED_FIFO, and
+         * priority instead of inheriting them.
+         *
+         * \b Throws: thread_resource_error when the priority isn't one of the policy, or the system
+         * rejects them, and the attributes are unchanged.
+         *
+         * Creating the thread fails with thread_resource_error when the process isn't allowed to use them.
+         */
+        void set_scheduling(int policy, int priority) {
+          int const min_priority = sched_get_priority_min(policy);
+          int const max_priority = sched_get_priority_max(policy);
+          if (min_priority == -1 || max_priority == -1 || priority < min_priority || priority > max_priority) {
+            boost::throw_exception(thread_resource_error(EINVAL, "boost::thread_attributes::set_scheduling() invalid policy or priority"));
+          }
+          int old_policy;
+          int res = pthread_attr_getschedpolicy(&val_, &old_policy);
+          BOOST_VERIFY(!res && "pthread_attr_getschedpolicy failed");
+          res = pthread_attr_setschedpolicy(&val_, policy);
+          if (res) {
+            boost::throw_exception(thread_resource_error(res, "boost::thread_attributes::set_scheduling() failed in pthread_attr_setschedpolicy"));
+          }
+          sched_param param = sched_param();
+          param.sched_priority = priority;
+          res = pthread_attr_setschedparam(&val_, &param);
+          if (res) {
+            pthread_attr_setschedpolicy(&val_, old_policy);
+            boost::throw_exception(thread_resource_error(res, "boost::thread_attributes::set_scheduling() failed in pthread_attr_setschedparam"));
+          }
+          res = pthread_attr_setinheritsched(&val_, PTHREAD_EXPLICIT_SCHED);
+          BOOST_VERIFY(!res && "pthread_attr_setinheritsched failed");
+        }
+
+        /**
+         * \b Effects: The thread is created with the given priority, in the scheduling policy set by
+         * set_scheduling() or SCHED_OTHER.
+         *
+         * \b Throws: thread_resource_error when the priority isn't one of the policy, and the attributes
+         * are unchanged.
+         */
+        void set_priority(int priority) {
+          int policy;
+          int res = pthread_attr_getschedpolicy(&val_, &policy);
+          BOOST_VERIFY(!res && "pthread_attr_getschedpolicy failed");
+          set_scheduling(policy, priority);
+        }
+
+        int get_priority() const BOOST_NOEXCEPT {
+          sched_param param;
+          int res = pthread_attr_getschedparam(&val_, &param);
+          BOOST_VERIFY(!res && "pthread_attr_getschedparam failed");
+          return param.sched_priority;
+        }
+
+        // name
+        /**
+         * \b Effects: Names the thread, as shown by debuggers and profilers, truncated to the 15
+         * characters allowed by the system. The thread names itself before calling its function.
+         */
+        void set_name(std::string const& name) {
+          name_ = name;
+        }
+
+        std::string const& get_name() const BOOST_NOEXCEPT {
+          return name_;
+        }
+
 #define BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_NATIVE_HANDLE
 
         typedef pthread_attr_t native_handle_type;
@@ -82,7 +234,31 @@ namespace boost
         }
 
     private:
+        // pthread_attr_t can't be copied, each attribute is copied on its own
+        void copy_from(thread_attributes const& other) {
+          pthread_attr_t const* const o = &other.val_;
+          int detach_state;
+          if (pthread_attr_getdetachstate(o, &detach_state) == 0) pthread_attr_setdetachstate(&val_, detach_state);
+          std::size_t size;
+          if (pthread_attr_getstacksize(o, &size) == 0) pthread_attr_setstacksize(&val_, size);
+          if (pthread_attr_getguardsize(o, &size) == 0) pthread_attr_setguardsize(&val_, size);
+          int inherit;
+          if (pthread_attr_getinheritsched(o, &inherit) == 0) pthread_attr_setinheritsched(&val_, inherit);
+          int policy;
+          if (pthread_attr_getschedpolicy(o, &policy) == 0) pthread_attr_setschedpolicy(&val_, policy);
+          sched_param param;
+          if (pthread_attr_getschedparam(o, &param) == 0) pthread_attr_setschedparam(&val_, &param);
+          int scope;
+          if (pthread_attr_getscope(o, &scope) == 0) pthread_attr_setscope(&val_, scope);
+#if defined BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_AFFINITY
+          std::vector<unsigned> const cpus = other.get_affinity();
+          if (!cpus.empty()) set_affinity(cpus);
+#endif
+          name_ = other.name_;
+        }
+
         pthread_attr_t val_;
+        std::string name_;
     };
 
     class thread;
@@ -97,12 +273,17 @@ namespace boost
             typedef void(*cleanup_func_t)(void*);
             typedef void(*cleanup_caller_t)(cleanup_func_t, void*);
 
+            // the key of the thread_specific_ptr owning the value, 0 when the node is empty
+            std::size_t key;
             cleanup_caller_t caller;
             cleanup_func_t func;
             void* value;
 
-            tss_data_node(cleanup_caller_t caller_,cleanup_func_t func_,void* value_):
-                caller(caller_),func(func_),value(value_)
+            tss_data_node():
+                key(0),caller(0),func(0),value(0)
+            {}
+            tss_data_node(std::size_t key_,cleanup_caller_t caller_,cleanup_func_t func_,void* value_):
+                key(key_),caller(caller_),func(func_),value(value_)
             {}
         };
 
@@ -120,7 +301,10 @@ namespace boost
             bool join_started;
             bool joined;
             boost::detail::thread_exit_callback_node* thread_exit_callbacks;
-            std::map<void const*,boost::detail::tss_data_node> tss_data;
+            // indexed by the slots of the thread_specific_ptrs, the last node is never empty
+            std::vector<boost::detail::tss_data_node> tss_data;
+            // the name set by the thread attributes, that the thread gives itself when it starts
+            std::string name;
 
 //#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
             // These data must be at the end so that the access to the other fields doesn't change
@@ -129,6 +313,13 @@ namespace boost
             pthread_mutex_t* cond_mutex;
             pthread_cond_t* current_cond;
 //#endif
+            // Always declared, so that the layout doesn't change when BOOST_THREAD_USES_FUTEX is
+            // defined, but only used then.
+            // the futex word of the condition_variable the thread is waiting on
+            boost::atomic<futex_word*> current_futex;
+            // the number of interrupt() calls using current_futex, which the thread waits for before
+            // returning from the wait
+            boost::atomic<unsigned> futex_interrupters;
             typedef std::vector<std::pair<condition_variable*, mutex*>
             //, hidden_allocator<std::pair<condition_variable*, mutex*> >
             > notify_list_t;
@@ -143,7 +334,7 @@ namespace boost
             // when BOOST_THREAD_PROVIDES_INTERRUPTIONS is defined.
             // Another option is to have them always
             bool interrupt_enabled;
-            bool interrupt_requested;
+            boost::atomic<bool> interrupt_requested;
 //#endif
             thread_data_base():
                 thread_handle(0),
@@ -153,6 +344,8 @@ namespace boost
                 cond_mutex(0),
                 current_cond(0),
 //#endif
+                current_futex(0),
+                futex_interrupters(0),
                 notify()
 //#ifndef BOOST_NO_EXCEPTIONS
                 , async_states_()
@@ -243,6 +436,65 @@ namespace boost
                 unlock_if_locked();
             }
         };
+
+#if defined BOOST_THREAD_USES_FUTEX
+        /**
+         * Registers the futex word the current thread waits on, so that thread::interrupt() can
+         * increment it and wake the thread without any mutex on the waiting side.
+         *
+         * The word must be read after the registration and the interruption checked after reading it:
+         * either the thread sees the interruption request, or interrupt() sees the word and changes it.
+         */
+        class futex_interruption_checker
+        {
+            thread_data_base* const thread_info;
+            bool const set;
+            bool registered;
+
+            void operator=(futex_interruption_checker&);
+        public:
+            explicit futex_interruption_checker(futex_word* word):
+                thread_info(detail::get_current_thread_data()),
+                set(thread_info && thread_info->interrupt_enabled), registered(set)
+            {
+                if(set)
+                {
+                    thread_info->current_futex.store(word);
+                }
+            }
+
+            // throws thread_interrupted if an interruption has been requested
+            void check_for_interruption()
+            {
+#ifndef BOOST_NO_EXCEPTIONS
+                if(set && thread_info->interrupt_requested.load() && thread_info->interrupt_requested.exchange(false))
+                {
+                    unregister();
+                    throw thread_interrupted(); // BOOST_NO_EXCEPTIONS protected
+                }
+#endif
+            }
+
+            // waits for the interrupt() calls using the word, so that it can be destroyed
+            void unregister() BOOST_NOEXCEPT
+            {
+                if(registered)
+                {
+                    thread_info->current_futex.store(0);
+                    while(thread_info->futex_interrupters.load() != 0)
+                    {
+                        BOOST_VERIFY(!sched_yield());
+                    }
+                    registered = false;
+                }
+            }
+
+            ~futex_interruption_checker()
+            {
+                unregister();
+            }
+        };
+#endif
 #endif
     }
 
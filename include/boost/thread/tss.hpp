@@ -9,6 +9,8 @@
 
 #include <boost/type_traits/add_reference.hpp>
 
+#include <cstddef>
+
 #include <boost/config/abi_prefix.hpp>
 
 namespace boost
@@ -21,8 +23,15 @@ namespace boost
             typedef void(*cleanup_caller_t)(cleanup_func_t, void*);
         }
 
-        BOOST_THREAD_DECL void set_tss_data(void const* key,detail::thread::cleanup_caller_t caller,detail::thread::cleanup_func_t func,void* tss_data,bool cleanup_existing);
-        BOOST_THREAD_DECL void* get_tss_data(void const* key);
+        // Each thread_specific_ptr owns a slot, the index of its value in the table of each thread.
+        // The slots of the destroyed thread_specific_ptrs are reused, but each pointer also gets a key
+        // that is never reused, so that the values a destroyed pointer left in the slot aren't seen by
+        // the next one, even if it is built at the same address.
+        BOOST_THREAD_DECL std::size_t allocate_tss_slot(std::size_t& key);
+        BOOST_THREAD_DECL void release_tss_slot(std::size_t slot);
+
+        BOOST_THREAD_DECL void set_tss_data(std::size_t key,std::size_t slot,detail::thread::cleanup_caller_t caller,detail::thread::cleanup_func_t func,void* tss_data,bool cleanup_existing);
+        BOOST_THREAD_DECL void* get_tss_data(std::size_t key,std::size_t slot);
     }
 
     template <typename T>
@@ -46,24 +55,32 @@ namespace boost
 
 
         detail::thread::cleanup_func_t cleanup;
+        // set by allocate_tss_slot()
+        std::size_t key;
+        std::size_t slot;
 
     public:
         typedef T element_type;
 
         thread_specific_ptr():
-            cleanup(reinterpret_cast<detail::thread::cleanup_func_t>(&default_deleter))
+            cleanup(reinterpret_cast<detail::thread::cleanup_func_t>(&default_deleter)),
+            key(0),
+            slot(detail::allocate_tss_slot(key))
         {}
         explicit thread_specific_ptr(void (*func_)(T*))
-          : cleanup(reinterpret_cast<detail::thread::cleanup_func_t>(func_))
+          : cleanup(reinterpret_cast<detail::thread::cleanup_func_t>(func_)),
+            key(0),
+            slot(detail::allocate_tss_slot(key))
         {}
         ~thread_specific_ptr()
         {
-            detail::set_tss_data(this,0,0,0,true);
+            detail::set_tss_data(key,slot,0,0,0,true);
+            detail::release_tss_slot(slot);
         }
 
         T* get() const
         {
-            return static_cast<T*>(detail::get_tss_data(this));
+            return static_cast<T*>(detail::get_tss_data(key,slot));
         }
         T* operator->() const
         {
@@ -76,7 +93,7 @@ namespace boost
         T* release()
         {
             T* const temp=get();
-            detail::set_tss_data(this,0,0,0,false);
+            detail::set_tss_data(key,slot,0,0,0,false);
             return temp;
         }
         void reset(T* new_value=0)
@@ -84,7 +101,7 @@ namespace boost
             T* const current_value=get();
             if(current_value!=new_value)
             {
-                detail::set_tss_data(this,&cleanup_caller,cleanup,new_value,true);
+                detail::set_tss_data(key,slot,&cleanup_caller,cleanup,new_value,true);
             }
         }
     };
@@ -20,6 +20,7 @@
 #endif
 
 #include <map>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -37,7 +38,8 @@ namespace boost
 
   class thread_attributes {
   public:
-      thread_attributes() BOOST_NOEXCEPT {
+      thread_attributes() BOOST_NOEXCEPT :
+        priority_(0) {
         val_.stack_size = 0;
         //val_.lpThreadAttributes=0;
       }
@@ -52,6 +54,45 @@ namespace boost
           return val_.stack_size;
       }
 
+#define BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_AFFINITY
+      // affinity
+      /**
+       * \b Effects: Restricts the thread to the given CPUs of its processor group from its creation,
+       * no restriction when cpus is empty.
+       */
+      void set_affinity(std::vector<unsigned> const& cpus) {
+        affinity_ = cpus;
+      }
+
+      std::vector<unsigned> get_affinity() const {
+        return affinity_;
+      }
+
+      // scheduling
+      /**
+       * \b Effects: The thread is created with the given priority, e.g. THREAD_PRIORITY_HIGHEST.
+       */
+      void set_priority(int priority) BOOST_NOEXCEPT {
+        priority_ = priority;
+      }
+
+      int get_priority() const BOOST_NOEXCEPT {
+        return priority_;
+      }
+
+      // name
+      /**
+       * \b Effects: Names the thread, as shown by debuggers and profilers, where SetThreadDescription
+       * is available.
+       */
+      void set_name(std::string const& name) {
+        name_ = name;
+      }
+
+      std::string const& get_name() const BOOST_NOEXCEPT {
+        return name_;
+      }
+
       //void set_security(LPSECURITY_ATTRIBUTES lpThreadAttributes)
       //{
       //  val_.lpThreadAttributes=lpThreadAttributes;
@@ -71,6 +112,10 @@ namespace boost
 
   private:
       win_attrs val_;
+      std::vector<unsigned> affinity_;
+      // THREAD_PRIORITY_NORMAL
+      int priority_;
+      std::string name_;
   };
 
     namespace detail
@@ -83,12 +128,17 @@ namespace boost
             typedef void(*cleanup_func_t)(void*);
             typedef void(*cleanup_caller_t)(cleanup_func_t, void*);
 
+            // the key of the thread_specific_ptr owning the value, 0 when the node is empty
+            std::size_t key;
             cleanup_caller_t caller;
             cleanup_func_t func;
             void* value;
 
-            tss_data_node(cleanup_caller_t caller_,cleanup_func_t func_,void* value_):
-                caller(caller_),func(func_),value(value_)
+            tss_data_node():
+                key(0),caller(0),func(0),value(0)
+            {}
+            tss_data_node(std::size_t key_,cleanup_caller_t caller_,cleanup_func_t func_,void* value_):
+                key(key_),caller(caller_),func(func_),value(value_)
             {}
         };
 
@@ -110,7 +160,8 @@ namespace boost
 
             boost::detail::thread_exit_callback_node* thread_exit_callbacks;
             unsigned id;
-            std::map<void const*,boost::detail::tss_data_node> tss_data;
+            // indexed by the slots of the thread_specific_ptrs, the last node is never empty
+            std::vector<boost::detail::tss_data_node> tss_data;
             typedef std::vector<std::pair<condition_variable*, mutex*>
             //, hidden_allocator<std::pair<condition_variable*, mutex*> >
             > notify_list_t;
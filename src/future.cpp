@@ -4,6 +4,114 @@
 // LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/recycling_allocator.hpp>
+
+namespace boost
+{
+  namespace thread_detail
+  {
+    namespace
+    {
+      const std::size_t recycled_granularity = 64;
+      const std::size_t recycled_classes = 16;
+      const std::size_t recycled_per_class = 32;
+
+      std::size_t recycled_class(std::size_t size)
+      {
+        return size == 0 ? 0 : (size - 1) / recycled_granularity;
+      }
+
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+      struct recycled_block
+      {
+        recycled_block* next;
+      };
+
+      // Trivially destructible, so that the blocks released by the destructors of the thread locals and
+      // of the thread specific data run after recycled_blocks_owner still find it, and then go back to
+      // ::operator delete.
+      struct recycled_blocks
+      {
+        enum state_type { unowned, owned, released };
+        recycled_block* free[recycled_classes];
+        unsigned count[recycled_classes];
+        state_type state;
+      };
+      thread_local recycled_blocks local_recycled_blocks;
+
+      struct recycled_blocks_owner
+      {
+        recycled_blocks_owner()
+        {
+          local_recycled_blocks.state = recycled_blocks::owned;
+        }
+        ~recycled_blocks_owner()
+        {
+          local_recycled_blocks.state = recycled_blocks::released;
+          for (std::size_t c = 0; c < recycled_classes; ++c)
+          {
+            while (recycled_block* b = local_recycled_blocks.free[c])
+            {
+              local_recycled_blocks.free[c] = b->next;
+              ::operator delete(b);
+            }
+            local_recycled_blocks.count[c] = 0;
+          }
+        }
+      };
+
+      void own_recycled_blocks()
+      {
+        static thread_local recycled_blocks_owner owner;
+      }
+#endif
+    }
+
+    void* allocate_recycled(std::size_t size)
+    {
+      const std::size_t c = recycled_class(size);
+      if (c >= recycled_classes)
+      {
+        return ::operator new(size);
+      }
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+      recycled_blocks& blocks = local_recycled_blocks;
+      if (recycled_block* b = blocks.free[c])
+      {
+        blocks.free[c] = b->next;
+        --blocks.count[c];
+        return b;
+      }
+      if (blocks.state == recycled_blocks::unowned)
+      {
+        // the owner of the blocks of this thread releases them at thread exit
+        own_recycled_blocks();
+      }
+#endif
+      // a whole size class, so that the block can be reused for any size of its class
+      return ::operator new((c + 1) * recycled_granularity);
+    }
+
+    void deallocate_recycled(void* p, std::size_t size) BOOST_NOEXCEPT
+    {
+      const std::size_t c = recycled_class(size);
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+      recycled_blocks& blocks = local_recycled_blocks;
+      if (c < recycled_classes && blocks.state == recycled_blocks::owned && blocks.count[c] < recycled_per_class)
+      {
+        recycled_block* b = static_cast<recycled_block*>(p);
+        b->next = blocks.free[c];
+        blocks.free[c] = b;
+        ++blocks.count[c];
+        return;
+      }
+#else
+      static_cast<void>(c);
+#endif
+      ::operator delete(p);
+    }
+  }
+}
 
 #ifndef BOOST_NO_EXCEPTIONS
 
@@ -15,6 +15,13 @@
 #include <boost/memory_order.hpp>
 #include <pthread.h>
 
+#if defined BOOST_THREAD_USES_FUTEX && BOOST_ATOMIC_INT_LOCK_FREE == 2
+#include <boost/thread/pthread/futex.hpp>
+#include <boost/type_traits/is_same.hpp>
+// each once_flag is the futex word its waiters block on
+#define BOOST_THREAD_ONCE_USES_FUTEX
+#endif
+
 namespace boost
 {
   namespace thread_detail
@@ -22,14 +29,70 @@ namespace boost
 
     enum flag_states
     {
-      uninitialized, in_progress, initialized
+      uninitialized, in_progress, initialized,
+      // in_progress, with threads waiting for the initialization to complete
+      in_progress_with_waiters
     };
-
+    BOOST_STATIC_ASSERT(initialized == once_flag_initialized);
 
 #ifndef BOOST_THREAD_PROVIDES_ONCE_CXX11
     BOOST_STATIC_ASSERT_MSG(sizeof(atomic_int_type) == sizeof(atomic_type), "Boost.Thread: unsupported platform");
 #endif
 
+#if defined BOOST_THREAD_ONCE_USES_FUTEX
+    BOOST_STATIC_ASSERT((is_same<atomic_type, detail::futex_word>::value));
+
+    BOOST_THREAD_DECL bool enter_once_region(once_flag& flag) BOOST_NOEXCEPT
+    {
+      atomic_type& f = get_atomic_storage(flag);
+      atomic_int_type state = f.load(memory_order_acquire);
+      for (;;)
+      {
+        if (state == initialized)
+        {
+          // Another thread managed to complete the initialization
+          return false;
+        }
+        if (state == uninitialized)
+        {
+          if (f.compare_exchange_weak(state, in_progress, memory_order_acq_rel, memory_order_acquire))
+          {
+            // We have set the flag to in_progress
+            return true;
+          }
+        }
+        else if (state == in_progress
+            && ! f.compare_exchange_weak(state, in_progress_with_waiters, memory_order_acquire, memory_order_acquire))
+        {
+          // The state changed, check it again
+        }
+        else
+        {
+          // Wait until the initialization is complete or rolled back
+          detail::futex::wait(f, in_progress_with_waiters);
+          state = f.load(memory_order_acquire);
+        }
+      }
+    }
+
+    BOOST_THREAD_DECL void commit_once_region(once_flag& flag) BOOST_NOEXCEPT
+    {
+      atomic_type& f = get_atomic_storage(flag);
+      if (f.exchange(initialized, memory_order_release) == in_progress_with_waiters)
+      {
+        detail::futex::wake_all(f);
+      }
+    }
+
+    BOOST_THREAD_DECL void rollback_once_region(once_flag& flag) BOOST_NOEXCEPT
+    {
+      atomic_type& f = get_atomic_storage(flag);
+      if (f.exchange(uninitialized, memory_order_release) == in_progress_with_waiters)
+      {
+        detail::futex::wake_all(f);
+      }
+    }
+#else
     static pthread_mutex_t once_mutex = PTHREAD_MUTEX_INITIALIZER;
     static pthread_cond_t once_cv = PTHREAD_COND_INITIALIZER;
 
@@ -85,6 +148,7 @@ namespace boost
       }
       BOOST_VERIFY(!posix::pthread_cond_broadcast(&once_cv));
     }
+#endif
 
   } // namespace thread_detail
 
@@ -19,6 +19,7 @@
 #include <boost/thread/future.hpp>
 #include <boost/thread/pthread/pthread_helpers.hpp>
 #include <boost/thread/pthread/pthread_mutex_scoped_lock.hpp>
+#include <boost/thread/detail/cpu_topology.hpp>
 
 #ifdef __GLIBC__
 #include <sys/sysinfo.h>
@@ -37,11 +38,19 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <cstdlib>
 #include <fstream>
+#include <map>
+#include <sstream>
 #include <string>
 #include <set>
 #include <vector>
-#include <string.h> // memcmp.
+#include <errno.h>
+#include <string.h> // memcmp, strncpy.
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
 
 namespace boost
 {
@@ -75,6 +84,19 @@ namespace boost
             {}
         };
 
+        void erase_tss_node(thread_data_base& thread_data,std::size_t slot,std::size_t key)
+        {
+            std::vector<tss_data_node>& nodes=thread_data.tss_data;
+            if((slot<nodes.size()) && (nodes[slot].key==key))
+            {
+                nodes[slot]=tss_data_node();
+                while(!nodes.empty() && !nodes.back().key)
+                {
+                    nodes.pop_back();
+                }
+            }
+        }
+
         namespace
         {
 #ifdef BOOST_THREAD_PROVIDES_ONCE_CXX11
@@ -83,11 +105,21 @@ namespace boost
             boost::once_flag current_thread_tls_init_flag=BOOST_ONCE_INIT;
 #endif
             pthread_key_t current_thread_tls_key;
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+            // The value of current_thread_tls_key for the current thread, cached once read or set, so
+            // that the current thread data is found without the once check and the key lookup.
+            thread_local boost::detail::thread_data_base* current_thread_data_cache=0;
+            thread_local bool current_thread_data_cached=false;
+#endif
 
             extern "C"
             {
                 static void tls_destructor(void* data)
                 {
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+                    // when called as the key destructor, the key has already been reset
+                    current_thread_data_cached=false;
+#endif
                     //boost::detail::thread_data_base* thread_info=static_cast<boost::detail::thread_data_base*>(data);
                     boost::detail::thread_data_ptr thread_info = static_cast<boost::detail::thread_data_base*>(data)->shared_from_this();
 
@@ -107,15 +139,15 @@ namespace boost
                                 }
                                 delete current_node;
                             }
-                            while (!thread_info->tss_data.empty())
+                            for(std::size_t slot=0;slot<thread_info->tss_data.size();++slot)
                             {
-                                std::map<void const*,detail::tss_data_node>::iterator current
-                                    = thread_info->tss_data.begin();
-                                if(current->second.func && (current->second.value!=0))
+                                // the cleanup function can set values, growing the table
+                                detail::tss_data_node const current=thread_info->tss_data[slot];
+                                if(current.func && (current.value!=0))
                                 {
-                                    (*current->second.caller)(current->second.func,current->second.value);
+                                    (*current.caller)(current.func,current.value);
                                 }
-                                thread_info->tss_data.erase(current);
+                                detail::erase_tss_node(*thread_info,slot,current.key);
                             }
                         }
                         thread_info->self.reset();
@@ -151,19 +183,48 @@ namespace boost
 
         boost::detail::thread_data_base* get_current_thread_data()
         {
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+            if(current_thread_data_cached)
+            {
+                return current_thread_data_cache;
+            }
+#endif
             boost::call_once(current_thread_tls_init_flag,&create_current_thread_tls_key);
-            return (boost::detail::thread_data_base*)pthread_getspecific(current_thread_tls_key);
+            boost::detail::thread_data_base* const current_thread_data=
+                (boost::detail::thread_data_base*)pthread_getspecific(current_thread_tls_key);
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+            current_thread_data_cache=current_thread_data;
+            current_thread_data_cached=true;
+#endif
+            return current_thread_data;
         }
 
         void set_current_thread_data(detail::thread_data_base* new_data)
         {
             boost::call_once(current_thread_tls_init_flag,create_current_thread_tls_key);
             BOOST_VERIFY(!pthread_setspecific(current_thread_tls_key,new_data));
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+            current_thread_data_cache=new_data;
+            current_thread_data_cached=true;
+#endif
         }
     }
 
     namespace
     {
+        void set_current_thread_name(std::string const& name) BOOST_NOEXCEPT
+        {
+#if defined __linux__ && defined __GLIBC__
+            // the name is at most 15 characters long
+            char truncated[16];
+            strncpy(truncated,name.c_str(),sizeof(truncated)-1);
+            truncated[sizeof(truncated)-1]=0;
+            pthread_setname_np(pthread_self(),truncated);
+#elif defined(__APPLE__)
+            pthread_setname_np(name.c_str());
+#endif
+        }
+
         extern "C"
         {
             static void* thread_proxy(void* param)
@@ -172,6 +233,10 @@ namespace boost
                 boost::detail::thread_data_ptr thread_info = static_cast<boost::detail::thread_data_base*>(param)->shared_from_this();
                 thread_info->self.reset();
                 detail::set_current_thread_data(thread_info.get());
+                if(!thread_info->name.empty())
+                {
+                    set_current_thread_name(thread_info->name);
+                }
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                 BOOST_TRY
                 {
@@ -271,6 +336,15 @@ namespace boost
 
     bool thread::start_thread_noexcept(const attributes& attr)
     {
+        BOOST_TRY
+        {
+            thread_info->name=attr.get_name();
+        }
+        BOOST_CATCH(...)
+        {
+            return false;
+        }
+        BOOST_CATCH_END
         thread_info->self=thread_info;
         const attributes::native_handle_type* h = attr.native_handle();
         int res = pthread_create(&thread_info->thread_handle, h, &thread_proxy, thread_info.get());
@@ -484,40 +558,42 @@ namespace boost
 #   endif
         }
     }
-    unsigned thread::hardware_concurrency() BOOST_NOEXCEPT
+    namespace
     {
+        unsigned system_hardware_concurrency() BOOST_NOEXCEPT
+        {
 #if defined(PTW32_VERSION) || defined(__hpux)
-        return pthread_num_processors_np();
+            return pthread_num_processors_np();
 #elif defined(__APPLE__) || defined(__FreeBSD__)
-        int count;
-        size_t size=sizeof(count);
-        return sysctlbyname("hw.ncpu",&count,&size,NULL,0)?0:count;
+            int count;
+            size_t size=sizeof(count);
+            return sysctlbyname("hw.ncpu",&count,&size,NULL,0)?0:count;
 #elif defined(BOOST_HAS_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
-        int const count=sysconf(_SC_NPROCESSORS_ONLN);
-        return (count>0)?count:0;
+            int const count=sysconf(_SC_NPROCESSORS_ONLN);
+            return (count>0)?count:0;
 #elif defined(__VXWORKS__)
-        cpuset_t set =  ::vxCpuEnabledGet();
-  #ifdef __DCC__
-        int i;
-        for( i = 0; set; ++i)
-        {
-           set &= set -1;
-        }
-        return(i);
-  #else
-        return (__builtin_popcount(set) );
-  #endif
+            cpuset_t set =  ::vxCpuEnabledGet();
+      #ifdef __DCC__
+            int i;
+            for( i = 0; set; ++i)
+            {
+               set &= set -1;
+            }
+            return(i);
+      #else
+            return (__builtin_popcount(set) );
+      #endif
 #elif defined(__GLIBC__)
-        return get_nprocs();
+            return get_nprocs();
 #else
-        return 0;
+            return 0;
 #endif
-    }
+        }
 
-    unsigned thread::physical_concurrency() BOOST_NOEXCEPT
-    {
 #ifdef __linux__
-        try {
+        // The number of cores of the system, 0 when /proc/cpuinfo is formatted differently than we expect.
+        unsigned proc_cpuinfo_physical_concurrency()
+        {
             using namespace std;
 
             ifstream proc_cpuinfo ("/proc/cpuinfo");
@@ -539,7 +615,7 @@ namespace boost
                 boost::split(key_val, line, boost::is_any_of(":"));
 
                 if (key_val.size() != 2)
-                  return hardware_concurrency();
+                  return 0;
 
                 string key   = key_val[0];
                 string value = key_val[1];
@@ -557,12 +633,326 @@ namespace boost
                     continue;
                 }
             }
-            // Fall back to hardware_concurrency() in case
-            // /proc/cpuinfo is formatted differently than we expect.
-            return cores.size() != 0 ? cores.size() : hardware_concurrency();
-        } catch(...) {
-          return hardware_concurrency();
+            return static_cast<unsigned>(cores.size());
+        }
+
+        typedef std::vector<std::vector<unsigned> > cpu_groups;
+
+        struct cpu_topology
+        {
+            // the CPUs the process can run on, limited by the CPU quota of its cgroups
+            unsigned logical_cpus;
+            // the cores of the CPUs the process can run on, limited by the CPU quota of its cgroups
+            unsigned physical_cores;
+            // the CPUs the process can run on, grouped by core and by NUMA node, empty when unknown
+            cpu_groups cores;
+            cpu_groups nodes;
+        };
+
+        // The number of CPUs the quota of dir allows, 0 when there is no quota. The quota of a cgroup
+        // is limited by the quotas of its parents, up to the root of the hierarchy.
+        unsigned cgroup_cpu_limit(std::string const& root, std::string path, bool v2)
+        {
+            unsigned limit=0;
+            for(;;)
+            {
+                std::string const dir=root+path;
+                long quota=-1;
+                long period=0;
+                if(v2)
+                {
+                    std::ifstream cpu_max((dir+"/cpu.max").c_str());
+                    std::string quota_str;
+                    if(cpu_max>>quota_str>>period && quota_str!="max")
+                    {
+                        quota=std::atol(quota_str.c_str());
+                    }
+                }
+                else
+                {
+                    std::ifstream cfs_quota((dir+"/cpu.cfs_quota_us").c_str());
+                    std::ifstream cfs_period((dir+"/cpu.cfs_period_us").c_str());
+                    if(!(cfs_quota>>quota && cfs_period>>period))
+                    {
+                        quota=-1;
+                    }
+                }
+                if(quota>0 && period>0)
+                {
+                    unsigned const cpus=static_cast<unsigned>((quota+period-1)/period);
+                    if(limit==0 || cpus<limit)
+                    {
+                        limit=cpus;
+                    }
+                }
+                std::string::size_type const slash=path.find_last_of('/');
+                if(slash==std::string::npos || path.size()<=1)
+                {
+                    return limit;
+                }
+                path.erase(slash==0?1:slash);
+            }
+        }
+
+        // The number of CPUs allowed by the CPU quota of the cgroups of the process, 0 when unlimited.
+        unsigned cgroup_cpu_limit()
+        {
+            std::ifstream proc_cgroup("/proc/self/cgroup");
+            std::string line;
+            while(std::getline(proc_cgroup,line))
+            {
+                // hierarchy-ID:controller-list:cgroup-path
+                std::string::size_type const first=line.find(':');
+                std::string::size_type const second=line.find(':',first+1);
+                if(first==std::string::npos || second==std::string::npos)
+                {
+                    continue;
+                }
+                std::string const controllers=","+line.substr(first+1,second-first-1)+",";
+                std::string const path=line.substr(second+1);
+                if(controllers==",,")
+                {
+                    if(unsigned const limit=cgroup_cpu_limit("/sys/fs/cgroup",path,true))
+                    {
+                        return limit;
+                    }
+                }
+                else if(controllers.find(",cpu,")!=std::string::npos)
+                {
+                    // the cgroup can be the root of the hierarchy mounted in a container
+                    if(unsigned const limit=cgroup_cpu_limit("/sys/fs/cgroup/cpu,cpuacct",path,false))
+                    {
+                        return limit;
+                    }
+                    if(unsigned const limit=cgroup_cpu_limit("/sys/fs/cgroup/cpu",path,false))
+                    {
+                        return limit;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // The CPUs of the affinity mask of the process, empty when it can't be read. This is the mask
+        // of the main thread, that the other threads inherit, not the one of the calling thread: the
+        // result is cached, and the first call may come from a thread pinned to some of the CPUs.
+        std::vector<unsigned> affinity_cpus()
+        {
+            std::vector<unsigned> cpus;
+            for(int count=1024;count<=(1<<20);count*=2)
+            {
+                cpu_set_t* const set=CPU_ALLOC(count);
+                if(!set)
+                {
+                    break;
+                }
+                std::size_t const size=CPU_ALLOC_SIZE(count);
+                if(sched_getaffinity(getpid(),size,set)==0)
+                {
+                    for(int cpu=0;cpu<count;++cpu)
+                    {
+                        if(CPU_ISSET_S(cpu,size,set))
+                        {
+                            cpus.push_back(static_cast<unsigned>(cpu));
+                        }
+                    }
+                    CPU_FREE(set);
+                    break;
+                }
+                CPU_FREE(set);
+                if(errno!=EINVAL)
+                {
+                    break;
+                }
+            }
+            return cpus;
+        }
+
+        // The CPUs of cpus grouped by core, false when sysfs doesn't describe the topology.
+        bool sysfs_cores(std::vector<unsigned> const& cpus, cpu_groups& cores)
+        {
+            typedef std::pair<unsigned, unsigned> core_entry; // [package id, core id]
+            std::map<core_entry, std::vector<unsigned> > cpus_of_core;
+            for(std::size_t i=0;i<cpus.size();++i)
+            {
+                std::string const topology="/sys/devices/system/cpu/cpu"+boost::lexical_cast<std::string>(cpus[i])+"/topology/";
+                std::ifstream package_id((topology+"physical_package_id").c_str());
+                std::ifstream core_id((topology+"core_id").c_str());
+                core_entry core;
+                if(!(package_id>>core.first && core_id>>core.second))
+                {
+                    return false;
+                }
+                cpus_of_core[core].push_back(cpus[i]);
+            }
+            for(std::map<core_entry, std::vector<unsigned> >::const_iterator it=cpus_of_core.begin();it!=cpus_of_core.end();++it)
+            {
+                cores.push_back(it->second);
+            }
+            return true;
         }
+
+        // Parses a sysfs CPU or node list, e.g. "0-3,8-11".
+        std::vector<unsigned> parse_sysfs_list(std::string const& list)
+        {
+            std::vector<unsigned> ids;
+            std::istringstream in(list);
+            std::string range;
+            while(std::getline(in,range,','))
+            {
+                std::string::size_type const dash=range.find('-');
+                unsigned const first=boost::lexical_cast<unsigned>(boost::trim_copy(range.substr(0,dash)));
+                unsigned const last=(dash==std::string::npos)?first:boost::lexical_cast<unsigned>(boost::trim_copy(range.substr(dash+1)));
+                for(unsigned id=first;id<=last;++id)
+                {
+                    ids.push_back(id);
+                }
+            }
+            return ids;
+        }
+
+        // The CPUs of cpus grouped by NUMA node, nothing when sysfs doesn't describe the nodes.
+        void sysfs_nodes(std::vector<unsigned> const& cpus, cpu_groups& nodes)
+        {
+            std::ifstream online_nodes("/sys/devices/system/node/online");
+            std::string list;
+            if(!std::getline(online_nodes,list))
+            {
+                return;
+            }
+            std::set<unsigned> const allowed(cpus.begin(),cpus.end());
+            std::vector<unsigned> const node_ids=parse_sysfs_list(list);
+            for(std::size_t i=0;i<node_ids.size();++i)
+            {
+                std::ifstream node_cpus(("/sys/devices/system/node/node"+boost::lexical_cast<std::string>(node_ids[i])+"/cpulist").c_str());
+                std::string cpu_list;
+                std::getline(node_cpus,cpu_list);
+                std::vector<unsigned> const node=parse_sysfs_list(cpu_list);
+                std::vector<unsigned> node_allowed;
+                for(std::size_t j=0;j<node.size();++j)
+                {
+                    if(allowed.count(node[j]))
+                    {
+                        node_allowed.push_back(node[j]);
+                    }
+                }
+                if(!node_allowed.empty())
+                {
+                    nodes.push_back(node_allowed);
+                }
+            }
+        }
+
+        cpu_topology probed_topology;
+#ifdef BOOST_THREAD_PROVIDES_ONCE_CXX11
+        boost::once_flag probed_topology_flag;
+#else
+        boost::once_flag probed_topology_flag=BOOST_ONCE_INIT;
+#endif
+
+        void probe_cpu_topology()
+        {
+            unsigned logical_cpus=0;
+            unsigned physical_cores=0;
+            try
+            {
+                std::vector<unsigned> const cpus=affinity_cpus();
+                if(!cpus.empty())
+                {
+                    logical_cpus=static_cast<unsigned>(cpus.size());
+                    if(sysfs_cores(cpus,probed_topology.cores))
+                    {
+                        physical_cores=static_cast<unsigned>(probed_topology.cores.size());
+                    }
+                    else
+                    {
+                        probed_topology.cores.clear();
+                    }
+                    try
+                    {
+                        sysfs_nodes(cpus,probed_topology.nodes);
+                    }
+                    catch(...)
+                    {
+                        probed_topology.nodes.clear();
+                    }
+                }
+                if(logical_cpus==0)
+                {
+                    logical_cpus=system_hardware_concurrency();
+                }
+                if(physical_cores==0)
+                {
+                    try
+                    {
+                        physical_cores=proc_cpuinfo_physical_concurrency();
+                    }
+                    catch(...)
+                    {
+                    }
+                }
+                unsigned const limit=cgroup_cpu_limit();
+                if(limit!=0 && limit<logical_cpus)
+                {
+                    logical_cpus=limit;
+                }
+            }
+            catch(...)
+            {
+                logical_cpus=system_hardware_concurrency();
+                probed_topology.cores.clear();
+                probed_topology.nodes.clear();
+            }
+            if(physical_cores==0 || physical_cores>logical_cpus)
+            {
+                physical_cores=logical_cpus;
+            }
+            probed_topology.logical_cpus=logical_cpus;
+            probed_topology.physical_cores=physical_cores;
+        }
+
+        cpu_topology const& get_cpu_topology()
+        {
+            boost::call_once(probed_topology_flag,&probe_cpu_topology);
+            return probed_topology;
+        }
+#endif
+    }
+
+    namespace detail
+    {
+        std::vector<std::vector<unsigned> > cpus_by_core()
+        {
+#ifdef __linux__
+            return get_cpu_topology().cores;
+#else
+            return std::vector<std::vector<unsigned> >();
+#endif
+        }
+
+        std::vector<std::vector<unsigned> > cpus_by_node()
+        {
+#ifdef __linux__
+            return get_cpu_topology().nodes;
+#else
+            return std::vector<std::vector<unsigned> >();
+#endif
+        }
+    }
+
+    unsigned thread::hardware_concurrency() BOOST_NOEXCEPT
+    {
+#ifdef __linux__
+        return get_cpu_topology().logical_cpus;
+#else
+        return system_hardware_concurrency();
+#endif
+    }
+
+    unsigned thread::physical_concurrency() BOOST_NOEXCEPT
+    {
+#ifdef __linux__
+        return get_cpu_topology().physical_cores;
 #elif defined(__APPLE__)
         int count;
         size_t size=sizeof(count);
@@ -580,6 +970,17 @@ namespace boost
         {
             lock_guard<mutex> lk(local_thread_info->data_mutex);
             local_thread_info->interrupt_requested=true;
+#if defined BOOST_THREAD_USES_FUTEX
+            // the waiting thread doesn't return until futex_interrupters is back to 0, so that the
+            // condition_variable can't be destroyed while its word is used
+            local_thread_info->futex_interrupters.fetch_add(1);
+            if(detail::futex_word* const word=local_thread_info->current_futex.load())
+            {
+                word->fetch_add(1);
+                detail::futex::wake_all(*word);
+            }
+            local_thread_info->futex_interrupters.fetch_sub(1);
+#endif
             if(local_thread_info->current_cond)
             {
                 boost::pthread::pthread_mutex_scoped_lock internal_lock(local_thread_info->cond_mutex);
@@ -626,7 +1027,8 @@ namespace boost
         {
 #ifndef BOOST_NO_EXCEPTIONS
             boost::detail::thread_data_base* const thread_info=detail::get_current_thread_data();
-            if(thread_info && thread_info->interrupt_enabled)
+            // interrupt() sets interrupt_requested under data_mutex, which is only needed to reset it
+            if(thread_info && thread_info->interrupt_enabled && thread_info->interrupt_requested)
             {
                 lock_guard<mutex> lg(thread_info->data_mutex);
                 if(thread_info->interrupt_requested)
@@ -653,7 +1055,6 @@ namespace boost
             }
             else
             {
-                lock_guard<mutex> lg(thread_info->data_mutex);
                 return thread_info->interrupt_requested;
             }
         }
@@ -703,73 +1104,124 @@ namespace boost
             current_thread_data->thread_exit_callbacks=new_node;
         }
 
-        tss_data_node* find_tss_data(void const* key)
+        namespace
+        {
+            pthread_mutex_t tss_slots_mutex=PTHREAD_MUTEX_INITIALIZER;
+            std::size_t tss_slots_count=0;
+            // the last key given to a thread_specific_ptr, 0 is the key of the empty nodes
+            std::size_t tss_last_key=0;
+
+            // Called under tss_slots_mutex by allocate_tss_slot, so that the list is constructed
+            // before, and destroyed after, any thread_specific_ptr.
+            std::vector<std::size_t>& free_tss_slots()
+            {
+                static std::vector<std::size_t> slots;
+                return slots;
+            }
+        }
+
+        std::size_t allocate_tss_slot(std::size_t& key)
+        {
+            pthread::pthread_mutex_scoped_lock lk(&tss_slots_mutex);
+            if(++tss_last_key==0)
+            {
+                ++tss_last_key;
+            }
+            key=tss_last_key;
+            std::vector<std::size_t>& free_slots=free_tss_slots();
+            if(free_slots.empty())
+            {
+                return tss_slots_count++;
+            }
+            std::size_t const slot=free_slots.back();
+            free_slots.pop_back();
+            return slot;
+        }
+
+        void release_tss_slot(std::size_t slot)
+        {
+            pthread::pthread_mutex_scoped_lock lk(&tss_slots_mutex);
+            free_tss_slots().push_back(slot);
+        }
+
+        tss_data_node* find_tss_data(std::size_t key,std::size_t slot)
         {
             detail::thread_data_base* const current_thread_data(get_current_thread_data());
-            if(current_thread_data)
+            if(current_thread_data && (slot<current_thread_data->tss_data.size()))
             {
-                std::map<void const*,tss_data_node>::iterator current_node=
-                    current_thread_data->tss_data.find(key);
-                if(current_node!=current_thread_data->tss_data.end())
+                tss_data_node& current_node=current_thread_data->tss_data[slot];
+                if(current_node.key==key)
                 {
-                    return &current_node->second;
+                    return &current_node;
                 }
             }
             return 0;
         }
 
-        void* get_tss_data(void const* key)
+        void* get_tss_data(std::size_t key,std::size_t slot)
         {
-            if(tss_data_node* const current_node=find_tss_data(key))
+            if(tss_data_node* const current_node=find_tss_data(key,slot))
             {
                 return current_node->value;
             }
             return 0;
         }
 
-        void add_new_tss_node(void const* key,
+        void add_new_tss_node(std::size_t key,std::size_t slot,
                               detail::tss_data_node::cleanup_caller_t caller,
                               detail::tss_data_node::cleanup_func_t func,
                               void* tss_data)
         {
             detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
-            current_thread_data->tss_data.insert(std::make_pair(key,tss_data_node(caller,func,tss_data)));
-        }
-
-        void erase_tss_node(void const* key)
-        {
-            detail::thread_data_base* const current_thread_data(get_current_thread_data());
-            if(current_thread_data)
+            if(slot>=current_thread_data->tss_data.size())
+            {
+                current_thread_data->tss_data.resize(slot+1);
+            }
+            tss_data_node& current_node=current_thread_data->tss_data[slot];
+            tss_data_node const previous=current_node;
+            current_node=tss_data_node(key,caller,func,tss_data);
+            // the value left by a destroyed thread_specific_ptr that had the same slot is cleaned
+            // up now rather than when the thread exits
+            if(previous.key && previous.func && (previous.value!=0))
             {
-                current_thread_data->tss_data.erase(key);
+                (*previous.caller)(previous.func,previous.value);
             }
         }
 
-        void set_tss_data(void const* key,
+        void set_tss_data(std::size_t key,std::size_t slot,
                           detail::tss_data_node::cleanup_caller_t caller,
                           detail::tss_data_node::cleanup_func_t func,
                           void* tss_data,bool cleanup_existing)
         {
-            if(tss_data_node* const current_node=find_tss_data(key))
+            if(tss_data_node* const current_node=find_tss_data(key,slot))
             {
-                if(cleanup_existing && current_node->func && (current_node->value!=0))
+                tss_data_node const current=*current_node;
+                if(cleanup_existing && current.func && (current.value!=0))
                 {
-                    (*current_node->caller)(current_node->func,current_node->value);
+                    (*current.caller)(current.func,current.value);
                 }
+                // the cleanup function can set values, invalidating current_node
                 if(func || (tss_data!=0))
                 {
-                    current_node->caller=caller;
-                    current_node->func=func;
-                    current_node->value=tss_data;
+                    if(tss_data_node* const node=find_tss_data(key,slot))
+                    {
+                        node->caller=caller;
+                        node->func=func;
+                        node->value=tss_data;
+                    }
+                    else
+                    {
+                        add_new_tss_node(key,slot,caller,func,tss_data);
+                    }
                 }
                 else
                 {
-                    erase_tss_node(key);
+                    erase_tss_node(*get_current_thread_data(),slot,key);
                 }
             }
             else if(func || (tss_data!=0))
             {
-                add_new_tss_node(key,caller,func,tss_data);
+                add_new_tss_node(key,slot,caller,func,tss_data);
             }
         }
     }
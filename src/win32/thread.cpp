@@ -14,6 +14,9 @@
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/detail/tss_hooks.hpp>
 #include <boost/thread/future.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/win32/basic_timed_mutex.hpp>
+#include <boost/thread/detail/cpu_topology.hpp>
 #include <boost/assert.hpp>
 #include <boost/cstdint.hpp>
 #if defined BOOST_THREAD_USES_DATETIME
@@ -23,6 +26,8 @@
 #include <boost/thread/csbl/memory/unique_ptr.hpp>
 #include <memory>
 #include <algorithm>
+#include <string>
+#include <vector>
 #ifndef UNDER_CE
 #include <process.h>
 #endif
@@ -188,6 +193,18 @@ namespace boost
             {}
         };
 
+        void erase_tss_node(thread_data_base& thread_data,std::size_t slot,std::size_t key)
+        {
+            std::vector<tss_data_node>& nodes=thread_data.tss_data;
+            if((slot<nodes.size()) && (nodes[slot].key==key))
+            {
+                nodes[slot]=tss_data_node();
+                while(!nodes.empty() && !nodes.back().key)
+                {
+                    nodes.pop_back();
+                }
+            }
+        }
     }
 
 #if BOOST_PLAT_WINDOWS_RUNTIME
@@ -270,15 +287,15 @@ namespace boost
                         }
                         boost::detail::heap_delete(current_node);
                     }
-                    while (!current_thread_data->tss_data.empty())
+                    for(std::size_t slot=0;slot<current_thread_data->tss_data.size();++slot)
                     {
-                        std::map<void const*,detail::tss_data_node>::iterator current
-                            = current_thread_data->tss_data.begin();
-                        if(current->second.func && (current->second.value!=0))
+                        // the cleanup function can set values, growing the table
+                        detail::tss_data_node const current=current_thread_data->tss_data[slot];
+                        if(current.func && (current.value!=0))
                         {
-                            (*current->second.caller)(current->second.func,current->second.value);
+                            (*current.caller)(current.func,current.value);
                         }
-                        current_thread_data->tss_data.erase(current);
+                        detail::erase_tss_node(*current_thread_data,slot,current.key);
                     }
                 }
                 set_current_thread_data(0);
@@ -307,6 +324,37 @@ namespace boost
         }
     }
 
+#if !BOOST_PLAT_WINDOWS_RUNTIME
+    namespace
+    {
+        typedef HRESULT (WINAPI *setthreaddescription_t)(HANDLE, PCWSTR);
+
+        // SetThreadDescription is available from Windows 10 1607
+        void set_thread_name(HANDLE thread_handle, std::string const& name)
+        {
+            setthreaddescription_t const set_thread_description=(setthreaddescription_t) GetProcAddress(
+#if !defined(BOOST_NO_ANSI_APIS)
+                GetModuleHandleA("KERNEL32.DLL"),
+#else
+                GetModuleHandleW(L"KERNEL32.DLL"),
+#endif
+                "SetThreadDescription");
+            if(!set_thread_description)
+            {
+                return;
+            }
+            int const length=MultiByteToWideChar(CP_UTF8,0,name.c_str(),-1,0,0);
+            if(length<=0)
+            {
+                return;
+            }
+            std::vector<wchar_t> wide_name(length);
+            MultiByteToWideChar(CP_UTF8,0,name.c_str(),-1,&wide_name[0],length);
+            set_thread_description(thread_handle,&wide_name[0]);
+        }
+    }
+#endif
+
     thread::thread() BOOST_NOEXCEPT
     {}
 
@@ -348,6 +396,28 @@ namespace boost
       }
       intrusive_ptr_add_ref(thread_info.get());
       thread_info->thread_handle=(detail::win32::handle)(new_thread);
+      // the thread is suspended until it has all its attributes
+      std::vector<unsigned> const cpus=attr.get_affinity();
+      if(!cpus.empty())
+      {
+        DWORD_PTR mask=0;
+        for(std::size_t i=0;i<cpus.size();++i)
+        {
+          if(cpus[i]<sizeof(mask)*8)
+          {
+            mask|=DWORD_PTR(1)<<cpus[i];
+          }
+        }
+        SetThreadAffinityMask(thread_info->thread_handle,mask);
+      }
+      if(attr.get_priority()!=THREAD_PRIORITY_NORMAL)
+      {
+        SetThreadPriority(thread_info->thread_handle,attr.get_priority());
+      }
+      if(!attr.get_name().empty())
+      {
+        set_thread_name(thread_info->thread_handle,attr.get_name());
+      }
       ResumeThread(thread_info->thread_handle);
       return true;
 #endif
@@ -887,6 +957,16 @@ namespace boost
 
     namespace detail
     {
+        std::vector<std::vector<unsigned> > cpus_by_core()
+        {
+            return std::vector<std::vector<unsigned> >();
+        }
+
+        std::vector<std::vector<unsigned> > cpus_by_node()
+        {
+            return std::vector<std::vector<unsigned> >();
+        }
+
         void add_thread_exit_function(thread_exit_function_base* func)
         {
             detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
@@ -896,70 +976,124 @@ namespace boost
             current_thread_data->thread_exit_callbacks=new_node;
         }
 
-        tss_data_node* find_tss_data(void const* key)
+        namespace
+        {
+            boost::detail::basic_timed_mutex tss_slots_mutex=BOOST_BASIC_TIMED_MUTEX_INITIALIZER;
+            std::size_t tss_slots_count=0;
+            // the last key given to a thread_specific_ptr, 0 is the key of the empty nodes
+            std::size_t tss_last_key=0;
+
+            // Called under tss_slots_mutex by allocate_tss_slot, so that the list is constructed
+            // before, and destroyed after, any thread_specific_ptr.
+            std::vector<std::size_t>& free_tss_slots()
+            {
+                static std::vector<std::size_t> slots;
+                return slots;
+            }
+        }
+
+        std::size_t allocate_tss_slot(std::size_t& key)
+        {
+            boost::lock_guard<boost::detail::basic_timed_mutex> lk(tss_slots_mutex);
+            if(++tss_last_key==0)
+            {
+                ++tss_last_key;
+            }
+            key=tss_last_key;
+            std::vector<std::size_t>& free_slots=free_tss_slots();
+            if(free_slots.empty())
+            {
+                return tss_slots_count++;
+            }
+            std::size_t const slot=free_slots.back();
+            free_slots.pop_back();
+            return slot;
+        }
+
+        void release_tss_slot(std::size_t slot)
+        {
+            boost::lock_guard<boost::detail::basic_timed_mutex> lk(tss_slots_mutex);
+            free_tss_slots().push_back(slot);
+        }
+
+        tss_data_node* find_tss_data(std::size_t key,std::size_t slot)
         {
             detail::thread_data_base* const current_thread_data(get_current_thread_data());
-            if(current_thread_data)
+            if(current_thread_data && (slot<current_thread_data->tss_data.size()))
             {
-                std::map<void const*,tss_data_node>::iterator current_node=
-                    current_thread_data->tss_data.find(key);
-                if(current_node!=current_thread_data->tss_data.end())
+                tss_data_node& current_node=current_thread_data->tss_data[slot];
+                if(current_node.key==key)
                 {
-                    return &current_node->second;
+                    return &current_node;
                 }
             }
             return NULL;
         }
 
-        void* get_tss_data(void const* key)
+        void* get_tss_data(std::size_t key,std::size_t slot)
         {
-            if(tss_data_node* const current_node=find_tss_data(key))
+            if(tss_data_node* const current_node=find_tss_data(key,slot))
             {
                 return current_node->value;
             }
             return NULL;
         }
 
-        void add_new_tss_node(void const* key,
+        void add_new_tss_node(std::size_t key,std::size_t slot,
                               detail::tss_data_node::cleanup_caller_t caller,
                               detail::tss_data_node::cleanup_func_t func,
                               void* tss_data)
         {
             detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
-            current_thread_data->tss_data.insert(std::make_pair(key,tss_data_node(caller,func,tss_data)));
-        }
-
-        void erase_tss_node(void const* key)
-        {
-            detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
-            current_thread_data->tss_data.erase(key);
+            if(slot>=current_thread_data->tss_data.size())
+            {
+                current_thread_data->tss_data.resize(slot+1);
+            }
+            tss_data_node& current_node=current_thread_data->tss_data[slot];
+            tss_data_node const previous=current_node;
+            current_node=tss_data_node(key,caller,func,tss_data);
+            // the value left by a destroyed thread_specific_ptr that had the same slot is cleaned
+            // up now rather than when the thread exits
+            if(previous.key && previous.func && (previous.value!=0))
+            {
+                (*previous.caller)(previous.func,previous.value);
+            }
         }
 
-        void set_tss_data(void const* key,
+        void set_tss_data(std::size_t key,std::size_t slot,
                           detail::tss_data_node::cleanup_caller_t caller,
                           detail::tss_data_node::cleanup_func_t func,
                           void* tss_data,bool cleanup_existing)
         {
-            if(tss_data_node* const current_node=find_tss_data(key))
+            if(tss_data_node* const current_node=find_tss_data(key,slot))
             {
-                if(cleanup_existing && current_node->func && (current_node->value!=0))
+                tss_data_node const current=*current_node;
+                if(cleanup_existing && current.func && (current.value!=0))
                 {
-                    (*current_node->caller)(current_node->func,current_node->value);
+                    (*current.caller)(current.func,current.value);
                 }
+                // the cleanup function can set values, invalidating current_node
                 if(func || (tss_data!=0))
                 {
-                    current_node->caller=caller;
-                    current_node->func=func;
-                    current_node->value=tss_data;
+                    if(tss_data_node* const node=find_tss_data(key,slot))
+                    {
+                        node->caller=caller;
+                        node->func=func;
+                        node->value=tss_data;
+                    }
+                    else
+                    {
+                        add_new_tss_node(key,slot,caller,func,tss_data);
+                    }
                 }
                 else
                 {
-                    erase_tss_node(key);
+                    erase_tss_node(*get_current_thread_data(),slot,key);
                 }
             }
             else if(func || (tss_data!=0))
             {
-                add_new_tss_node(key,caller,func,tss_data);
+                add_new_tss_node(key,slot,caller,func,tss_data);
             }
         }
     }
@@ -0,0 +1,118 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/condition_variable>
+
+// class condition_variable;
+
+// void wait(unique_lock<mutex>& lock);
+// cv_status wait_for(unique_lock<mutex>& lock, const chrono::duration<Rep, Period>& rel_time);
+
+// The waits are interruption points, also when the interruption races with notifications and with
+// the destruction of the condition variable.
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_USES_CHRONO && defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+
+boost::mutex mut;
+boost::condition_variable cv;
+boost::atomic<bool> waiting(false);
+boost::atomic<int> interrupted(0);
+
+void wait_forever()
+{
+  try
+  {
+    boost::unique_lock<boost::mutex> lk(mut);
+    waiting = true;
+    for (;;)
+    {
+      cv.wait(lk);
+    }
+  }
+  catch (boost::thread_interrupted&)
+  {
+    ++interrupted;
+  }
+}
+
+void wait_local_until_interrupted()
+{
+  // each wait uses a new condition variable, destroyed as soon as the wait is interrupted
+  for (;;)
+  {
+    try
+    {
+      boost::mutex m;
+      boost::unique_lock<boost::mutex> lk(m);
+      boost::condition_variable local;
+      local.wait_for(lk, boost::chrono::milliseconds(1));
+    }
+    catch (boost::thread_interrupted&)
+    {
+      if (++interrupted == 1000) return;
+    }
+  }
+}
+
+int main()
+{
+  {
+    // the interruption wakes the waiting thread, which is not notified otherwise
+    boost::thread t(wait_forever);
+    while (! waiting) boost::this_thread::yield();
+    {
+      // the thread is waiting once it has released the mutex
+      boost::unique_lock<boost::mutex> lk(mut);
+    }
+    t.interrupt();
+    t.join();
+    BOOST_TEST_EQ(interrupted, 1);
+  }
+  {
+    // an interruption requested before the wait is seen by the wait
+    interrupted = 0;
+    waiting = false;
+    boost::unique_lock<boost::mutex> lk(mut);
+    boost::thread t(wait_forever);
+    t.interrupt();
+    lk.unlock();
+    t.join();
+    BOOST_TEST_EQ(interrupted, 1);
+  }
+  {
+    // interruptions racing with the notifications
+    interrupted = 0;
+    waiting = false;
+    boost::thread t(wait_forever);
+    while (! waiting)
+    {
+      cv.notify_all();
+      boost::this_thread::yield();
+    }
+    for (int i = 0; i < 100; ++i) cv.notify_one();
+    t.interrupt();
+    for (int i = 0; i < 100; ++i) cv.notify_all();
+    t.join();
+    BOOST_TEST_EQ(interrupted, 1);
+  }
+  {
+    // interruptions racing with the destruction of the condition variables
+    interrupted = 0;
+    boost::thread t(wait_local_until_interrupted);
+    while (! t.try_join_for(boost::chrono::milliseconds(0)))
+    {
+      t.interrupt();
+    }
+    BOOST_TEST_EQ(interrupted, 1000);
+  }
+  return boost::report_errors();
+}
+#else
+#error "Test not applicable: BOOST_THREAD_USES_CHRONO or BOOST_THREAD_PROVIDES_INTERRUPTIONS not defined for this platform as not supported"
+#endif
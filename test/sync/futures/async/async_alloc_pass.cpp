@@ -0,0 +1,98 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template <class Allocator, class F, class... Args>
+//     future<typename result_of<F(Args...)>::type>
+//     async(allocator_arg_t, const Allocator& a, launch policy, F&& f, Args&&... args);
+
+// template <class Allocator, class T>
+//     future<V> make_ready_future(allocator_arg_t, const Allocator& a, T&& value);
+// template <class Allocator>
+//     future<void> make_ready_future(allocator_arg_t, const Allocator& a);
+
+// The shared states allocated without an allocator are recycled by the thread releasing them.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CTOR_ALLOCATORS
+#include "../test_allocator.hpp"
+
+int twice(int i)
+{
+  return 2 * i;
+}
+
+int main()
+{
+#if defined BOOST_THREAD_PROVIDES_VARIADIC_THREAD
+  {
+    boost::future<int> f = boost::async(boost::allocator_arg, test_allocator<int>(), boost::launch::async, &twice, 3);
+    BOOST_TEST(test_alloc_base::count == 1);
+    BOOST_TEST(f.get() == 6);
+  }
+  // the thread of the async launch releases the shared state once it returns
+  for (int i = 0; i < 1000 && test_alloc_base::count != 0; ++i)
+  {
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+  }
+  BOOST_TEST(test_alloc_base::count == 0);
+  {
+    boost::future<int> f = boost::async(boost::allocator_arg, test_allocator<int>(), boost::launch::deferred, &twice, 4);
+    BOOST_TEST(test_alloc_base::count == 1);
+    BOOST_TEST(f.get() == 8);
+  }
+  BOOST_TEST(test_alloc_base::count == 0);
+#ifdef BOOST_THREAD_PROVIDES_EXECUTORS
+  {
+    boost::future<int> f = boost::async(boost::allocator_arg, test_allocator<int>(), boost::launch::pool, &twice, 5);
+    BOOST_TEST(f.get() == 10);
+  }
+#endif
+#endif
+  {
+    boost::future<int> f = boost::make_ready_future(boost::allocator_arg, test_allocator<int>(), 3);
+    BOOST_TEST(test_alloc_base::count == 1);
+    BOOST_TEST(f.is_ready());
+    BOOST_TEST(f.get() == 3);
+  }
+  BOOST_TEST(test_alloc_base::count == 0);
+  {
+    boost::future<void> f = boost::make_ready_future(boost::allocator_arg, test_allocator<int>());
+    BOOST_TEST(test_alloc_base::count == 1);
+    BOOST_TEST(f.is_ready());
+    f.get();
+  }
+  BOOST_TEST(test_alloc_base::count == 0);
+#if ! defined BOOST_NO_CXX11_THREAD_LOCAL
+  {
+    // a released block is reused for the next allocation of its size class
+    void* p = boost::thread_detail::allocate_recycled(200);
+    boost::thread_detail::deallocate_recycled(p, 200);
+    void* q = boost::thread_detail::allocate_recycled(220);
+    BOOST_TEST(p == q);
+    boost::thread_detail::deallocate_recycled(q, 220);
+  }
+#endif
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      boost::promise<int> p;
+      boost::future<int> f = p.get_future();
+      p.set_value(i);
+      BOOST_TEST(f.get() == i);
+    }
+  }
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,107 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template <class F, class... Args>
+//     future<typename result_of<F(Args...)>::type>
+//     async(launch::pool, F&& f, Args&&... args);
+// future<R>::then(launch::pool, F&& func);
+
+#define BOOST_THREAD_VERSION 5
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+#include <boost/thread/future.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/executors/default_executor.hpp>
+#include <boost/thread/csbl/vector.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <set>
+#include <stdexcept>
+
+boost::thread::id get_id()
+{
+  boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+  return boost::this_thread::get_id();
+}
+
+int forty_two()
+{
+  return 42;
+}
+
+int thrower()
+{
+  throw std::logic_error("thrower");
+}
+
+int next(boost::future<int> f)
+{
+  return f.get() + 1;
+}
+
+int next_shared(boost::shared_future<int> f)
+{
+  return f.get() + 1;
+}
+
+boost::thread::id get_id_after(boost::future<boost::thread::id> f)
+{
+  f.get();
+  return boost::this_thread::get_id();
+}
+
+int main()
+{
+  BOOST_TEST(boost::set_default_executor_parameters(2, 256 * 1024));
+  {
+    // the functions run on the threads of the default executor
+    boost::csbl::vector<boost::future<boost::thread::id> > ids;
+    for (int i = 0; i < 50; ++i)
+    {
+      ids.push_back(boost::async(boost::launch::pool, &get_id));
+    }
+    std::set<boost::thread::id> threads;
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      threads.insert(ids[i].get());
+    }
+    BOOST_TEST(threads.size() <= 2u);
+    BOOST_TEST(threads.count(boost::this_thread::get_id()) == 0);
+  }
+  // the parameters can no longer be changed
+  BOOST_TEST(! boost::set_default_executor_parameters(4));
+  {
+    boost::future<int> f = boost::async(boost::launch::pool, &forty_two);
+    BOOST_TEST_EQ(f.get(), 42);
+  }
+  {
+    boost::future<int> f = boost::async(boost::launch::pool, &thrower);
+    try
+    {
+      f.get();
+      BOOST_TEST(false);
+    }
+    catch (std::logic_error&)
+    {
+    }
+  }
+  {
+    // the continuations run on the default executor
+    boost::future<int> f = boost::async(boost::launch::pool, &forty_two).then(boost::launch::pool, &next);
+    BOOST_TEST_EQ(f.get(), 43);
+    boost::future<int> f2 = boost::make_ready_future(1).then(boost::launch::pool, &next);
+    BOOST_TEST_EQ(f2.get(), 2);
+    boost::shared_future<int> sf = boost::async(boost::launch::pool, &forty_two).share();
+    BOOST_TEST_EQ(sf.then(boost::launch::pool, &next_shared).get(), 43);
+  }
+  {
+    // the continuations of a future launched on the pool inherit the pool
+    boost::future<boost::thread::id> f = boost::async(boost::launch::pool, &get_id).then(&get_id_after);
+    BOOST_TEST(f.get() != boost::this_thread::get_id());
+  }
+  return boost::report_errors();
+}
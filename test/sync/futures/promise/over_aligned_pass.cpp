@@ -0,0 +1,53 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// class promise<R>
+
+// The shared states of over-aligned values are suitably aligned, as the aligned operator new
+// guarantees since C++17.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined __cpp_aligned_new
+
+struct alignas(128) over_aligned
+{
+  int value;
+};
+
+bool aligned(const void* p)
+{
+  return reinterpret_cast<std::size_t>(p) % 128 == 0;
+}
+
+int main()
+{
+  // enough states for the recycled blocks of the same size to be reused
+  for (int i = 0; i < 64; ++i)
+  {
+    boost::promise<over_aligned> p;
+    boost::shared_future<over_aligned> f = p.get_future().share();
+    over_aligned v;
+    v.value = i;
+    p.set_value(v);
+    BOOST_TEST(aligned(&f.get()));
+    BOOST_TEST_EQ(f.get().value, i);
+  }
+  {
+    boost::future<over_aligned> f = boost::make_ready_future(over_aligned());
+    BOOST_TEST(f.is_ready());
+  }
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return boost::report_errors();
+}
+#endif
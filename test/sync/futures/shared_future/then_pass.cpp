@@ -17,6 +17,7 @@
 
 #include <boost/thread/future.hpp>
 #include <boost/detail/lightweight_test.hpp>
+#include <vector>
 
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
 
@@ -52,6 +53,20 @@ void p3(boost::shared_future<int> f)
   return ;
 }
 
+std::vector<int> order;
+
+struct record
+{
+  int i;
+  typedef int result_type;
+  explicit record(int i) : i(i) {}
+  int operator()(boost::shared_future<int> f) const
+  {
+    order.push_back(i);
+    return f.get() + i;
+  }
+};
+
 int main()
 {
   BOOST_THREAD_LOG << BOOST_THREAD_END_LOG;
@@ -143,6 +158,27 @@ int main()
     boost::future<int> f2 = boost::async(p1).share().then(&p2).share().then(&p2);
     BOOST_TEST(f2.get()==4);
   }
+  BOOST_THREAD_LOG << BOOST_THREAD_END_LOG;
+  {
+    // all the continuations run, in the order they were attached, also when attached after the value
+    order.clear();
+    boost::promise<int> p;
+    boost::shared_future<int> f1 = p.get_future().share();
+    std::vector<boost::shared_future<int> > fs;
+    for (int i = 0; i < 5; ++i)
+    {
+      fs.push_back(f1.then(boost::launch::sync, record(i)).share());
+    }
+    BOOST_TEST(order.empty());
+    p.set_value(10);
+    fs.push_back(f1.then(boost::launch::sync, record(5)).share());
+    BOOST_TEST_EQ(order.size(), 6u);
+    for (int i = 0; i < 6; ++i)
+    {
+      BOOST_TEST_EQ(order[i], i);
+      BOOST_TEST_EQ(fs[i].get(), 10 + i);
+    }
+  }
 
   return boost::report_errors();
 }
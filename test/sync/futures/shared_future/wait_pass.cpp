@@ -29,6 +29,8 @@
 #include <boost/thread/thread.hpp>
 #include <boost/chrono/chrono_io.hpp>
 #include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+#include <string>
 
 #if defined BOOST_THREAD_USES_CHRONO
 
@@ -69,6 +71,13 @@ void func5(boost::promise<void> p)
   p.set_value();
 }
 
+void wait_and_get(boost::shared_future<int> f, int* r)
+{
+  f.wait();
+  BOOST_TEST(f.wait_for(ms(0)) == boost::future_status::ready);
+  *r = f.get();
+}
+
 int main()
 {
   BOOST_THREAD_LOG << BOOST_THREAD_END_LOG;
@@ -130,6 +139,46 @@ int main()
     }
   }
   BOOST_THREAD_LOG << BOOST_THREAD_END_LOG;
+  {
+    // the waiters racing with set_value are all woken, the ones arriving late see the ready state
+    for (int i = 0; i < 200; ++i)
+    {
+      boost::promise<int> p;
+      boost::shared_future<int> f = p.get_future().share();
+      int r[4] = { 0, 0, 0, 0 };
+      boost::thread_group g;
+      for (int t = 0; t < 4; ++t)
+      {
+        g.create_thread(boost::bind(&wait_and_get, f, &r[t]));
+      }
+      if (i % 2) boost::this_thread::yield();
+      p.set_value(i);
+      g.join_all();
+      for (int t = 0; t < 4; ++t)
+      {
+        BOOST_TEST_EQ(r[t], i);
+      }
+    }
+  }
+  {
+    // a ready exception is rethrown without waiting
+    boost::promise<int> p;
+    boost::shared_future<int> f = p.get_future().share();
+    p.set_exception(boost::copy_exception(std::logic_error("ready")));
+    BOOST_TEST(f.is_ready());
+    BOOST_TEST(f.has_exception());
+    BOOST_TEST(! f.has_value());
+    try
+    {
+      f.wait();
+      f.get();
+      BOOST_TEST(false);
+    }
+    catch (std::logic_error& e)
+    {
+      BOOST_TEST_EQ(std::string(e.what()), "ready");
+    }
+  }
 
   return boost::report_errors();
 }
@@ -0,0 +1,83 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+//  template< typename InputIterator>
+//  future<vector<typename InputIterator::value_type>  >
+//    when_all(InputIterator first, InputIterator last)
+
+// The future returned by when_all is made ready by the thread making the last future ready.
+
+#include <boost/config.hpp>
+
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+int main()
+{
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+  { // many promises
+    const std::size_t n = 1000;
+    boost::csbl::vector<boost::promise<int> > p(n);
+    boost::csbl::vector<boost::future<int> > v;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      v.push_back(p[i].get_future());
+    }
+    boost::future<boost::csbl::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      BOOST_TEST(! all.is_ready());
+      p[i].set_value(int(i));
+    }
+    // no other thread is involved
+    BOOST_TEST(all.is_ready());
+    boost::csbl::vector<boost::future<int> > res = all.get();
+    BOOST_TEST(res.size() == n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      BOOST_TEST(res[i].is_ready());
+      BOOST_TEST(res[i].get() == int(i));
+    }
+  }
+  { // promises made ready in reverse order, one with an exception
+    boost::promise<int> p1;
+    boost::promise<int> p2;
+    boost::future<boost::csbl::tuple<boost::future<int>, boost::future<int> > > all =
+        boost::when_all(p1.get_future(), p2.get_future());
+    p2.set_exception(boost::copy_exception(std::logic_error("123")));
+    BOOST_TEST(! all.is_ready());
+    p1.set_value(321);
+    BOOST_TEST(all.is_ready());
+    boost::csbl::tuple<boost::future<int>, boost::future<int> > res = all.get();
+    BOOST_TEST(boost::csbl::get<0>(res).get() == 321);
+    BOOST_TEST(boost::csbl::get<1>(res).has_exception());
+  }
+  { // broken promise
+    boost::future<boost::csbl::vector<boost::future<int> > > all;
+    {
+      boost::promise<int> p1;
+      boost::csbl::vector<boost::future<int> > v;
+      v.push_back(p1.get_future());
+      v.push_back(boost::make_ready_future(321));
+      all = boost::when_all(v.begin(), v.end());
+      BOOST_TEST(! all.is_ready());
+    }
+    BOOST_TEST(all.is_ready());
+    boost::csbl::vector<boost::future<int> > res = all.get();
+    BOOST_TEST(res[0].has_exception());
+    BOOST_TEST(res[1].get() == 321);
+  }
+#endif
+  return boost::report_errors();
+}
+
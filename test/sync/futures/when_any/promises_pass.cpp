@@ -0,0 +1,82 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+//  template< typename InputIterator>
+//  future<vector<typename InputIterator::value_type>  >
+//    when_any(InputIterator first, InputIterator last)
+
+// The future returned by when_any is made ready by the thread making the first future ready.
+
+#include <boost/config.hpp>
+
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+int main()
+{
+#if defined BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+  { // many promises
+    const std::size_t n = 1000;
+    boost::csbl::vector<boost::promise<int> > p(n);
+    boost::csbl::vector<boost::future<int> > v;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      v.push_back(p[i].get_future());
+    }
+    boost::future<boost::csbl::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    BOOST_TEST(! any.is_ready());
+    p[n / 2].set_value(123);
+    // no other thread is involved
+    BOOST_TEST(any.is_ready());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      // the other futures do not make it ready again
+      if (i != n / 2) p[i].set_value(int(i));
+    }
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res.size() == n);
+    BOOST_TEST(res[n / 2].get() == 123);
+  }
+  { // the first future ready has an exception
+    boost::promise<int> p1;
+    boost::promise<int> p2;
+    boost::future<boost::csbl::tuple<boost::future<int>, boost::future<int> > > any =
+        boost::when_any(p1.get_future(), p2.get_future());
+    BOOST_TEST(! any.is_ready());
+    p2.set_exception(boost::copy_exception(std::logic_error("123")));
+    BOOST_TEST(any.is_ready());
+    boost::csbl::tuple<boost::future<int>, boost::future<int> > res = any.get();
+    BOOST_TEST(boost::csbl::get<1>(res).has_exception());
+    BOOST_TEST(! boost::csbl::get<0>(res).is_ready());
+    p1.set_value(321);
+    BOOST_TEST(boost::csbl::get<0>(res).get() == 321);
+  }
+  { // broken promise
+    boost::future<boost::csbl::vector<boost::future<int> > > any;
+    {
+      boost::promise<int> p1;
+      boost::promise<int> p2;
+      boost::csbl::vector<boost::future<int> > v;
+      v.push_back(p1.get_future());
+      v.push_back(p2.get_future());
+      any = boost::when_any(v.begin(), v.end());
+      BOOST_TEST(! any.is_ready());
+    }
+    BOOST_TEST(any.is_ready());
+    boost::csbl::vector<boost::future<int> > res = any.get();
+    BOOST_TEST(res[0].has_exception() || res[1].has_exception());
+  }
+#endif
+  return boost::report_errors();
+}
+
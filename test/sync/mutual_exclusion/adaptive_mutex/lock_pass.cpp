@@ -0,0 +1,106 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/adaptive_mutex.hpp>
+
+// class adaptive_mutex;
+// class timed_adaptive_mutex;
+
+// With unique_lock, condition_variable_any and synchronized_value.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/adaptive_mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/synchronized_value.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+typedef boost::chrono::milliseconds ms;
+
+boost::adaptive_mutex m;
+boost::timed_adaptive_mutex tm;
+int value = 0;
+
+void increment()
+{
+  for (int i = 0; i < 10000; ++i)
+  {
+    boost::unique_lock<boost::adaptive_mutex> lk(m);
+    ++value;
+  }
+}
+
+void lock_for(int milliseconds)
+{
+  boost::unique_lock<boost::timed_adaptive_mutex> lk(tm);
+  boost::this_thread::sleep_for(ms(milliseconds));
+}
+
+boost::condition_variable_any cond;
+bool ready = false;
+
+void notify()
+{
+  boost::this_thread::sleep_for(ms(50));
+  boost::unique_lock<boost::adaptive_mutex> lk(m);
+  ready = true;
+  cond.notify_one();
+}
+
+void increment_synchronized(boost::synchronized_value<int, boost::timed_adaptive_mutex>* v)
+{
+  for (int i = 0; i < 1000; ++i)
+  {
+    ++*v->synchronize();
+  }
+}
+
+int main()
+{
+  {
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+    {
+      threads.create_thread(increment);
+    }
+    threads.join_all();
+    BOOST_TEST_EQ(value, 40000);
+  }
+  {
+    BOOST_TEST(m.try_lock());
+    BOOST_TEST(! m.try_lock());
+    m.unlock();
+  }
+  {
+    boost::thread t(lock_for, 200);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(! tm.try_lock());
+    BOOST_TEST(! tm.try_lock_for(ms(20)));
+    BOOST_TEST(tm.try_lock_for(ms(1000)));
+    tm.unlock();
+    t.join();
+  }
+  {
+    boost::unique_lock<boost::adaptive_mutex> lk(m);
+    boost::thread t(notify);
+    while (! ready)
+    {
+      cond.wait(lk);
+    }
+    BOOST_TEST(ready);
+    BOOST_TEST(cond.wait_for(lk, ms(10)) == boost::cv_status::timeout);
+    lk.unlock();
+    t.join();
+  }
+  {
+    boost::synchronized_value<int, boost::timed_adaptive_mutex> v(0);
+    boost::thread t1(increment_synchronized, &v);
+    boost::thread t2(increment_synchronized, &v);
+    t1.join();
+    t2.join();
+    BOOST_TEST_EQ(v.get(), 2000);
+  }
+  return boost::report_errors();
+}
@@ -0,0 +1,134 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// With shared_lock, unique_lock, upgrade_lock, upgrade_to_unique_lock, shared_lock_guard and
+// synchronized_value.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
+#include <boost/thread/synchronized_value.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+typedef boost::chrono::milliseconds ms;
+
+boost::distributed_shared_mutex m(4);
+int value = 0;
+bool reader_saw_change = false;
+
+// Readers see the value only even, the writers and the upgraders make it odd while they own the mutex
+// exclusively.
+void reader()
+{
+  for (int i = 0; i < 2000; ++i)
+  {
+    boost::shared_lock<boost::distributed_shared_mutex> lk(m);
+    if (value % 2 != 0) reader_saw_change = true;
+  }
+}
+
+void guarded_reader()
+{
+  for (int i = 0; i < 2000; ++i)
+  {
+    boost::shared_lock_guard<boost::distributed_shared_mutex> lk(m);
+    if (value % 2 != 0) reader_saw_change = true;
+  }
+}
+
+void writer()
+{
+  for (int i = 0; i < 200; ++i)
+  {
+    boost::unique_lock<boost::distributed_shared_mutex> lk(m);
+    ++value;
+    boost::this_thread::yield();
+    ++value;
+  }
+}
+
+void upgrader()
+{
+  for (int i = 0; i < 200; ++i)
+  {
+    boost::upgrade_lock<boost::distributed_shared_mutex> lk(m);
+    int const seen = value;
+    boost::upgrade_to_unique_lock<boost::distributed_shared_mutex> ulk(lk);
+    BOOST_TEST(value == seen);
+    ++value;
+    boost::this_thread::yield();
+    ++value;
+  }
+}
+
+void shared_for(int milliseconds)
+{
+  m.lock_shared();
+  boost::this_thread::sleep_for(ms(milliseconds));
+  m.unlock_shared();
+}
+
+void increment(boost::synchronized_value<int, boost::distributed_shared_mutex>* v)
+{
+  for (int i = 0; i < 1000; ++i)
+  {
+    ++*v->synchronize();
+  }
+}
+
+int main()
+{
+  {
+    boost::thread_group threads;
+    // more threads than slots
+    for (int i = 0; i < 4; ++i)
+    {
+      threads.create_thread(reader);
+      threads.create_thread(guarded_reader);
+    }
+    threads.create_thread(writer);
+    threads.create_thread(writer);
+    threads.create_thread(upgrader);
+    threads.join_all();
+    BOOST_TEST(! reader_saw_change);
+    BOOST_TEST_EQ(value, 1200);
+  }
+  {
+    // the shared owners exclude the exclusive owner, not the upgrade owner
+    boost::thread t(shared_for, 200);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(! m.try_lock());
+    BOOST_TEST(! m.try_lock_for(ms(10)));
+    BOOST_TEST(m.try_lock_shared());
+    m.unlock_shared();
+    BOOST_TEST(m.try_lock_upgrade());
+    BOOST_TEST(! m.try_lock_upgrade());
+    BOOST_TEST(! m.try_unlock_upgrade_and_lock());
+    m.unlock_upgrade_and_lock();
+    t.join();
+    BOOST_TEST(! m.try_lock_shared());
+    BOOST_TEST(! m.try_lock_shared_for(ms(10)));
+    m.unlock_and_lock_shared();
+    BOOST_TEST(m.try_lock_shared());
+    m.unlock_shared();
+    m.unlock_shared();
+    BOOST_TEST(m.try_lock());
+    m.unlock();
+  }
+  {
+    boost::synchronized_value<int, boost::distributed_shared_mutex> v(0);
+    boost::thread t1(increment, &v);
+    boost::thread t2(increment, &v);
+    t1.join();
+    t2.join();
+    BOOST_TEST_EQ(v.get(), 2000);
+  }
+  return boost::report_errors();
+}
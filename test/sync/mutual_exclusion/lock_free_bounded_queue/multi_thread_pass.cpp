@@ -0,0 +1,122 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/concurrent_queues/lock_free_bounded_queue.hpp>
+
+// class lock_free_bounded_queue<T>
+
+//    push || pull;
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/concurrent_queues/lock_free_bounded_queue.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+typedef boost::lock_free_bounded_queue<int> queue_t;
+
+struct call_push_range
+{
+  queue_t *q_;
+  boost::barrier *go_;
+  int first_;
+  int n_;
+
+  call_push_range(queue_t *q, boost::barrier *go, int first, int n) :
+    q_(q), go_(go), first_(first), n_(n)
+  {
+  }
+  void operator()()
+  {
+    go_->count_down_and_wait();
+    for (int i = first_; i < first_ + n_; ++i)
+      q_->push(i);
+  }
+};
+
+struct call_wait_pull_all
+{
+  queue_t *q_;
+  boost::barrier *go_;
+  long *sum_;
+  int *count_;
+
+  call_wait_pull_all(queue_t *q, boost::barrier *go, long *sum, int *count) :
+    q_(q), go_(go), sum_(sum), count_(count)
+  {
+  }
+  void operator()()
+  {
+    go_->count_down_and_wait();
+    int v = 0;
+    while (q_->wait_pull(v) == boost::queue_op_status::success)
+    {
+      *sum_ += v;
+      ++*count_;
+    }
+  }
+};
+
+void test_concurrent_push_and_pull_on_small_queue()
+{
+  queue_t q(4);
+  const int producers = 3;
+  const int consumers = 3;
+  const int n = 20000;
+  boost::barrier go(producers + consumers);
+  long sums[consumers] = {0};
+  int counts[consumers] = {0};
+
+  boost::thread_group pushers;
+  boost::thread_group pullers;
+  for (int i = 0; i < consumers; ++i)
+    pullers.create_thread(call_wait_pull_all(&q, &go, &sums[i], &counts[i]));
+  for (int i = 0; i < producers; ++i)
+    pushers.create_thread(call_push_range(&q, &go, i * n, n));
+
+  pushers.join_all();
+  q.close();
+  pullers.join_all();
+
+  long sum = 0;
+  int count = 0;
+  for (int i = 0; i < consumers; ++i)
+  {
+    sum += sums[i];
+    count += counts[i];
+  }
+  const long total = long(producers) * n;
+  BOOST_TEST_EQ(count, producers * n);
+  BOOST_TEST_EQ(sum, total * (total - 1) / 2);
+  BOOST_TEST(q.empty());
+}
+
+void test_close_wakes_up_waiting_pullers()
+{
+  queue_t q(2);
+  boost::barrier go(3);
+  long sums[2] = {0};
+  int counts[2] = {0};
+  boost::thread_group pullers;
+  for (int i = 0; i < 2; ++i)
+    pullers.create_thread(call_wait_pull_all(&q, &go, &sums[i], &counts[i]));
+  go.count_down_and_wait();
+  q.close();
+  pullers.join_all();
+  BOOST_TEST_EQ(counts[0] + counts[1], 0);
+}
+
+int main()
+{
+  test_concurrent_push_and_pull_on_small_queue();
+  test_close_wakes_up_waiting_pullers();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,183 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/concurrent_queues/lock_free_bounded_queue.hpp>
+
+// class lock_free_bounded_queue<T>
+
+//    lock_free_bounded_queue(size_type);
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/concurrent_queues/lock_free_bounded_queue.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+class non_copyable
+{
+  BOOST_THREAD_MOVABLE_ONLY(non_copyable)
+  int val;
+public:
+  non_copyable() {}
+  non_copyable(int v) : val(v){}
+  non_copyable(BOOST_RV_REF(non_copyable) x): val(x.val) {}
+  non_copyable& operator=(BOOST_RV_REF(non_copyable) x) { val=x.val; return *this; }
+  bool operator==(non_copyable const& x) const {return val==x.val;}
+  template <typename OSTREAM>
+  friend OSTREAM& operator <<(OSTREAM& os, non_copyable const&x )
+  {
+    os << x.val;
+    return os;
+  }
+
+};
+
+// Its copy constructor throws when asked to.
+struct throwing_copy
+{
+  static bool throw_on_copy;
+  int val;
+  throwing_copy() : val(0) {}
+  throwing_copy(int v) : val(v) {}
+  throwing_copy(throwing_copy const& x) : val(x.val)
+  {
+    if (throw_on_copy) throw 1;
+  }
+  throwing_copy& operator=(throwing_copy const& x) { val=x.val; return *this; }
+};
+bool throwing_copy::throw_on_copy = false;
+
+int main()
+{
+
+  {
+    // default queue invariants
+      boost::lock_free_bounded_queue<int> q(2);
+      BOOST_TEST(q.empty());
+      BOOST_TEST(! q.full());
+      BOOST_TEST_EQ(q.size(), 0u);
+      BOOST_TEST_EQ(q.capacity(), 2u);
+      BOOST_TEST(! q.closed());
+  }
+  {
+    // empty queue try_pull fails
+      boost::lock_free_bounded_queue<int> q(2);
+      int i;
+      BOOST_TEST(boost::queue_op_status::empty == q.try_pull(i));
+      BOOST_TEST(boost::queue_op_status::empty == q.nonblocking_pull(i));
+      BOOST_TEST(q.empty());
+      BOOST_TEST_EQ(q.size(), 0u);
+  }
+  {
+    // empty queue push rvalue/value succeeds
+      boost::lock_free_bounded_queue<int> q(2);
+      q.push(1);
+      int j = 2;
+      q.push(j);
+      BOOST_TEST(! q.empty());
+      BOOST_TEST(q.full());
+      BOOST_TEST_EQ(q.size(), 2u);
+      BOOST_TEST(! q.closed());
+  }
+  {
+    // full queue try_push/nonblocking_push fail
+      boost::lock_free_bounded_queue<int> q(2);
+      q.push(1);
+      q.push(2);
+      BOOST_TEST(boost::queue_op_status::full == q.try_push(3));
+      BOOST_TEST(boost::queue_op_status::full == q.nonblocking_push(3));
+      BOOST_TEST_EQ(q.size(), 2u);
+  }
+  {
+    // elements are pulled in FIFO order across the wrap around
+      boost::lock_free_bounded_queue<int> q(3);
+      for (int i = 0; i < 10; ++i)
+      {
+        BOOST_TEST(boost::queue_op_status::success == q.try_push(i));
+        BOOST_TEST(boost::queue_op_status::success == q.wait_push(i + 100));
+        int e;
+        BOOST_TEST(boost::queue_op_status::success == q.try_pull(e));
+        BOOST_TEST_EQ(e, i);
+        BOOST_TEST(boost::queue_op_status::success == q.wait_pull(e));
+        BOOST_TEST_EQ(e, i + 100);
+      }
+      BOOST_TEST(q.empty());
+  }
+  {
+    // empty queue push movable only succeeds
+      boost::lock_free_bounded_queue<non_copyable> q(2);
+      non_copyable nc(1);
+      q.push(boost::move(nc));
+      non_copyable nc2(2);
+      BOOST_TEST(boost::queue_op_status::success == q.nonblocking_push(boost::move(nc2)));
+      non_copyable e;
+      q.pull(e);
+      BOOST_TEST_EQ(e, non_copyable(1));
+      BOOST_TEST_EQ(q.pull(), non_copyable(2));
+      BOOST_TEST(q.empty());
+  }
+  {
+    // closed queue push fails
+      boost::lock_free_bounded_queue<int> q(2);
+      q.close();
+      try {
+        q.push(1);
+        BOOST_TEST(false);
+      } catch (...) {
+        BOOST_TEST(q.empty());
+        BOOST_TEST(q.closed());
+      }
+      BOOST_TEST(boost::queue_op_status::closed == q.try_push(1));
+      BOOST_TEST(boost::queue_op_status::closed == q.wait_push(1));
+  }
+  {
+    // closed non empty queue pull succeeds until empty
+      boost::lock_free_bounded_queue<int> q(2);
+      q.push(1);
+      q.close();
+      int i;
+      BOOST_TEST(boost::queue_op_status::success == q.wait_pull(i));
+      BOOST_TEST_EQ(i, 1);
+      BOOST_TEST(boost::queue_op_status::closed == q.wait_pull(i));
+      BOOST_TEST(boost::queue_op_status::closed == q.try_pull(i));
+  }
+
+  {
+    // a queue of capacity 1 is full after a push and free after a pull
+      boost::lock_free_bounded_queue<int> q(1);
+      BOOST_TEST(boost::queue_op_status::success == q.try_push(1));
+      BOOST_TEST(q.full());
+      BOOST_TEST(boost::queue_op_status::full == q.try_push(2));
+      BOOST_TEST(boost::queue_op_status::full == q.nonblocking_push(2));
+      int i;
+      BOOST_TEST(boost::queue_op_status::success == q.try_pull(i));
+      BOOST_TEST_EQ(i, 1);
+      BOOST_TEST(boost::queue_op_status::empty == q.try_pull(i));
+      for (int k = 0; k < 5; ++k)
+      {
+        BOOST_TEST(boost::queue_op_status::success == q.wait_push(k));
+        BOOST_TEST(boost::queue_op_status::full == q.try_push(k));
+        BOOST_TEST(boost::queue_op_status::success == q.wait_pull(i));
+        BOOST_TEST_EQ(i, k);
+      }
+      BOOST_TEST(q.empty());
+  }
+  {
+    // a copy throwing while pushing leaves the queue unchanged
+      boost::lock_free_bounded_queue<throwing_copy> q(2);
+      throwing_copy e(1);
+      throwing_copy::throw_on_copy = true;
+      try { q.try_push(e); BOOST_TEST(false); } catch (int) {}
+      try { q.nonblocking_push(e); BOOST_TEST(false); } catch (int) {}
+      try { q.wait_push(e); BOOST_TEST(false); } catch (int) {}
+      throwing_copy::throw_on_copy = false;
+      BOOST_TEST(q.empty());
+      BOOST_TEST(boost::queue_op_status::success == q.try_push(throwing_copy(2)));
+      throwing_copy r;
+      BOOST_TEST(boost::queue_op_status::success == q.try_pull(r));
+      BOOST_TEST_EQ(r.val, 2);
+      BOOST_TEST(boost::queue_op_status::empty == q.try_pull(r));
+  }
+  return boost::report_errors();
+}
+
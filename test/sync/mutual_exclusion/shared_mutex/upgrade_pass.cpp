@@ -0,0 +1,131 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/shared_mutex.hpp>
+
+// class shared_mutex;
+
+// void lock_upgrade();
+// void unlock_upgrade_and_lock();
+// void unlock_and_lock_upgrade();
+// void unlock_upgrade_and_lock_shared();
+// bool try_unlock_upgrade_and_lock_for(const chrono::duration<Rep, Period>& rel_time);
+
+#define BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::shared_mutex m;
+int value = 0;
+bool reader_saw_change = false;
+
+typedef boost::chrono::milliseconds ms;
+
+// Readers see the value only even, the writers and the upgraders make it odd while they own the mutex
+// exclusively.
+void reader()
+{
+  for (int i = 0; i < 2000; ++i)
+  {
+    m.lock_shared();
+    if (value % 2 != 0) reader_saw_change = true;
+    m.unlock_shared();
+  }
+}
+
+void writer()
+{
+  for (int i = 0; i < 500; ++i)
+  {
+    m.lock();
+    ++value;
+    boost::this_thread::yield();
+    ++value;
+    m.unlock();
+  }
+}
+
+void upgrader()
+{
+  for (int i = 0; i < 500; ++i)
+  {
+    m.lock_upgrade();
+    int const seen = value;
+    m.unlock_upgrade_and_lock();
+    BOOST_TEST(value == seen);
+    ++value;
+    boost::this_thread::yield();
+    ++value;
+    m.unlock_and_lock_upgrade();
+    m.unlock_upgrade_and_lock();
+    m.unlock_and_lock_shared();
+    m.unlock_shared();
+  }
+}
+
+void shared_for(int milliseconds)
+{
+  m.lock_shared();
+  boost::this_thread::sleep_for(ms(milliseconds));
+  m.unlock_shared();
+}
+
+int main()
+{
+  {
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+    {
+      threads.create_thread(reader);
+    }
+    threads.create_thread(writer);
+    threads.create_thread(writer);
+    threads.create_thread(upgrader);
+    threads.join_all();
+    BOOST_TEST(! reader_saw_change);
+    BOOST_TEST_EQ(value, 3000);
+  }
+  {
+    // the upgrade owner waits for the other shared owner to leave
+    m.lock_upgrade();
+    boost::thread t(shared_for, 100);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(m.try_unlock_upgrade_and_lock_for(ms(1000)));
+    m.unlock();
+    t.join();
+  }
+  {
+    // the upgrade owner can't take the mutex exclusively while a reader owns it, and after the timeout
+    // the new readers are let in
+    m.lock_upgrade();
+    boost::thread t(shared_for, 500);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(! m.try_unlock_upgrade_and_lock_for(ms(50)));
+    BOOST_TEST(m.try_lock_shared());
+    m.unlock_shared();
+    m.unlock_upgrade_and_lock_shared();
+    BOOST_TEST(! m.try_lock());
+    BOOST_TEST(m.try_lock_upgrade());
+    m.unlock_upgrade();
+    m.unlock_shared();
+    t.join();
+  }
+  {
+    // a thread waiting for the exclusive ownership blocks the new shared owners
+    m.lock_shared();
+    boost::thread t(&boost::shared_mutex::lock, &m);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(! m.try_lock_shared());
+    BOOST_TEST(! m.try_lock_shared_for(ms(10)));
+    m.unlock_shared();
+    t.join();
+    BOOST_TEST(! m.try_lock_shared());
+    m.unlock();
+    BOOST_TEST(m.try_lock_shared());
+    BOOST_TEST(m.try_unlock_shared_and_lock());
+    m.unlock();
+  }
+  return boost::report_errors();
+}
@@ -22,6 +22,9 @@
 
 #include <boost/detail/lightweight_test.hpp>
 
+#include <iterator>
+#include <vector>
+
 struct call_push
 {
   boost::sync_bounded_queue<int> &q_;
@@ -77,6 +80,28 @@ struct call_pull
   }
 };
 
+struct call_wait_pull_front_some
+{
+  boost::sync_bounded_queue<int> &q_;
+
+  call_wait_pull_front_some(boost::sync_bounded_queue<int> &q) :
+    q_(q)
+  {
+  }
+  typedef long result_type;
+  long operator()()
+  {
+    long sum = 0;
+    std::vector<int> v;
+    while (q_.wait_pull_front_some(4, std::back_inserter(v)) != 0)
+    {
+      for (std::size_t i = 0; i < v.size(); ++i) sum += v[i];
+      v.clear();
+    }
+    return sum;
+  }
+};
+
 void test_concurrent_push_and_pull_on_empty_queue()
 {
   boost::sync_bounded_queue<int> q(4);
@@ -240,12 +265,43 @@ void test_concurrent_pull_on_queue()
   }
 }
 
+void test_concurrent_push_back_range_on_full_queue()
+{
+  // the range is larger than the queue, so it is pushed in several chunks
+  boost::sync_bounded_queue<int> q(10);
+  const unsigned int n = 2;
+  boost::future<long> pull_done[n];
+
+  try
+  {
+    for (unsigned int i =0; i< n; ++i)
+      pull_done[i]=boost::async(boost::launch::async,
+                                call_wait_pull_front_some(q));
+
+    std::vector<int> batch(1000, 1);
+    q.push_back_range(batch.begin(), batch.end());
+    q.push_back_n(batch.begin(), 500);
+    q.close();
+
+    long sum = 0;
+    for (unsigned int i = 0; i < n; ++i)
+      sum += pull_done[i].get();
+    BOOST_TEST_EQ(sum, 1500);
+    BOOST_TEST(q.empty());
+  }
+  catch (...)
+  {
+    BOOST_TEST(false);
+  }
+}
+
 int main()
 {
   test_concurrent_push_and_pull_on_empty_queue();
   test_concurrent_push_on_empty_queue();
   test_concurrent_push_on_full_queue();
   test_concurrent_pull_on_queue();
+  test_concurrent_push_back_range_on_full_queue();
 
   return boost::report_errors();
 }
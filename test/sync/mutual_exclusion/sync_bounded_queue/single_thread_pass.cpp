@@ -16,6 +16,9 @@
 
 #include <boost/detail/lightweight_test.hpp>
 
+#include <iterator>
+#include <vector>
+
 class non_copyable
 {
   BOOST_THREAD_MOVABLE_ONLY(non_copyable)
@@ -103,7 +106,7 @@ int main()
   {
     // empty queue push value succeeds
       boost::sync_bounded_queue<int> q(2);
-      int i;
+      int i = 1;
       q.push(i);
       BOOST_TEST(! q.empty());
       BOOST_TEST(! q.full());
@@ -334,7 +337,7 @@ int main()
   {
     // empty queue push value succeeds
       boost::sync_bounded_queue<int> q(2);
-      int i;
+      int i = 1;
       q.push_back(i);
       BOOST_TEST(! q.empty());
       BOOST_TEST(! q.full());
@@ -411,7 +414,7 @@ int main()
   {
     // empty queue wait_push value succeeds
       boost::sync_bounded_queue<int> q(2);
-      int i;
+      int i = 1;
       BOOST_TEST(boost::queue_op_status::success == q.wait_push_back(i));
       BOOST_TEST(! q.empty());
       BOOST_TEST(! q.full());
@@ -590,11 +593,71 @@ int main()
       q.close();
       BOOST_TEST(q.empty());
       BOOST_TEST(q.closed());
-      int i;
+      int i = 1;
       BOOST_TEST(boost::queue_op_status::closed == q.wait_push_back(i));
       BOOST_TEST(q.empty());
       BOOST_TEST(q.closed());
   }
+  {
+    // push_back_range pushes all the elements in order
+      boost::sync_bounded_queue<int> q(3);
+      int a[] = {1, 2, 3};
+      q.push_back_range(a, a + 3);
+      BOOST_TEST_EQ(q.size(), 3u);
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_front_up_to(10, std::back_inserter(v)), 3u);
+      BOOST_TEST_EQ(v.size(), 3u);
+      BOOST_TEST_EQ(v[0], 1);
+      BOOST_TEST_EQ(v[1], 2);
+      BOOST_TEST_EQ(v[2], 3);
+      BOOST_TEST(q.empty());
+  }
+  {
+    // push_back_n pushes n elements and pull_front_up_to pulls no more than n
+      boost::sync_bounded_queue<int> q(3);
+      int a[] = {1, 2, 3, 4};
+      q.push_back_n(a, 3);
+      BOOST_TEST_EQ(q.size(), 3u);
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_front_up_to(2, std::back_inserter(v)), 2u);
+      BOOST_TEST_EQ(v.size(), 2u);
+      BOOST_TEST_EQ(v[0], 1);
+      BOOST_TEST_EQ(v[1], 2);
+      BOOST_TEST_EQ(q.size(), 1u);
+  }
+  {
+    // empty queue pull_front_up_to pulls nothing
+      boost::sync_bounded_queue<int> q(3);
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_front_up_to(2, std::back_inserter(v)), 0u);
+      BOOST_TEST(v.empty());
+  }
+  {
+    // closed queue push_back_range throws
+      boost::sync_bounded_queue<int> q(3);
+      q.close();
+      int a[] = {1, 2, 3};
+      try {
+        q.push_back_range(a, a + 3);
+        BOOST_TEST(false);
+      } catch (boost::sync_queue_is_closed&) {
+        BOOST_TEST(q.empty());
+      }
+  }
+  {
+    // closed non-empty queue wait_pull_front_some drains the queue
+      boost::sync_bounded_queue<int> q(3);
+      int a[] = {1, 2, 3};
+      q.push_back_range(a, a + 3);
+      q.close();
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.wait_pull_front_some(2, std::back_inserter(v)), 2u);
+      BOOST_TEST_EQ(q.wait_pull_front_some(2, std::back_inserter(v)), 1u);
+      BOOST_TEST_EQ(q.wait_pull_front_some(2, std::back_inserter(v)), 0u);
+      BOOST_TEST_EQ(v.size(), 3u);
+      BOOST_TEST(q.empty());
+  }
+
   return boost::report_errors();
 }
 
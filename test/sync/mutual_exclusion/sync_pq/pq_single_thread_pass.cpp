@@ -22,6 +22,9 @@
 #include <boost/detail/lightweight_test.hpp>
 #include "../../../timming.hpp"
 
+#include <iterator>
+#include <vector>
+
 using namespace boost::chrono;
 typedef boost::chrono::milliseconds ms;
 typedef boost::chrono::nanoseconds ns;
@@ -425,5 +428,22 @@ int main()
       BOOST_TEST(q.empty());
       BOOST_TEST(q.closed());
   }
+  {
+    // push_range then pull_up_to pulls by priority
+      boost::concurrent::sync_priority_queue<int> q;
+      int a[] = {3, 1, 4, 2};
+      q.push_range(a, a + 4);
+      BOOST_TEST_EQ(q.size(), 4u);
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_up_to(3, std::back_inserter(v)), 3u);
+      BOOST_TEST_EQ(v[0], 4);
+      BOOST_TEST_EQ(v[1], 3);
+      BOOST_TEST_EQ(v[2], 2);
+      q.push_n(a, 2);
+      q.close();
+      BOOST_TEST_EQ(q.wait_pull_some(10, std::back_inserter(v)), 3u);
+      BOOST_TEST_EQ(v[3], 3);
+      BOOST_TEST_EQ(q.wait_pull_some(10, std::back_inserter(v)), 0u);
+  }
   return boost::report_errors();
 }
@@ -21,10 +21,23 @@
 
 #include <boost/core/lightweight_test.hpp>
 
+#include <vector>
+
 using namespace boost::chrono;
 
 typedef boost::concurrent::sync_timed_queue<int> sync_tq;
 
+struct counted
+{
+  static int alive;
+  int val;
+  counted(int v = 0) : val(v) { ++alive; }
+  counted(counted const& x) : val(x.val) { ++alive; }
+  counted& operator=(counted const& x) { val = x.val; return *this; }
+  ~counted() { --alive; }
+};
+int counted::alive = 0;
+
 void test_all()
 {
   sync_tq pq;
@@ -145,10 +158,62 @@ void test_deque_times2()
 }
 #endif
 
+void test_cancel()
+{
+  {
+    boost::concurrent::sync_timed_queue<counted> q;
+    boost::timer_handle h1 = q.push(counted(1), milliseconds(10));
+    boost::timer_handle h2 = q.push(counted(2), milliseconds(20));
+    BOOST_TEST_EQ(counted::alive, 2);
+    // the element is released as soon as it is cancelled
+    BOOST_TEST(h1.cancel());
+    BOOST_TEST_EQ(counted::alive, 1);
+    BOOST_TEST_EQ(q.size(), std::size_t(1));
+    BOOST_TEST(! h1.cancel());
+    counted c;
+    q.pull(c);
+    BOOST_TEST_EQ(c.val, 2);
+    // the element has already been pulled
+    BOOST_TEST(! h2.cancel());
+    BOOST_TEST(q.empty());
+  }
+  BOOST_TEST_EQ(counted::alive, 0);
+  {
+    // the handle of a reused entry doesn't cancel the new element
+    sync_tq q;
+    boost::timer_handle h1 = q.push(1, milliseconds(0));
+    BOOST_TEST_EQ(q.pull(), 1);
+    q.push(2, milliseconds(0));
+    BOOST_TEST(! h1.cancel());
+    BOOST_TEST_EQ(q.pull(), 2);
+  }
+  {
+    // cancelling most of the elements keeps the order of the others
+    sync_tq q;
+    std::vector<boost::timer_handle> handles;
+    const steady_clock::time_point tp = steady_clock::now() - seconds(1);
+    for (int i = 0; i < 1000; ++i)
+    {
+      handles.push_back(q.push(i, tp + milliseconds(i)));
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+      if (i % 10 != 0) BOOST_TEST(handles[i].cancel());
+    }
+    BOOST_TEST_EQ(q.size(), std::size_t(100));
+    for (int i = 0; i < 1000; i += 10)
+    {
+      BOOST_TEST_EQ(q.pull(), i);
+    }
+    BOOST_TEST(q.empty());
+  }
+}
+
 int main()
 {
   test_all();
   test_all_with_try();
+  test_cancel();
   test_deque_times();
   //test_deque_times2(); // rt fails
   return boost::report_errors();
@@ -0,0 +1,191 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// <boost/thread/concurrent_queues/sync_timing_wheel_queue.hpp>
+
+// class sync_timing_wheel_queue<T>
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_PROVIDES_EXECUTORS
+
+#include <boost/thread.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/concurrent_queues/sync_timing_wheel_queue.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <vector>
+
+using namespace boost::chrono;
+
+typedef boost::concurrent::sync_timing_wheel_queue<int> sync_twq;
+
+struct counted
+{
+  static int alive;
+  int val;
+  counted(int v = 0) : val(v) { ++alive; }
+  counted(counted const& x) : val(x.val) { ++alive; }
+  counted& operator=(counted const& x) { val = x.val; return *this; }
+  ~counted() { --alive; }
+};
+int counted::alive = 0;
+
+void test_all()
+{
+  sync_twq q;
+  BOOST_TEST(q.empty());
+  BOOST_TEST(!q.closed());
+  BOOST_TEST_EQ(q.size(), std::size_t(0));
+
+  for(int i = 1; i <= 5; i++){
+    q.push(i, milliseconds(i*100));
+    BOOST_TEST(!q.empty());
+    BOOST_TEST_EQ(q.size(), std::size_t(i));
+  }
+
+  for(int i = 6; i <= 10; i++){
+    q.push(i,steady_clock::now() + milliseconds(i*100));
+    BOOST_TEST(!q.empty());
+    BOOST_TEST_EQ(q.size(), std::size_t(i));
+  }
+
+  for(int i = 1; i <= 10; i++){
+    int val = q.pull();
+    BOOST_TEST_EQ(val, i);
+  }
+
+  int val;
+  boost::queue_op_status st = q.nonblocking_pull(val);
+  BOOST_TEST(boost::queue_op_status::empty == st);
+
+  BOOST_TEST(q.empty());
+  q.close();
+  BOOST_TEST(q.closed());
+}
+
+void test_not_before_time_point()
+{
+  sync_twq q;
+  for(int i = 0; i < 10; i++)
+  {
+    const steady_clock::time_point tp = steady_clock::now() + milliseconds(i*20);
+    q.push(i, tp);
+    int val = -1;
+    BOOST_TEST(q.wait_pull(val) == boost::queue_op_status::success);
+    BOOST_TEST_EQ(val, i);
+    BOOST_TEST(steady_clock::now() >= tp);
+  }
+}
+
+void test_pull_status()
+{
+  sync_twq q;
+  int val = 0;
+  BOOST_TEST(q.try_pull(val) == boost::queue_op_status::empty);
+  q.push(1, seconds(10));
+  BOOST_TEST(q.try_pull(val) == boost::queue_op_status::not_ready);
+  BOOST_TEST(q.pull_for(milliseconds(10), val) == boost::queue_op_status::not_ready);
+  BOOST_TEST(q.pull_until(steady_clock::now() + milliseconds(10), val) == boost::queue_op_status::not_ready);
+  BOOST_TEST(q.try_push(2, steady_clock::now() - milliseconds(10)) == boost::queue_op_status::success);
+  BOOST_TEST(q.try_pull(val) == boost::queue_op_status::success);
+  BOOST_TEST_EQ(val, 2);
+  q.close();
+  BOOST_TEST(q.try_push(3, milliseconds(1)) == boost::queue_op_status::closed);
+}
+
+void test_cancel()
+{
+  {
+    boost::concurrent::sync_timing_wheel_queue<counted> q;
+    boost::timer_handle h1 = q.push(counted(1), milliseconds(10));
+    boost::timer_handle h2 = q.push(counted(2), milliseconds(20));
+    BOOST_TEST_EQ(counted::alive, 2);
+    // the element is released as soon as it is cancelled
+    BOOST_TEST(h1.cancel());
+    BOOST_TEST_EQ(counted::alive, 1);
+    BOOST_TEST_EQ(q.size(), std::size_t(1));
+    BOOST_TEST(! h1.cancel());
+    counted c;
+    q.pull(c);
+    BOOST_TEST_EQ(c.val, 2);
+    // the element has already been pulled
+    BOOST_TEST(! h2.cancel());
+    BOOST_TEST(q.empty());
+  }
+  BOOST_TEST_EQ(counted::alive, 0);
+  {
+    // the handle of a reused entry doesn't cancel the new element
+    sync_twq q;
+    boost::timer_handle h1 = q.push(1, milliseconds(0));
+    BOOST_TEST_EQ(q.pull(), 1);
+    q.push(2, milliseconds(0));
+    BOOST_TEST(! h1.cancel());
+    BOOST_TEST_EQ(q.pull(), 2);
+  }
+  {
+    // ready elements can be cancelled
+    sync_twq q;
+    boost::timer_handle h1 = q.push(1, steady_clock::now() - seconds(1));
+    q.push(2, steady_clock::now() - seconds(1));
+    BOOST_TEST(h1.cancel());
+    BOOST_TEST_EQ(q.pull(), 2);
+  }
+  {
+    // a default constructed handle cancels nothing
+    boost::timer_handle h;
+    BOOST_TEST(! h.cancel());
+  }
+}
+
+void test_levels()
+{
+  // a fine resolution spreads the time points over all the levels of the wheel
+  sync_twq q(microseconds(1));
+  BOOST_TEST(q.resolution() == duration_cast<steady_clock::duration>(microseconds(1)));
+  std::vector<boost::timer_handle> handles;
+  const steady_clock::time_point start = steady_clock::now();
+  const int far_pushed = 4;
+  for (int i = 0; i < far_pushed; ++i)
+  {
+    // 1s, 2s, ... are beyond the first two levels; ~5 days and ~50 days beyond the range of the wheel
+    handles.push_back(q.push(-1, start + seconds(1 + i)));
+    handles.push_back(q.push(-2, start + hours(24 * 5) + seconds(i)));
+    handles.push_back(q.push(-3, start + hours(24 * 50) + seconds(i)));
+  }
+  for (int i = 0; i < 30; ++i)
+  {
+    q.push(i, start + milliseconds(i));
+  }
+  for (int i = 0; i < 30; ++i)
+  {
+    BOOST_TEST_EQ(q.pull(), i);
+  }
+  BOOST_TEST(steady_clock::now() >= start + milliseconds(29));
+  for (std::size_t i = 0; i < handles.size(); ++i)
+  {
+    if (i % 3 != 0) BOOST_TEST(handles[i].cancel());
+  }
+  for (int i = 0; i < far_pushed; ++i)
+  {
+    BOOST_TEST_EQ(q.pull(), -1);
+    BOOST_TEST(steady_clock::now() >= start + seconds(1 + i));
+  }
+  BOOST_TEST(q.empty());
+}
+
+int main()
+{
+  test_all();
+  test_not_before_time_point();
+  test_pull_status();
+  test_cancel();
+  test_levels();
+  return boost::report_errors();
+}
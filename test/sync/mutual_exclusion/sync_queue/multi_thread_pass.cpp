@@ -22,6 +22,9 @@
 
 #include <boost/detail/lightweight_test.hpp>
 
+#include <iterator>
+#include <vector>
+
 template <typename ValueType>
 struct call_push
 {
@@ -76,6 +79,29 @@ struct call_wait_pull
   }
 };
 
+template <typename ValueType>
+struct call_wait_pull_some
+{
+  boost::sync_queue<ValueType> *q_;
+
+  call_wait_pull_some(boost::sync_queue<ValueType> *q) :
+    q_(q)
+  {
+  }
+  typedef long result_type;
+  long operator()()
+  {
+    long sum = 0;
+    std::vector<ValueType> v;
+    while (q_->wait_pull_some(16, std::back_inserter(v)) != 0)
+    {
+      for (std::size_t i = 0; i < v.size(); ++i) sum += v[i];
+      v.clear();
+    }
+    return sum;
+  }
+};
+
 void test_concurrent_push_and_pull_on_empty_queue()
 {
   boost::sync_queue<int> q;
@@ -242,6 +268,35 @@ void test_concurrent_pull_on_queue()
   }
 }
 
+void test_concurrent_push_range_and_wait_pull_some()
+{
+  boost::sync_queue<int> q;
+  const unsigned int n = 3;
+  boost::future<long> pull_done[n];
+
+  try
+  {
+    for (unsigned int i =0; i< n; ++i)
+      pull_done[i]=boost::async(boost::launch::async,
+                                call_wait_pull_some<int>(&q));
+
+    std::vector<int> batch(100, 1);
+    for (unsigned int i =0; i< 100; ++i)
+      q.push_range(batch.begin(), batch.end());
+    q.close();
+
+    long sum = 0;
+    for (unsigned int i = 0; i < n; ++i)
+      sum += pull_done[i].get();
+    BOOST_TEST_EQ(sum, 10000);
+    BOOST_TEST(q.empty());
+  }
+  catch (...)
+  {
+    BOOST_TEST(false);
+  }
+}
+
 int main()
 {
   test_concurrent_push_and_pull_on_empty_queue();
@@ -251,6 +306,7 @@ int main()
 #endif
   test_concurrent_push_on_empty_queue();
   test_concurrent_pull_on_queue();
+  test_concurrent_push_range_and_wait_pull_some();
   return boost::report_errors();
 }
 
@@ -15,6 +15,9 @@
 
 #include <boost/detail/lightweight_test.hpp>
 
+#include <iterator>
+#include <vector>
+
 class non_copyable
 {
   BOOST_THREAD_MOVABLE_ONLY(non_copyable)
@@ -82,7 +85,7 @@ int main()
   {
     // empty queue push lvalue succeeds
       boost::sync_queue<int> q;
-      int i;
+      int i = 1;
       q.push(i);
       BOOST_TEST(! q.empty());
       BOOST_TEST(! q.full());
@@ -369,6 +372,66 @@ int main()
       BOOST_TEST(q.closed());
   }
 
+  {
+    // push_range pushes all the elements in order
+      boost::sync_queue<int> q;
+      int a[] = {1, 2, 3};
+      q.push_range(a, a + 3);
+      BOOST_TEST_EQ(q.size(), 3u);
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_up_to(10, std::back_inserter(v)), 3u);
+      BOOST_TEST_EQ(v.size(), 3u);
+      BOOST_TEST_EQ(v[0], 1);
+      BOOST_TEST_EQ(v[1], 2);
+      BOOST_TEST_EQ(v[2], 3);
+      BOOST_TEST(q.empty());
+  }
+  {
+    // push_n pushes n elements and pull_up_to pulls no more than n
+      boost::sync_queue<int> q;
+      int a[] = {1, 2, 3, 4};
+      q.push_n(a, 3);
+      BOOST_TEST_EQ(q.size(), 3u);
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_up_to(2, std::back_inserter(v)), 2u);
+      BOOST_TEST_EQ(v.size(), 2u);
+      BOOST_TEST_EQ(v[0], 1);
+      BOOST_TEST_EQ(v[1], 2);
+      BOOST_TEST_EQ(q.size(), 1u);
+  }
+  {
+    // empty queue pull_up_to pulls nothing
+      boost::sync_queue<int> q;
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.pull_up_to(2, std::back_inserter(v)), 0u);
+      BOOST_TEST(v.empty());
+  }
+  {
+    // closed queue push_range throws
+      boost::sync_queue<int> q;
+      q.close();
+      int a[] = {1, 2, 3};
+      try {
+        q.push_range(a, a + 3);
+        BOOST_TEST(false);
+      } catch (boost::sync_queue_is_closed&) {
+        BOOST_TEST(q.empty());
+      }
+  }
+  {
+    // closed non-empty queue wait_pull_some drains the queue
+      boost::sync_queue<int> q;
+      int a[] = {1, 2, 3};
+      q.push_range(a, a + 3);
+      q.close();
+      std::vector<int> v;
+      BOOST_TEST_EQ(q.wait_pull_some(2, std::back_inserter(v)), 2u);
+      BOOST_TEST_EQ(q.wait_pull_some(2, std::back_inserter(v)), 1u);
+      BOOST_TEST_EQ(q.wait_pull_some(2, std::back_inserter(v)), 0u);
+      BOOST_TEST_EQ(v.size(), 3u);
+      BOOST_TEST(q.empty());
+  }
+
   return boost::report_errors();
 }
 
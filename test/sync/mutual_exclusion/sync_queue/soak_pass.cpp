@@ -0,0 +1,99 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/sync_queue.hpp>
+
+// class sync_queue<T>
+
+// Keeps a queue that never drains under steady load and checks that its memory stays flat.
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/sync_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include <iostream>
+
+#if defined __linux__
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  // resident set size in bytes, 0 if unknown
+  long resident_set_size()
+  {
+#if defined __linux__
+    long pages = 0;
+    long resident = 0;
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (f == 0) return 0;
+    if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    std::fclose(f);
+    return resident * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+  }
+
+  const int backlog = 1000;
+  const int rounds = 50;
+  const int round_size = 100000;
+
+  struct producer
+  {
+    boost::sync_queue<int>* q_;
+    explicit producer(boost::sync_queue<int>* q) : q_(q) {}
+    void operator()()
+    {
+      for (int i = 0; i < rounds * round_size; ++i)
+      {
+        // keep the queue from growing without bound while never letting it drain
+        while (q_->size() > 2 * backlog) boost::this_thread::yield();
+        q_->push(i);
+      }
+      q_->close();
+    }
+  };
+}
+
+int main()
+{
+  boost::sync_queue<int> q;
+  for (int i = 0; i < backlog; ++i) q.push(-1);
+
+  boost::thread t((producer(&q)));
+
+  long rss_after_warmup = 0;
+  long max_rss = 0;
+  int v = 0;
+  int pulled = 0;
+  for (;;)
+  {
+    // the consumer lags behind, so the queue never drains while the producer is running
+    while (q.size() <= backlog && ! q.closed()) boost::this_thread::yield();
+    if (q.wait_pull(v) != boost::queue_op_status::success) break;
+    if (++pulled % round_size == 0)
+    {
+      const long rss = resident_set_size();
+      if (pulled == round_size) rss_after_warmup = rss;
+      if (rss > max_rss) max_rss = rss;
+    }
+  }
+  t.join();
+
+  BOOST_TEST_EQ(pulled, backlog + rounds * round_size);
+  std::cout << "rss after warmup: " << rss_after_warmup << " max rss: " << max_rss << std::endl;
+  // the elements ever pushed would need 20MB if the consumed slots were not reused
+  BOOST_TEST(max_rss - rss_after_warmup < 4 * 1024 * 1024);
+
+  return boost::report_errors();
+}
@@ -77,3 +77,98 @@ BOOST_AUTO_TEST_CASE(test_creation_with_attrs)
 }
 
 
+#if defined BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_AFFINITY
+std::vector<unsigned> thread_affinity;
+
+void get_thread_affinity()
+{
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD)
+  cpu_set_t set;
+  BOOST_CHECK(!pthread_getaffinity_np(pthread_self(), sizeof(set), &set));
+  thread_affinity.clear();
+  for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &set)) thread_affinity.push_back(cpu);
+  }
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_affinity)
+{
+  boost::thread_attributes attrs;
+  BOOST_CHECK(attrs.get_affinity().empty());
+  std::vector<unsigned> cpus(1, 0);
+  attrs.set_affinity(cpus);
+  BOOST_CHECK(attrs.get_affinity() == cpus);
+  // the copies have the same affinity
+  boost::thread_attributes copy(attrs);
+  BOOST_CHECK(copy.get_affinity() == cpus);
+  boost::thread_attributes assigned;
+  assigned = attrs;
+  BOOST_CHECK(assigned.get_affinity() == cpus);
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD)
+  boost::thread thrd(copy, &get_thread_affinity);
+  thrd.join();
+  BOOST_CHECK(thread_affinity == cpus);
+#endif
+  attrs.set_affinity(std::vector<unsigned>());
+  BOOST_CHECK(attrs.get_affinity().empty());
+}
+#endif
+
+std::string thread_name;
+
+void get_thread_name()
+{
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD) && defined __linux__ && defined __GLIBC__
+  char name[16];
+  BOOST_CHECK(!pthread_getname_np(pthread_self(), name, sizeof(name)));
+  thread_name = name;
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_name)
+{
+  boost::thread_attributes attrs;
+  attrs.set_name("worker-with-a-long-name");
+  BOOST_CHECK_EQUAL(attrs.get_name(), "worker-with-a-long-name");
+  attrs.set_stack_size(0x10000);
+  boost::thread_attributes copy(attrs);
+  BOOST_CHECK_EQUAL(copy.get_name(), "worker-with-a-long-name");
+  BOOST_CHECK(copy.get_stack_size() >= 0x10000);
+  boost::thread thrd(copy, &get_thread_name);
+  thrd.join();
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD) && defined __linux__ && defined __GLIBC__
+  // truncated to 15 characters
+  BOOST_CHECK_EQUAL(thread_name, "worker-with-a-l");
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_priority)
+{
+  test_value = 0;
+  boost::thread_attributes attrs;
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD)
+  // the only priority of SCHED_OTHER
+  attrs.set_scheduling(SCHED_OTHER, 0);
+#endif
+  attrs.set_priority(0);
+  BOOST_CHECK_EQUAL(attrs.get_priority(), 0);
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD)
+  // out of the range of SCHED_OTHER, the attributes are unchanged
+  BOOST_CHECK_THROW(attrs.set_priority(10), boost::thread_resource_error);
+  BOOST_CHECK_THROW(attrs.set_scheduling(SCHED_FIFO, sched_get_priority_max(SCHED_FIFO) + 1), boost::thread_resource_error);
+  BOOST_CHECK_EQUAL(attrs.get_priority(), 0);
+  int policy;
+  BOOST_CHECK(!pthread_attr_getschedpolicy(attrs.native_handle(), &policy));
+  BOOST_CHECK(policy == SCHED_OTHER);
+  boost::thread_attributes defaults;
+  BOOST_CHECK_THROW(defaults.set_priority(10), boost::thread_resource_error);
+  int inherit;
+  BOOST_CHECK(!pthread_attr_getinheritsched(defaults.native_handle(), &inherit));
+  BOOST_CHECK(inherit == PTHREAD_INHERIT_SCHED);
+#endif
+  boost::thread thrd(attrs, &simple_thread);
+  thrd.join();
+  BOOST_CHECK_EQUAL(test_value, 999);
+}
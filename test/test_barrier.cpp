@@ -60,10 +60,39 @@ void test_barrier()
 
 }
 
+namespace {
+
+boost::barrier interrupted_barrier(2);
+bool interrupted = false;
+
+void interrupted_thread()
+{
+    try
+    {
+        interrupted_barrier.wait();
+    }
+    catch(boost::thread_interrupted&)
+    {
+        interrupted = true;
+    }
+}
+
+} // namespace
+
+void test_barrier_interruption()
+{
+    boost::thread t(&interrupted_thread);
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+    t.interrupt();
+    t.join();
+    BOOST_TEST(interrupted);
+}
+
 int main()
 {
 
     test_barrier();
+    test_barrier_interruption();
     return boost::report_errors();
 }
 
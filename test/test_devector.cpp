@@ -0,0 +1,142 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/csbl/devector.hpp>
+
+// class devector<T>
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/csbl/devector.hpp>
+#include <boost/thread/detail/move.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+class non_copyable
+{
+  BOOST_THREAD_MOVABLE_ONLY(non_copyable)
+  int val;
+public:
+  non_copyable(int v) : val(v){}
+  non_copyable(BOOST_RV_REF(non_copyable) x): val(x.val) {}
+  non_copyable& operator=(BOOST_RV_REF(non_copyable) x) { val=x.val; return *this; }
+  int value() const {return val;}
+};
+
+struct counted
+{
+  static int alive;
+  int val;
+  counted(int v) : val(v) { ++alive; }
+  counted(counted const& x) : val(x.val) { ++alive; }
+  ~counted() { --alive; }
+};
+int counted::alive = 0;
+
+int main()
+{
+  {
+    // default devector invariants
+      boost::csbl::devector<int> d;
+      BOOST_TEST(d.empty());
+      BOOST_TEST_EQ(d.size(), 0u);
+      BOOST_TEST_EQ(d.capacity(), 0u);
+  }
+  {
+    // push_back/pop_front is FIFO across wrap-around
+      boost::csbl::devector<int> d;
+      int next_in = 0;
+      int next_out = 0;
+      for (int i = 0; i < 10; ++i) d.push_back(next_in++);
+      for (int i = 0; i < 1000; ++i)
+      {
+        d.push_back(next_in++);
+        BOOST_TEST_EQ(d.front(), next_out);
+        d.pop_front();
+        ++next_out;
+      }
+      BOOST_TEST_EQ(d.size(), 10u);
+      BOOST_TEST_EQ(d.back(), next_in - 1);
+      for (std::size_t i = 0; i < d.size(); ++i) BOOST_TEST_EQ(d[i], next_out + int(i));
+  }
+  {
+    // steady state does not grow the capacity
+      boost::csbl::devector<int> d;
+      for (int i = 0; i < 100; ++i) d.push_back(i);
+      const std::size_t capacity = d.capacity();
+      BOOST_TEST(capacity >= 100u);
+      BOOST_TEST(capacity < 200u);
+      for (int i = 0; i < 100000; ++i)
+      {
+        d.pop_front();
+        d.push_back(i);
+      }
+      BOOST_TEST_EQ(d.capacity(), capacity);
+  }
+  {
+    // push_front/pop_back at the other end
+      boost::csbl::devector<int> d;
+      d.push_back(2);
+      d.push_front(1);
+      d.push_front(0);
+      d.push_back(3);
+      BOOST_TEST_EQ(d.size(), 4u);
+      for (std::size_t i = 0; i < d.size(); ++i) BOOST_TEST_EQ(d[i], int(i));
+      d.pop_back();
+      BOOST_TEST_EQ(d.back(), 2);
+      d.pop_front();
+      BOOST_TEST_EQ(d.front(), 1);
+  }
+  {
+    // growth keeps the order when the elements wrap around
+      boost::csbl::devector<int> d;
+      for (int i = 0; i < 8; ++i) d.push_back(i);
+      for (int i = 1; i <= 8; ++i) d.push_front(-i);
+      for (int i = 8; i < 100; ++i) d.push_back(i);
+      BOOST_TEST_EQ(d.size(), 108u);
+      for (std::size_t i = 0; i < d.size(); ++i) BOOST_TEST_EQ(d[i], int(i) - 8);
+  }
+  {
+    // shrink_to_fit releases the storage
+      boost::csbl::devector<int> d;
+      for (int i = 0; i < 1000; ++i) d.push_back(i);
+      while (d.size() > 3) d.pop_front();
+      d.shrink_to_fit();
+      BOOST_TEST(d.capacity() < 1000u);
+      BOOST_TEST_EQ(d.size(), 3u);
+      BOOST_TEST_EQ(d.front(), 997);
+      BOOST_TEST_EQ(d.back(), 999);
+      d.clear();
+      d.shrink_to_fit();
+      BOOST_TEST_EQ(d.capacity(), 0u);
+      d.push_back(1);
+      BOOST_TEST_EQ(d.front(), 1);
+  }
+  {
+    // move-only elements
+      boost::csbl::devector<non_copyable> d;
+      for (int i = 0; i < 100; ++i) d.push_back(non_copyable(i));
+      boost::csbl::devector<non_copyable> d2(boost::move(d));
+      BOOST_TEST(d.empty());
+      BOOST_TEST_EQ(d2.size(), 100u);
+      BOOST_TEST_EQ(d2.front().value(), 0);
+      BOOST_TEST_EQ(d2.back().value(), 99);
+  }
+  {
+    // copies and destroys every element exactly once
+      {
+        boost::csbl::devector<counted> d;
+        for (int i = 0; i < 50; ++i) d.push_back(counted(i));
+        for (int i = 0; i < 20; ++i) d.pop_front();
+        boost::csbl::devector<counted> d2(d);
+        BOOST_TEST_EQ(d2.size(), 30u);
+        BOOST_TEST_EQ(d2.front().val, 20);
+        d = d2;
+        BOOST_TEST_EQ(d.size(), 30u);
+        BOOST_TEST_EQ(counted::alive, 60);
+      }
+      BOOST_TEST_EQ(counted::alive, 0);
+  }
+
+  return boost::report_errors();
+}
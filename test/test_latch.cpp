@@ -62,9 +62,50 @@ void test_latch()
 
 }
 
+void test_latch_timeout()
+{
+  boost::latch l(2);
+  BOOST_TEST(l.wait_for(boost::chrono::milliseconds(10)) == boost::cv_status::timeout);
+  BOOST_TEST(! l.try_count_down());
+  BOOST_TEST(l.wait_for(boost::chrono::milliseconds(10)) == boost::cv_status::timeout);
+  BOOST_TEST(l.try_count_down());
+  BOOST_TEST(l.try_count_down());
+  BOOST_TEST(l.try_wait());
+  BOOST_TEST(l.wait_for(boost::chrono::milliseconds(10)) == boost::cv_status::no_timeout);
+}
+
+namespace
+{
+  boost::latch sync_latch(N_THREADS);
+  boost::atomic<int> arrived(0);
+
+  void sync_thread()
+  {
+    ++arrived;
+    sync_latch.count_down_and_wait();
+    BOOST_TEST_EQ(arrived.load(), N_THREADS);
+  }
+}
+
+void test_count_down_and_wait()
+{
+  for (int round = 0; round < 3; ++round)
+  {
+    arrived = 0;
+    sync_latch.reset(N_THREADS);
+    boost::thread_group g;
+    for (int i = 0; i < N_THREADS; ++i)
+      g.create_thread(&sync_thread);
+    g.join_all();
+    BOOST_TEST(sync_latch.try_wait());
+  }
+}
+
 int main()
 {
   test_latch();
+  test_latch_timeout();
+  test_count_down_and_wait();
   return boost::report_errors();
 }
 
@@ -11,6 +11,8 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/once.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/bind/bind.hpp>
 #include <iostream>
 
 #include <boost/thread/detail/log.hpp>
@@ -190,3 +192,69 @@ BOOST_AUTO_TEST_CASE(test_call_once_retried_on_exception)
 }
 
 
+
+boost::once_flag outer_flag=BOOST_ONCE_INIT;
+boost::once_flag inner_flags[16];
+boost::condition_variable inner_cv;
+unsigned inner_count=0;
+unsigned outer_count=0;
+
+void initialize_inner()
+{
+    boost::unique_lock<boost::mutex> lock(m);
+    ++inner_count;
+    inner_cv.notify_all();
+}
+
+void initialize_outer()
+{
+    // completes only once the other threads have initialized all the inner flags
+    boost::unique_lock<boost::mutex> lock(m);
+    while(inner_count!=sizeof(inner_flags)/sizeof(inner_flags[0]))
+    {
+        inner_cv.wait(lock);
+    }
+    ++outer_count;
+}
+
+void call_once_outer()
+{
+    boost::call_once(outer_flag, &initialize_outer);
+}
+
+void call_once_inner(unsigned first)
+{
+    unsigned const n=sizeof(inner_flags)/sizeof(inner_flags[0]);
+    for(unsigned i=0;i<n;++i)
+    {
+        boost::call_once(inner_flags[(first+i)%n], &initialize_inner);
+    }
+    boost::call_once(outer_flag, &initialize_outer);
+}
+
+BOOST_AUTO_TEST_CASE(test_call_once_independent_flags)
+{
+  BOOST_DETAIL_THREAD_LOG;
+    unsigned const num_threads=10;
+    boost::thread_group group;
+
+    try
+    {
+        // the initializations of the inner flags are not blocked by the one of outer_flag in progress
+        group.create_thread(&call_once_outer);
+        for(unsigned i=0;i<num_threads;++i)
+        {
+            group.create_thread(boost::bind(&call_once_inner, i));
+        }
+        group.join_all();
+    }
+    catch(...)
+    {
+        group.interrupt_all();
+        group.join_all();
+        throw;
+    }
+
+    BOOST_CHECK_EQUAL(inner_count,16u);
+    BOOST_CHECK_EQUAL(outer_count,1u);
+}
@@ -9,6 +9,63 @@
 #include <boost/thread/thread_only.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/detail/cpu_topology.hpp>
+
+#include <algorithm>
+#include <vector>
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+#if defined(__linux__)
+std::vector<unsigned> affinity(pthread_t thread)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    BOOST_CHECK(!pthread_getaffinity_np(thread, sizeof(set), &set));
+    std::vector<unsigned> cpus;
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+std::vector<std::vector<unsigned> > pinned_cores;
+
+void probe_from_pinned_thread(unsigned cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    BOOST_CHECK(!pthread_setaffinity_np(pthread_self(), sizeof(set), &set));
+    pinned_cores = boost::detail::cpus_by_core();
+}
+#endif
+
+// must stay the first test: the topology is probed once, by the first call
+BOOST_AUTO_TEST_CASE(test_topology_probed_from_pinned_thread)
+{
+#if defined(__linux__)
+    std::vector<unsigned> const process_cpus = affinity(pthread_self());
+    BOOST_REQUIRE(!process_cpus.empty());
+    boost::thread thrd(&probe_from_pinned_thread, process_cpus.front());
+    thrd.join();
+    // the CPUs of the process, not the one the probing thread was pinned to
+    if (!pinned_cores.empty())
+    {
+        std::vector<unsigned> cpus;
+        for (std::size_t i = 0; i < pinned_cores.size(); ++i)
+        {
+            cpus.insert(cpus.end(), pinned_cores[i].begin(), pinned_cores[i].end());
+        }
+        std::sort(cpus.begin(), cpus.end());
+        BOOST_CHECK(cpus == process_cpus);
+    }
+    BOOST_CHECK(boost::thread::hardware_concurrency() <= process_cpus.size());
+#endif
+}
 
 BOOST_AUTO_TEST_CASE(test_physical_concurrency_is_non_zero)
 {
@@ -23,3 +80,12 @@ BOOST_AUTO_TEST_CASE(test_physical_concurrency_is_non_zero)
 
 
 
+
+BOOST_AUTO_TEST_CASE(test_physical_concurrency_is_at_most_hardware_concurrency)
+{
+#if defined(__linux__)
+    BOOST_CHECK(boost::thread::physical_concurrency()<=boost::thread::hardware_concurrency());
+    // computed once
+    BOOST_CHECK_EQUAL(boost::thread::physical_concurrency(), boost::thread::physical_concurrency());
+#endif
+}
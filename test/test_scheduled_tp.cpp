@@ -13,11 +13,15 @@
 #define BOOST_THREAD_VERSION 4
 #define BOOST_THREAD_PROVIDES_EXECUTORS
 
+// scheduled_thread_pool can be forward declared
+namespace boost { namespace executors { class scheduled_thread_pool; } }
+
 #include <boost/bind/bind.hpp>
 #include <boost/chrono.hpp>
 #include <boost/chrono/chrono_io.hpp>
 #include <boost/function.hpp>
 #include <boost/thread/executors/scheduled_thread_pool.hpp>
+#include <boost/atomic.hpp>
 #include <iostream>
 
 #include <boost/core/lightweight_test.hpp>
@@ -25,6 +29,7 @@
 using namespace boost::chrono;
 
 typedef boost::scheduled_thread_pool scheduled_tp;
+typedef boost::basic_scheduled_thread_pool<boost::sync_timing_wheel_queue<boost::executors::work_pq> > timing_wheel_scheduled_tp;
 
 void fn(int x)
 {
@@ -35,7 +40,8 @@ void func(steady_clock::time_point pushed, steady_clock::duration dur)
 {
     BOOST_TEST(pushed + dur < steady_clock::now());
 }
-void func2(scheduled_tp* tp, steady_clock::duration d)
+template <class ScheduledTP>
+void func2(ScheduledTP* tp, steady_clock::duration d)
 {
   boost::function<void()> fn = boost::bind(func,steady_clock::now(),d);
   tp->submit_after(fn, d);
@@ -56,9 +62,10 @@ void test_timing(const int n)
   //dtor is called here so all task will have to be executed before we return
 }
 
+template <class ScheduledTP>
 void test_deque_timing()
 {
-    boost::scheduled_thread_pool se(4);
+    ScheduledTP se(4);
     for(int i = 0; i < 10; i++)
     {
         steady_clock::duration d = milliseconds(i*100);
@@ -67,31 +74,60 @@ void test_deque_timing()
     }
 }
 
+template <class ScheduledTP>
 void test_deque_multi(const int n)
 {
-    scheduled_tp se(4);
+    ScheduledTP se(4);
     boost::thread_group tg;
     for(int i = 0; i < n; i++)
     {
         steady_clock::duration d = milliseconds(i*100);
         //boost::function<void()> fn = boost::bind(func,steady_clock::now(),d);
         //tg.create_thread(boost::bind(boost::mem_fn(&scheduled_tp::submit_after), &se, fn, d));
-        tg.create_thread(boost::bind(func2, &se, d));
+        tg.create_thread(boost::bind(func2<ScheduledTP>, &se, d));
     }
     tg.join_all();
     //dtor is called here so execution will block until all the closures
     //have been completed.
 }
 
+void set_flag(boost::atomic<bool>* flag)
+{
+  *flag = true;
+}
+
+template <class ScheduledTP>
+void test_cancel()
+{
+  boost::atomic<bool> cancelled(false);
+  boost::atomic<bool> kept(false);
+  {
+    ScheduledTP se(2);
+    boost::timer_handle h = se.submit_after(boost::bind(set_flag, &cancelled), milliseconds(200));
+    se.submit_after(boost::bind(set_flag, &kept), milliseconds(100));
+    BOOST_TEST(h.cancel());
+    BOOST_TEST(! h.cancel());
+    boost::this_thread::sleep_for(milliseconds(400));
+  }
+  BOOST_TEST(! cancelled);
+  BOOST_TEST(kept);
+}
+
 int main()
 {
   steady_clock::time_point start = steady_clock::now();
   test_timing(5);
   steady_clock::duration diff = steady_clock::now() - start;
   BOOST_TEST(diff > milliseconds(500));
-  test_deque_timing();
-  test_deque_multi(4);
-  test_deque_multi(8);
-  test_deque_multi(16);
+  test_deque_timing<scheduled_tp>();
+  test_deque_multi<scheduled_tp>(4);
+  test_deque_multi<scheduled_tp>(8);
+  test_deque_multi<scheduled_tp>(16);
+  test_cancel<scheduled_tp>();
+  test_deque_timing<timing_wheel_scheduled_tp>();
+  test_deque_multi<timing_wheel_scheduled_tp>(4);
+  test_deque_multi<timing_wheel_scheduled_tp>(8);
+  test_deque_multi<timing_wheel_scheduled_tp>(16);
+  test_cancel<timing_wheel_scheduled_tp>();
   return boost::report_errors();
 }
@@ -0,0 +1,101 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 5
+
+#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <boost/thread/executors/scheduled_thread_pool.hpp>
+#include <boost/thread/executors/work_stealing_thread_pool.hpp>
+#include <boost/thread/detail/cpu_topology.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/csbl/vector.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+boost::atomic<int> done(0);
+
+void count()
+{
+  ++done;
+}
+
+std::vector<unsigned> current_affinity()
+{
+  std::vector<unsigned> cpus;
+#if defined BOOST_THREAD_DEFINES_THREAD_ATTRIBUTES_AFFINITY && defined(BOOST_THREAD_PLATFORM_PTHREAD)
+  cpu_set_t set;
+  BOOST_TEST(!pthread_getaffinity_np(pthread_self(), sizeof(set), &set));
+  for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+  }
+#endif
+  return cpus;
+}
+
+bool is_one_of(std::vector<unsigned> const& cpus, std::vector<std::vector<unsigned> > const& groups)
+{
+  return groups.empty() || std::find(groups.begin(), groups.end(), cpus) != groups.end();
+}
+
+int main()
+{
+  std::vector<std::vector<unsigned> > const cores = boost::detail::cpus_by_core();
+  std::vector<std::vector<unsigned> > const nodes = boost::detail::cpus_by_node();
+#if defined __linux__
+  BOOST_TEST(! cores.empty());
+  BOOST_TEST(cores.size() <= boost::thread::physical_concurrency() || boost::thread::physical_concurrency() < boost::thread::hardware_concurrency());
+#endif
+  {
+    // each worker runs on the CPUs of one core
+    boost::thread::attributes attrs;
+    boost::executors::basic_thread_pool tp(4, attrs, boost::executors::thread_pinning::per_core);
+    boost::csbl::vector<boost::future<std::vector<unsigned> > > affinities;
+    for (int i = 0; i < 8; ++i)
+    {
+      affinities.push_back(boost::async(tp, &current_affinity));
+    }
+    for (std::size_t i = 0; i < affinities.size(); ++i)
+    {
+      BOOST_TEST(is_one_of(affinities[i].get(), cores));
+    }
+  }
+  {
+    // each worker runs on the CPUs of one node
+    boost::thread::attributes attrs;
+    boost::executors::work_stealing_thread_pool tp(2, attrs, boost::executors::thread_pinning::per_node);
+    boost::future<std::vector<unsigned> > affinity = boost::async(tp, &current_affinity);
+    BOOST_TEST(is_one_of(affinity.get(), nodes));
+  }
+  {
+    done = 0;
+    boost::thread::attributes attrs;
+    attrs.set_name("scheduled");
+    boost::executors::scheduled_thread_pool tp(2, attrs, boost::executors::thread_pinning::per_core);
+    tp.submit_after(&count, boost::chrono::milliseconds(1));
+    tp.submit_after(&count, boost::chrono::milliseconds(0));
+    while (done != 2) boost::this_thread::yield();
+  }
+  {
+    done = 0;
+    boost::thread_group g;
+    boost::thread::attributes attrs;
+    attrs.set_stack_size(0x10000);
+    g.create_thread(attrs, &count);
+    g.create_thread(&count);
+    g.join_all();
+    BOOST_TEST_EQ(done, 2);
+  }
+  return boost::report_errors();
+}
@@ -0,0 +1,98 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_THREAD_PROVIDES_INTERRUPTIONS
+
+#include <boost/thread/detail/config.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind/bind.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+namespace {
+
+const int N_CYCLES=20;
+boost::atomic<int> winners(0);
+boost::atomic<int> arrived(0);
+int completions = 0;
+
+// Each cycle, all the threads have arrived before any of them leaves, and only one of them is told it
+// completed the cycle.
+void barrier_thread(boost::tree_barrier* b, int n)
+{
+    for (int i = 0; i < N_CYCLES; ++i)
+    {
+        ++arrived;
+        if (b->wait())
+        {
+            ++winners;
+        }
+        BOOST_TEST(arrived.load() >= n * (i + 1));
+        b->count_down_and_wait();
+    }
+}
+
+void completion()
+{
+    ++completions;
+}
+
+unsigned int shrink()
+{
+    ++completions;
+    return 2;
+}
+
+void shrinking_thread(boost::tree_barrier* b)
+{
+    b->wait();
+}
+
+} // namespace
+
+void test_tree_barrier(int n, unsigned int fan_in)
+{
+    winners = 0;
+    arrived = 0;
+    completions = 0;
+    boost::tree_barrier b(n, fan_in, &completion);
+    boost::thread_group g;
+    for (int i = 0; i < n; ++i)
+        g.create_thread(boost::bind(&barrier_thread, &b, n));
+    g.join_all();
+    BOOST_TEST_EQ(winners.load(), N_CYCLES);
+    BOOST_TEST_EQ(completions, 2 * N_CYCLES);
+}
+
+void test_tree_barrier_resize()
+{
+    completions = 0;
+    boost::tree_barrier b(6, 2, &shrink);
+    {
+        boost::thread_group g;
+        for (int i = 0; i < 6; ++i)
+            g.create_thread(boost::bind(&shrinking_thread, &b));
+        g.join_all();
+    }
+    {
+        // after the completion function, the barrier is for 2 threads
+        boost::thread_group g;
+        for (int i = 0; i < 2; ++i)
+            g.create_thread(boost::bind(&shrinking_thread, &b));
+        g.join_all();
+    }
+    BOOST_TEST_EQ(completions, 2);
+}
+
+int main()
+{
+    test_tree_barrier(1, 2);
+    test_tree_barrier(3, 2);
+    test_tree_barrier(8, 4);
+    test_tree_barrier(17, 4);
+    test_tree_barrier(33, 2);
+    test_tree_barrier_resize();
+    return boost::report_errors();
+}
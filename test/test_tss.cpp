@@ -15,6 +15,11 @@
 #include <boost/thread/tss.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <new>
 
 #include <boost/test/unit_test.hpp>
 
@@ -496,6 +501,76 @@ BOOST_AUTO_TEST_CASE(test_tss_cleanup_not_called_for_null_pointer)
     BOOST_CHECK(!tss_cleanup_called);
 }
 
+boost::barrier reused_slot_barrier(2);
+boost::thread_specific_ptr<int>* destroyed_tss=0;
+boost::thread_specific_ptr<int>* reused_tss=0;
+int* value_of_reused_tss=0;
+
+void thread_with_value_of_destroyed_ptr()
+{
+    destroyed_tss->reset(new int(1));
+    reused_slot_barrier.wait();
+    // the main thread destroys destroyed_tss and creates reused_tss
+    reused_slot_barrier.wait();
+    value_of_reused_tss=reused_tss->get();
+    reused_tss->reset(new int(2));
+    BOOST_CHECK_EQUAL(*reused_tss->get(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_tss_does_not_see_value_of_destroyed_ptr)
+{
+    destroyed_tss=new boost::thread_specific_ptr<int>();
+    boost::thread t(thread_with_value_of_destroyed_ptr);
+    reused_slot_barrier.wait();
+    delete destroyed_tss;
+    boost::thread_specific_ptr<int> local_tss;
+    reused_tss=&local_tss;
+    reused_slot_barrier.wait();
+    t.join();
+    BOOST_CHECK(!value_of_reused_tss);
+}
+
+BOOST_AUTO_TEST_CASE(test_tss_at_same_address_does_not_see_value_of_destroyed_ptr)
+{
+    typedef boost::thread_specific_ptr<int> tss_type;
+    boost::aligned_storage<sizeof(tss_type), boost::alignment_of<tss_type>::value>::type storage;
+    void* const address=storage.address();
+    destroyed_tss=new (address) tss_type();
+    value_of_reused_tss=0;
+    boost::thread t(thread_with_value_of_destroyed_ptr);
+    reused_slot_barrier.wait();
+    destroyed_tss->~tss_type();
+    // same address and same slot
+    reused_tss=new (address) tss_type();
+    reused_slot_barrier.wait();
+    t.join();
+    BOOST_CHECK(!value_of_reused_tss);
+    reused_tss->~tss_type();
+}
+
+boost::thread_specific_ptr<Dummy> tss_set_by_cleanup(tss_custom_cleanup);
+
+void tss_cleanup_setting_other_tss(Dummy* d)
+{
+    delete d;
+    tss_set_by_cleanup.reset(new Dummy);
+}
+
+boost::thread_specific_ptr<Dummy> tss_setting_other_tss(tss_cleanup_setting_other_tss);
+
+void thread_with_tss_set_by_cleanup()
+{
+    tss_setting_other_tss.reset(new Dummy);
+}
+
+BOOST_AUTO_TEST_CASE(test_tss_cleans_up_values_set_by_cleanup)
+{
+    tss_cleanup_called=false;
+    boost::thread t(thread_with_tss_set_by_cleanup);
+    t.join();
+    BOOST_CHECK(tss_cleanup_called);
+}
+
 //BOOST_AUTO_TEST_CASE(test_tss_at_the_same_adress)
 //{
 //  for(int i=0; i<2; i++)
@@ -0,0 +1,157 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/executors/work.hpp>
+
+// executors::work
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_PROVIDES_EXECUTORS
+
+#include <boost/thread/executors/work.hpp>
+#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <boost/thread/latch.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include <new>
+
+// counts the heap allocations of the closures deriving from it
+struct counted_allocations
+{
+  static long allocations;
+  static void* operator new(std::size_t size)
+  {
+    ++allocations;
+    return ::operator new(size);
+  }
+  static void operator delete(void* p)
+  {
+    ::operator delete(p);
+  }
+};
+long counted_allocations::allocations = 0;
+
+typedef boost::executors::work work;
+
+struct small_closure : counted_allocations
+{
+  int* counter_;
+  explicit small_closure(int* counter) : counter_(counter) {}
+  void operator()() { ++*counter_; }
+};
+
+struct large_closure : counted_allocations
+{
+  int* counter_;
+  char padding_[2 * BOOST_THREAD_WORK_INLINE_SIZE];
+  explicit large_closure(int* counter) : counter_(counter) {}
+  void operator()() { ++*counter_; }
+};
+
+struct count_down_closure
+{
+  boost::latch* latch_;
+  explicit count_down_closure(boost::latch* latch) : latch_(latch) {}
+  void operator()() { latch_->count_down(); }
+};
+
+struct move_only_closure
+{
+  BOOST_THREAD_MOVABLE_ONLY(move_only_closure)
+  int* counter_;
+  explicit move_only_closure(int* counter) : counter_(counter) {}
+  move_only_closure(BOOST_THREAD_RV_REF(move_only_closure) x) BOOST_NOEXCEPT : counter_(x.counter_) { x.counter_ = 0; }
+  move_only_closure& operator=(BOOST_THREAD_RV_REF(move_only_closure) x) BOOST_NOEXCEPT
+  { counter_ = x.counter_; x.counter_ = 0; return *this; }
+  void operator()() { ++*counter_; }
+};
+
+struct counted_closure
+{
+  static int alive;
+  counted_closure() { ++alive; }
+  counted_closure(counted_closure const&) BOOST_NOEXCEPT { ++alive; }
+  ~counted_closure() { --alive; }
+  void operator()() {}
+};
+int counted_closure::alive = 0;
+
+int value = 0;
+void increment() { ++value; }
+
+int main()
+{
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+  BOOST_TEST(sizeof(work) <= 64u);
+  {
+    // small closures are stored in place
+      int counter = 0;
+      const long before = counted_allocations::allocations;
+      work w((small_closure(&counter)));
+      work w2(boost::move(w));
+      w2();
+      w();
+      BOOST_TEST_EQ(counted_allocations::allocations, before);
+      BOOST_TEST_EQ(counter, 1);
+  }
+  {
+    // function pointers are supported
+      work w(&increment);
+      work w2(boost::move(w));
+      w2();
+      BOOST_TEST_EQ(value, 1);
+  }
+  {
+    // large closures are allocated once and moved by pointer
+      int counter = 0;
+      const long before = counted_allocations::allocations;
+      work w((large_closure(&counter)));
+      BOOST_TEST_EQ(counted_allocations::allocations, before + 1);
+      work w2;
+      w2 = boost::move(w);
+      w2();
+      BOOST_TEST_EQ(counted_allocations::allocations, before + 1);
+      BOOST_TEST_EQ(counter, 1);
+  }
+  {
+    // move-only closures are supported
+      int counter = 0;
+      work w((move_only_closure(&counter)));
+      work w2(boost::move(w));
+      w2();
+      BOOST_TEST_EQ(counter, 1);
+  }
+  {
+    // the closure is destroyed exactly once
+      {
+        work w((counted_closure()));
+        work w2(boost::move(w));
+        w = boost::move(w2);
+        BOOST_TEST_EQ(counted_closure::alive, 1);
+      }
+      BOOST_TEST_EQ(counted_closure::alive, 0);
+  }
+  {
+    // executors run the work
+      int counter = 0;
+      {
+        boost::basic_thread_pool tp(1);
+        for (int i = 0; i < 100; ++i) tp.submit(small_closure(&counter));
+        // the destructor interrupts the worker, which drops the works still queued: wait for
+        // the last one, run after the others by the single worker
+        boost::latch done(1);
+        tp.submit(count_down_closure(&done));
+        done.wait();
+      }
+      BOOST_TEST_EQ(counter, 100);
+  }
+#endif
+
+  return boost::report_errors();
+}
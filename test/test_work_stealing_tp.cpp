@@ -0,0 +1,171 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 5
+
+#include <boost/thread/executors/work_stealing_thread_pool.hpp>
+#include <boost/thread/executors/serial_executor.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/atomic.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+typedef boost::work_stealing_thread_pool tp_t;
+
+struct counting_task
+{
+  boost::atomic<int>* counter_;
+  explicit counting_task(boost::atomic<int>* counter) : counter_(counter) {}
+  void operator()() const
+  {
+    ++*counter_;
+  }
+};
+
+// submits two children from the worker executing it until depth reaches 0
+struct spawning_task
+{
+  tp_t* tp_;
+  boost::atomic<int>* counter_;
+  int depth_;
+  spawning_task(tp_t* tp, boost::atomic<int>* counter, int depth) : tp_(tp), counter_(counter), depth_(depth) {}
+  void operator()() const
+  {
+    ++*counter_;
+    if (depth_ > 0)
+    {
+      tp_->submit(spawning_task(tp_, counter_, depth_ - 1));
+      tp_->submit(spawning_task(tp_, counter_, depth_ - 1));
+    }
+  }
+};
+
+int twice(int i)
+{
+  return 2 * i;
+}
+
+int add_one(boost::future<int> f)
+{
+  return f.get() + 1;
+}
+
+void test_external_submissions()
+{
+  boost::atomic<int> counter(0);
+  {
+    tp_t tp(4);
+    for (int i = 0; i < 10000; ++i)
+    {
+      tp.submit(counting_task(&counter));
+    }
+  }
+  BOOST_TEST_EQ(counter.load(), 10000);
+}
+
+void test_submissions_from_workers()
+{
+  boost::atomic<int> counter(0);
+  {
+    tp_t tp(4);
+    tp.submit(spawning_task(&tp, &counter, 12));
+    while (counter.load() != (1 << 13) - 1)
+    {
+      boost::this_thread::yield();
+    }
+  }
+  BOOST_TEST_EQ(counter.load(), (1 << 13) - 1);
+}
+
+// submits children to its own deque and waits for the other workers to steal them
+struct blocking_owner_task
+{
+  tp_t* tp_;
+  boost::atomic<int>* counter_;
+  blocking_owner_task(tp_t* tp, boost::atomic<int>* counter) : tp_(tp), counter_(counter) {}
+  void operator()() const
+  {
+    for (int i = 0; i < 100; ++i)
+    {
+      tp_->submit(counting_task(counter_));
+    }
+    while (counter_->load() != 100)
+    {
+      boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+    }
+  }
+};
+
+void test_works_of_a_busy_worker_are_stolen()
+{
+  boost::atomic<int> counter(0);
+  {
+    tp_t tp(3);
+    tp.submit(blocking_owner_task(&tp, &counter));
+    while (counter.load() != 100)
+    {
+      boost::this_thread::yield();
+    }
+  }
+  BOOST_TEST_EQ(counter.load(), 100);
+}
+
+void test_async_and_then()
+{
+  tp_t tp(2);
+  boost::future<int> f = boost::async(tp, &twice, 21);
+  boost::future<int> g = f.then(tp, &add_one);
+  BOOST_TEST_EQ(g.get(), 43);
+}
+
+void test_serial_executor()
+{
+  boost::atomic<int> counter(0);
+  {
+    tp_t tp(4);
+    boost::serial_executor ex(tp);
+    for (int i = 0; i < 100; ++i)
+    {
+      ex.submit(counting_task(&counter));
+    }
+    while (counter.load() != 100)
+    {
+      boost::this_thread::yield();
+    }
+  }
+  BOOST_TEST_EQ(counter.load(), 100);
+}
+
+void test_submit_after_close_throws()
+{
+  tp_t tp(1);
+  tp.close();
+  BOOST_TEST(tp.closed());
+  bool thrown = false;
+  try
+  {
+    tp.submit(&boost::this_thread::yield);
+  }
+  catch (boost::sync_queue_is_closed&)
+  {
+    thrown = true;
+  }
+  BOOST_TEST(thrown);
+}
+
+int main()
+{
+  test_external_submissions();
+  test_submissions_from_workers();
+  test_works_of_a_busy_worker_are_stolen();
+  test_async_and_then();
+  test_serial_executor();
+  test_submit_after_close_throws();
+  return boost::report_errors();
+}